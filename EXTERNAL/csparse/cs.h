@@ -21,9 +21,11 @@ extern "C" {
 #endif
 
 // rk: We define csi to be int to be backward compatible with older CSparse releases.
-//     At some point we might adapt the internal structures of g2o to use the same type
-//     as the one given is this header file.
+//     If g2o is built with G2O_USE_64BIT_INDEX, csi is ptrdiff_t and agrees with
+//     g2o::SparseIndex, see g2o/core/sparse_index.h.
+#ifndef G2O_USE_64BIT_INDEX
 #define csi int
+#endif
 
 /* -------------------------------------------------------------------------- */
 /* In version 3.0.0 of CSparse, "int" is no longer used.  32-bit MATLAB is
@@ -86,8 +86,10 @@ FIND_G2O_LIBRARY(G2O_SOLVER_CHOLMOD solver_cholmod)
 FIND_G2O_LIBRARY(G2O_SOLVER_CSPARSE solver_csparse)
 FIND_G2O_LIBRARY(G2O_SOLVER_CSPARSE_EXTENSION csparse_extension)
 FIND_G2O_LIBRARY(G2O_SOLVER_DENSE solver_dense)
+FIND_G2O_LIBRARY(G2O_SOLVER_BLOCK_CHOLESKY solver_block_cholesky)
 FIND_G2O_LIBRARY(G2O_SOLVER_PCG solver_pcg)
 FIND_G2O_LIBRARY(G2O_SOLVER_SLAM2D_LINEAR solver_slam2d_linear)
+FIND_G2O_LIBRARY(G2O_SOLVER_SLAM3D_LINEAR solver_slam3d_linear)
 FIND_G2O_LIBRARY(G2O_SOLVER_STRUCTURE_ONLY solver_structure_only)
 FIND_G2O_LIBRARY(G2O_SOLVER_EIGEN solver_eigen)
 
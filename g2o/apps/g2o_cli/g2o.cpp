@@ -49,6 +49,8 @@
 #include "g2o/core/robust_kernel_factory.h"
 #include "g2o/core/optimization_algorithm.h"
 #include "g2o/core/sparse_optimizer_terminate_action.h"
+#include "g2o/core/memory_pool.h"
+#include "g2o/core/information_pool.h"
 
 #include "g2o/stuff/macros.h"
 #include "g2o/stuff/color_macros.h"
@@ -99,6 +101,39 @@ void sigquit_handler(int sig)
   }
 }
 
+/**
+ * initialize the poses by running the first iteration of the 3dlinear
+ * algorithm, which is loaded as any other solver. optimize() runs it on
+ * the full active graph, also if -components is given.
+ */
+static bool computeChordalInitialGuess(SparseOptimizer& optimizer)
+{
+  OptimizationAlgorithmProperty guessProperty;
+  OptimizationAlgorithm* guessAlgorithm = OptimizationAlgorithmFactory::instance()->construct("3dlinear", guessProperty);
+  if (! guessAlgorithm)
+    return false;
+  // a bool property is parsed by operator>>, i.e., it has to be given as 0 / 1
+  if (! guessAlgorithm->updatePropertiesFromString("initialGuessOnly=1")) {
+    delete guessAlgorithm;
+    return false;
+  }
+  OptimizationAlgorithm* algorithm = optimizer.solver();
+  optimizer.setAlgorithm(guessAlgorithm);
+  bool ok = optimizer.optimize(1) > 0;
+  optimizer.setAlgorithm(algorithm);
+  delete guessAlgorithm;
+  optimizer.computeActiveErrors();
+  return ok;
+}
+
+#ifdef G2O_USE_MEMORY_POOL
+static void reportMemoryPool(const char* phase)
+{
+  cerr << "# memory pool (" << phase << "): " << MemoryPool::global().statistics() << endl;
+  MemoryPool::global().resetCounters();
+}
+#endif
+
 int main(int argc, char** argv)
 {
   OptimizableGraph::initMultiThreading();
@@ -112,6 +147,7 @@ int main(int argc, char** argv)
   string loadLookup;
   bool initialGuess;
   bool initialGuessOdometry;
+  bool initialGuessChordal;
   bool marginalize;
   bool listTypes;
   bool listSolvers;
@@ -130,6 +166,9 @@ int main(int argc, char** argv)
   string statsFile;
   string summaryFile;
   bool nonSequential;
+  bool solveComponents;
+  bool sqrtInformation;
+  bool shareInformation;
   // command line parsing
   std::vector<int> gaugeList;
   CommandArgs arg;
@@ -139,6 +178,7 @@ int main(int argc, char** argv)
   arg.param("v", verbose, false, "verbose output of the optimization process");
   arg.param("guess", initialGuess, false, "initial guess based on spanning tree");
   arg.param("guessOdometry", initialGuessOdometry, false, "initial guess based on odometry");
+  arg.param("guessChordal", initialGuessChordal, false, "initial guess based on the chordal relaxation of the rotations (3D pose graphs)");
   arg.param("inc", incremental, false, "run incremetally");
   arg.param("update", updateGraphEachN, 10, "updates after x odometry nodes");
   arg.param("guiout", guiOut, false, "gui output while running incrementally");
@@ -150,7 +190,7 @@ int main(int argc, char** argv)
   arg.param("robustKernelWidth", huberWidth, -1., "width for the robust Kernel (only if robustKernel)");
   arg.param("computeMarginals", computeMarginals, false, "computes the marginal covariances of something. FOR TESTING ONLY");
   arg.param("gaugeId", gaugeId, -1, "force the gauge");
-  arg.param("o", outputfilename, "", "output final version of the graph");
+  arg.param("o", outputfilename, "", "output final version of the graph, binary if the extension is .g2ob");
   arg.param("solver", strSolver, "gn_var", "specify which solver to use underneat\n\t {gn_var, lm_fix3_2, gn_fix6_3, lm_fix7_3}");
 #ifndef G2O_DISABLE_DYNAMIC_LOADING_OF_LIBRARIES
   string dummy;
@@ -164,8 +204,11 @@ int main(int argc, char** argv)
   arg.param("renameTypes", loadLookup, "", "create a lookup for loading types into other types,\n\t TAG_IN_FILE=INTERNAL_TAG_FOR_TYPE,TAG2=INTERNAL2\n\t e.g., VERTEX_CAM=VERTEX_SE3:EXPMAP");
   arg.param("gaugeList", gaugeList, std::vector<int>(), "set the list of gauges separated by commas without spaces \n  e.g: 1,2,3,4,5 ");
   arg.param("summary", summaryFile, "", "append a summary of this optimization run to the summary file passed as argument");
-  arg.paramLeftOver("graph-input", inputFilename, "", "graph file which will be processed", true);
+  arg.paramLeftOver("graph-input", inputFilename, "", "graph file which will be processed, binary if the extension is .g2ob", true);
   arg.param("nonSequential", nonSequential, false, "apply the robust kernel only on loop closures and not odometries");
+  arg.param("components", solveComponents, false, "optimize the connected components of the graph independently");
+  arg.param("sqrtInformation", sqrtInformation, false, "build the quadratic form from the square root of the information matrices");
+  arg.param("shareInformation", shareInformation, false, "let the loaded edges with identical information matrices reference a single copy");
   
 
   arg.parseArgs(argc, argv);
@@ -204,6 +247,7 @@ int main(int argc, char** argv)
     }
   }
 
+  InformationPool informationPool; // outlives the optimizer, which references it while loading
   SparseOptimizer optimizer;
   optimizer.setVerbose(verbose);
   optimizer.setForceStopFlag(&hasToStop);
@@ -240,6 +284,8 @@ int main(int argc, char** argv)
   if (loadLookup.size() > 0) {
     optimizer.setRenamedTypesFromString(loadLookup);
   }
+  if (shareInformation)
+    optimizer.setInformationPool(&informationPool);
   if (inputFilename.size() == 0) {
     cerr << "No input data specified" << endl;
     return 0;
@@ -251,18 +297,23 @@ int main(int argc, char** argv)
     }
   } else {
     cerr << "Read input from " << inputFilename << endl;
-    ifstream ifs(inputFilename.c_str());
+    bool binaryInput = getFileExtension(inputFilename) == "g2ob";
+    ifstream ifs(inputFilename.c_str(), binaryInput ? ios::in | ios::binary : ios::in);
     if (!ifs) {
       cerr << "Failed to open file" << endl;
       return 1;
     }
-    if (!optimizer.load(ifs)) {
+    if (binaryInput ? !optimizer.loadBinary(ifs) : !optimizer.load(ifs)) {
       cerr << "Error loading graph" << endl;
       return 2;
     }
   }
   cerr << "Loaded " << optimizer.vertices().size() << " vertices" << endl;
   cerr << "Loaded " << optimizer.edges().size() << " edges" << endl;
+# ifdef G2O_USE_MEMORY_POOL
+  if (verbose)
+    reportMemoryPool("load");
+# endif
 
   if (optimizer.vertices().size() == 0) {
     cerr << "Graph contains no vertices" << endl;
@@ -357,6 +408,26 @@ int main(int argc, char** argv)
     }
   }
 
+  if (shareInformation) {
+    int numShared = 0;
+    for (SparseOptimizer::EdgeSet::iterator it = optimizer.edges().begin(); it != optimizer.edges().end(); ++it)
+      if (static_cast<SparseOptimizer::Edge*>(*it)->informationShared())
+        ++numShared;
+    // edges with a matrix of fixed size keep their inline matrix, the pool saves the entries of dynamic ones
+    cerr << "# Shared information: " << informationPool.size() << " distinct matrices (" << informationPool.bytes() << " bytes) for "
+      << optimizer.edges().size() << " edges, " << numShared << " edges reference the pool" << endl;
+  }
+
+  if (sqrtInformation) {
+    int numSupported = 0;
+    for (SparseOptimizer::EdgeSet::iterator it = optimizer.edges().begin(); it != optimizer.edges().end(); ++it) {
+      SparseOptimizer::Edge* e = static_cast<SparseOptimizer::Edge*>(*it);
+      if (e->setUseSqrtInformation(true))
+        ++numSupported;
+    }
+    cerr << "# Square root information for " << numSupported << " of " << optimizer.edges().size() << " edges" << endl;
+  }
+
   // sanity check
   HyperDijkstra d(&optimizer);
   UniformCostFunction f;
@@ -571,11 +642,16 @@ int main(int argc, char** argv)
     } else if (initialGuessOdometry) {
       EstimatePropagatorCostOdometry costFunction(&optimizer);
       optimizer.computeInitialGuess(costFunction);
+    } else if (initialGuessChordal) {
+      if (! computeChordalInitialGuess(optimizer)) {
+        cerr << "Error computing the chordal initial guess, is the solver library slam3d_linear available?" << endl;
+        return 4;
+      }
     }
     double initChi = optimizer.chi2();
 
     signal(SIGINT, sigquit_handler);
-    int result=optimizer.optimize(maxIterations);
+    int result = solveComponents ? optimizer.optimizeComponents(maxIterations) : optimizer.optimize(maxIterations);
     if (maxIterations > 0 && result==OptimizationAlgorithm::Fail){
       cerr << "Cholesky failed, result might be invalid" << endl;
     } else if (computeMarginals){
@@ -610,6 +686,10 @@ int main(int argc, char** argv)
     
     optimizer.computeActiveErrors();
     double finalChi=optimizer.chi2();
+#   ifdef G2O_USE_MEMORY_POOL
+    if (verbose)
+      reportMemoryPool("optimize");
+#   endif
 
     if  (summaryFile!="") {
       PropertyMap summary;
@@ -679,11 +759,23 @@ int main(int argc, char** argv)
       optimizer.save(cout);
     } else {
       cerr << "saving " << outputfilename << " ... ";
-      optimizer.save(outputfilename.c_str());
+      if (getFileExtension(outputfilename) == "g2ob")
+        optimizer.saveBinary(outputfilename.c_str());
+      else
+        optimizer.save(outputfilename.c_str());
     }
     cerr << "done." << endl;
   }
 
+# ifdef G2O_USE_MEMORY_POOL
+  if (verbose) {
+    double clearStart = get_monotonic_time();
+    optimizer.clear();
+    cerr << "# clearing the graph took " << get_monotonic_time() - clearStart << " seconds" << endl;
+    reportMemoryPool("clear");
+  }
+# endif
+
   // destroy all the singletons
   //Factory::destroy();
   //OptimizationAlgorithmFactory::destroy();
@@ -55,9 +55,9 @@ namespace g2o {
       typedef typename BaseEdge<D,E>::InformationType InformationType;
 
       typedef Eigen::Map<Eigen::Matrix<double, Di, Dj, Di==1?Eigen::RowMajor:Eigen::ColMajor>,
-                         Eigen::Matrix<double, Di, Dj, Di==1?Eigen::RowMajor:Eigen::ColMajor>::Flags & Eigen::AlignedBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockType;
+                         Eigen::Matrix<double, Di, Dj, Di==1?Eigen::RowMajor:Eigen::ColMajor>::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockType;
       typedef Eigen::Map<Eigen::Matrix<double, Dj, Di, Dj==1?Eigen::RowMajor:Eigen::ColMajor>,
-                         Eigen::Matrix<double, Dj, Di, Dj==1?Eigen::RowMajor:Eigen::ColMajor>::Flags & Eigen::AlignedBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockTransposedType;
+                         Eigen::Matrix<double, Dj, Di, Dj==1?Eigen::RowMajor:Eigen::ColMajor>::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockTransposedType;
 
       BaseBinaryEdge() : BaseEdge<D,E>(),
       _hessianRowMajor(false),
@@ -99,6 +99,7 @@ namespace g2o {
     protected:
       using BaseEdge<D,E>::_measurement;
       using BaseEdge<D,E>::_information;
+      using BaseEdge<D,E>::currentInformation;
       using BaseEdge<D,E>::_error;
       using BaseEdge<D,E>::_vertices;
       using BaseEdge<D,E>::_dimension;
@@ -110,7 +111,7 @@ namespace g2o {
       JacobianXjOplusType _jacobianOplusXj;
 
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
   };
 
 #include "base_binary_edge.hpp"
@@ -75,13 +75,43 @@ void BaseBinaryEdge<D, E, VertexXiType, VertexXjType>::constructQuadraticForm()
   bool toNotFixed = !(to->fixed());
 
   if (fromNotFixed || toNotFixed) {
+    const InformationType* sqrtOmega = this->sqrtInformation();
 #ifdef G2O_OPENMP
     from->lockQuadraticForm();
     to->lockQuadraticForm();
 #endif
-    const InformationType& omega = _information;
-    Eigen::Matrix<double, D, 1, Eigen::ColMajor> omega_r = - omega * _error;
-    if (this->robustKernel() == 0) {
+    const InformationType& omega = currentInformation();
+    Eigen::Matrix<double, D, 1, Eigen::ColMajor> omega_r;
+    if (sqrtOmega) { // whitened error and Jacobians, the quadratic form reduces to J^T J
+      double weight = 1.;
+      if (this->robustKernel()) {
+        Vector3D rho;
+        this->robustKernel()->robustify(this->chi2(), rho);
+        weight = rho[1];
+      }
+      omega_r.noalias() = - weight * (*sqrtOmega * _error);
+      typename JacobianXjOplusType::PlainObject WB; // also used for the off-diagonal block
+      if (toNotFixed)
+        WB.noalias() = *sqrtOmega * B;
+      else
+        WB.setZero(B.rows(), B.cols());
+      if (fromNotFixed) {
+        const typename JacobianXiOplusType::PlainObject WA = *sqrtOmega * A;
+        from->b().noalias() += WA.transpose() * omega_r;
+        from->A().noalias() += weight * WA.transpose() * WA;
+        if (toNotFixed ) {
+          if (_hessianRowMajor) // we have to write to the block as transposed
+            _hessianTransposed.noalias() += weight * WB.transpose() * WA;
+          else
+            _hessian.noalias() += weight * WA.transpose() * WB;
+        }
+      }
+      if (toNotFixed) {
+        to->b().noalias() += WB.transpose() * omega_r;
+        to->A().noalias() += weight * WB.transpose() * WB;
+      }
+    } else if (this->robustKernel() == 0) {
+      omega_r.noalias() = - omega * _error;
       if (fromNotFixed) {
         Eigen::Matrix<double, VertexXiType::Dimension, D, Eigen::ColMajor> AtO = A.transpose() * omega;
         from->b().noalias() += A.transpose() * omega_r;
@@ -105,7 +135,7 @@ void BaseBinaryEdge<D, E, VertexXiType, VertexXjType>::constructQuadraticForm()
       //std::cout << PVAR(rho.transpose()) << std::endl;
       //std::cout << PVAR(weightedOmega) << std::endl;
 
-      omega_r *= rho[1];
+      omega_r.noalias() = - rho[1] * (omega * _error);
       if (fromNotFixed) {
         from->b().noalias() += A.transpose() * omega_r;
         from->A().noalias() += A.transpose() * weightedOmega * A;
@@ -29,10 +29,13 @@
 
 #include <iostream>
 #include <limits>
+#include <memory>
 
 #include <Eigen/Core>
+#include <Eigen/Cholesky>
 
 #include "optimizable_graph.h"
+#include "information_pool.h"
 
 namespace g2o {
 
@@ -55,6 +58,8 @@ namespace g2o {
 
       virtual double chi2() const
       {
+        if (const InformationType* sqrtOmega = sqrtInformation())
+          return (*sqrtOmega * _error).squaredNorm();
         return _error.dot(information()*_error);
       }
 
@@ -63,13 +68,62 @@ namespace g2o {
       const ErrorVector& error() const { return _error;}
       ErrorVector& error() { return _error;}
 
-      //! information matrix of the constraint
-      const InformationType& information() const { return _information;}
-      InformationType& information() { return _information;}
-      void setInformation(const InformationType& information) { _information = information;}
+      /**
+       * information matrix of the constraint. The matrix may be shared with
+       * other edges, see shareInformation(). The non-const accessors give the
+       * edge its own copy of a shared matrix first and call informationChanged().
+       */
+      const InformationType& information() const { return currentInformation();}
+      InformationType& information() { detachInformation(); informationChanged(); return _information;}
+      void setInformation(const InformationType& information) { _sharedInformation.reset(); _information = information; informationChanged();}
+
+      virtual const double* informationData() const { return currentInformation().data();}
+      virtual double* informationData() { return information().data();}
+
+      virtual bool shareInformation(InformationPool& pool)
+      {
+        const InformationType& omega = currentInformation();
+        std::shared_ptr<void> shared = pool.find(Dimension, static_cast<int>(omega.rows()), omega.data());
+        if (! shared) {
+          pool.insert(Dimension, static_cast<int>(omega.rows()), omega.data(),
+              std::allocate_shared<InformationType>(Eigen::aligned_allocator<InformationType>(), omega));
+          return false;
+        }
+        if (shared.get() == _sharedInformation.get())
+          return false;
+        _sharedInformation = std::static_pointer_cast<const InformationType>(shared);
+        return true;
+      }
+      virtual bool informationShared() const { return _sharedInformation.get() != 0;}
+
+      virtual bool setUseSqrtInformation(bool use)
+      {
+        if (! use)
+          _sqrtInformation.reset();
+        else if (! _sqrtInformation) {
+          _sqrtInformation.reset(new SqrtInformation);
+          updateSqrtInformation();
+        }
+        return true;
+      }
+      virtual bool useSqrtInformation() const { return _sqrtInformation.get() != 0;}
 
-      virtual const double* informationData() const { return _information.data();}
-      virtual double* informationData() { return _information.data();}
+      /**
+       * upper triangular square root U of the information matrix, i.e.,
+       * Omega = U^T U. Returns 0 if the square root form is disabled or if
+       * the information matrix is not positive definite. The factor is
+       * recomputed only if the information matrix differs from the one it
+       * was computed from.
+       */
+      const InformationType* sqrtInformation() const
+      {
+        if (! _sqrtInformation)
+          return 0;
+        const InformationType& omega = currentInformation();
+        if (_sqrtInformation->information != omega)
+          updateSqrtInformation();
+        return _sqrtInformation->valid ? &_sqrtInformation->factor : 0;
+      }
 
       //! accessor functions for the measurement represented by the edge
       const Measurement& measurement() const { return _measurement;}
@@ -86,21 +140,60 @@ namespace g2o {
 
       Measurement _measurement;
       InformationType _information;
+      std::shared_ptr<const InformationType> _sharedInformation; ///< 0 unless the edge references the matrix of a pool
       ErrorVector _error;
 
+      //! square root of the information matrix, together with the matrix it was computed from
+      struct SqrtInformation
+      {
+        InformationType factor;
+        InformationType information;
+        bool valid;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      };
+      mutable std::unique_ptr<SqrtInformation> _sqrtInformation; ///< allocated only if the square root form is enabled
+
       /**
        * calculate the robust information matrix by updating the information matrix of the error
        */
       InformationType robustInformation(const Vector3D& rho)
       {
-        InformationType result = rho[1] * _information;
+        InformationType result = rho[1] * currentInformation();
         //ErrorVector weightedErrror = _information * _error;
         //result.noalias() += 2 * rho[2] * (weightedErrror * weightedErrror.transpose());
         return result;
       }
 
+      /**
+       * called by the modifying accessors of the information matrix, lets a
+       * derived class invalidate the properties it derived from the matrix
+       */
+      virtual void informationChanged() {}
+
+      //! the information matrix in use, const to not detach it from a shared one
+      const InformationType& currentInformation() const { return _sharedInformation ? *_sharedInformation : _information;}
+
+      //! gives the edge its own copy of a shared information matrix
+      void detachInformation()
+      {
+        if (_sharedInformation) {
+          _information = *_sharedInformation;
+          _sharedInformation.reset();
+        }
+      }
+
+      void updateSqrtInformation() const
+      {
+        const InformationType& omega = currentInformation();
+        Eigen::LLT<InformationType> llt(omega);
+        _sqrtInformation->information = omega;
+        _sqrtInformation->valid = llt.info() == Eigen::Success;
+        if (_sqrtInformation->valid)
+          _sqrtInformation->factor = llt.matrixU();
+      }
+
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
   };
 
 
@@ -114,14 +207,16 @@ namespace g2o {
       typedef Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor> ErrorVector;
       typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> InformationType;
 
-      BaseEdge() : OptimizableGraph::Edge(){
-
+      BaseEdge() : OptimizableGraph::Edge()
+      {
       }
 
       virtual ~BaseEdge() {}
 
       virtual double chi2() const
       {
+        if (const InformationType* sqrtOmega = sqrtInformation())
+          return (*sqrtOmega * _error).squaredNorm();
         return _error.dot(information()*_error);
       }
 
@@ -130,13 +225,63 @@ namespace g2o {
       const ErrorVector& error() const { return _error;}
       ErrorVector& error() { return _error;}
 
-      //! information matrix of the constraint
-      const InformationType& information() const { return _information;}
-      InformationType& information() { return _information;}
-      void setInformation(const InformationType& information) { _information = information;}
+      /**
+       * information matrix of the constraint. The matrix may be shared with
+       * other edges, see shareInformation(). The non-const accessors give the
+       * edge its own copy of a shared matrix first and call informationChanged().
+       */
+      const InformationType& information() const { return currentInformation();}
+      InformationType& information() { detachInformation(); informationChanged(); return _information;}
+      void setInformation(const InformationType& information) { _sharedInformation.reset(); _information = information; informationChanged();}
+
+      virtual const double* informationData() const { return currentInformation().data();}
+      virtual double* informationData() { return information().data();}
+
+      virtual bool shareInformation(InformationPool& pool)
+      {
+        const InformationType& omega = currentInformation();
+        std::shared_ptr<void> shared = pool.find(Dimension, static_cast<int>(omega.rows()), omega.data());
+        if (! shared) {
+          pool.insert(Dimension, static_cast<int>(omega.rows()), omega.data(),
+              std::allocate_shared<InformationType>(Eigen::aligned_allocator<InformationType>(), omega));
+          return false;
+        }
+        if (shared.get() == _sharedInformation.get())
+          return false;
+        _sharedInformation = std::static_pointer_cast<const InformationType>(shared);
+        _information.resize(0, 0); // releases the own entries
+        return true;
+      }
+      virtual bool informationShared() const { return _sharedInformation.get() != 0;}
 
-      virtual const double* informationData() const { return _information.data();}
-      virtual double* informationData() { return _information.data();}
+      virtual bool setUseSqrtInformation(bool use)
+      {
+        if (! use)
+          _sqrtInformation.reset();
+        else if (! _sqrtInformation) {
+          _sqrtInformation.reset(new SqrtInformation);
+          updateSqrtInformation();
+        }
+        return true;
+      }
+      virtual bool useSqrtInformation() const { return _sqrtInformation.get() != 0;}
+
+      /**
+       * upper triangular square root U of the information matrix, i.e.,
+       * Omega = U^T U. Returns 0 if the square root form is disabled or if
+       * the information matrix is not positive definite. The factor is
+       * recomputed only if the information matrix differs from the one it
+       * was computed from.
+       */
+      const InformationType* sqrtInformation() const
+      {
+        if (! _sqrtInformation)
+          return 0;
+        const InformationType& omega = currentInformation();
+        if (_sqrtInformation->information.rows() != omega.rows() || _sqrtInformation->information != omega)
+          updateSqrtInformation();
+        return _sqrtInformation->valid ? &_sqrtInformation->factor : 0;
+      }
 
       //! accessor functions for the measurement represented by the edge
       const Measurement& measurement() const { return _measurement;}
@@ -153,21 +298,60 @@ namespace g2o {
 
       Measurement _measurement;
       InformationType _information;
+      std::shared_ptr<const InformationType> _sharedInformation; ///< 0 unless the edge references the matrix of a pool
       ErrorVector _error;
 
+      //! square root of the information matrix, together with the matrix it was computed from
+      struct SqrtInformation
+      {
+        InformationType factor;
+        InformationType information;
+        bool valid;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      };
+      mutable std::unique_ptr<SqrtInformation> _sqrtInformation; ///< allocated only if the square root form is enabled
+
       /**
        * calculate the robust information matrix by updating the information matrix of the error
        */
       InformationType robustInformation(const Vector3D& rho)
       {
-        InformationType result = rho[1] * _information;
+        InformationType result = rho[1] * currentInformation();
         //ErrorVector weightedErrror = _information * _error;
         //result.noalias() += 2 * rho[2] * (weightedErrror * weightedErrror.transpose());
         return result;
       }
 
+      /**
+       * called by the modifying accessors of the information matrix, lets a
+       * derived class invalidate the properties it derived from the matrix
+       */
+      virtual void informationChanged() {}
+
+      //! the information matrix in use, const to not detach it from a shared one
+      const InformationType& currentInformation() const { return _sharedInformation ? *_sharedInformation : _information;}
+
+      //! gives the edge its own copy of a shared information matrix
+      void detachInformation()
+      {
+        if (_sharedInformation) {
+          _information = *_sharedInformation;
+          _sharedInformation.reset();
+        }
+      }
+
+      void updateSqrtInformation() const
+      {
+        const InformationType& omega = currentInformation();
+        Eigen::LLT<InformationType> llt(omega);
+        _sqrtInformation->information = omega;
+        _sqrtInformation->valid = llt.info() == Eigen::Success;
+        if (_sqrtInformation->valid)
+          _sqrtInformation->factor = llt.matrixU();
+      }
+
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
   };
 
 
@@ -64,7 +64,7 @@ namespace g2o {
       typedef MatrixXD::MapType JacobianType;
       typedef typename BaseEdge<D,E>::ErrorVector ErrorVector;
       typedef typename BaseEdge<D,E>::InformationType InformationType;
-      typedef Eigen::Map<MatrixXD, MatrixXD::Flags & Eigen::AlignedBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockType;
+      typedef Eigen::Map<MatrixXD, MatrixXD::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockType;
 
       BaseMultiEdge() : BaseEdge<D,E>()
       {
@@ -91,17 +91,21 @@ namespace g2o {
     protected:
       using BaseEdge<D,E>::_measurement;
       using BaseEdge<D,E>::_information;
+      using BaseEdge<D,E>::currentInformation;
       using BaseEdge<D,E>::_error;
       using BaseEdge<D,E>::_vertices;
       using BaseEdge<D,E>::_dimension;
 
       std::vector<HessianHelper> _hessian;
       std::vector<JacobianType, Eigen::aligned_allocator<JacobianType> > _jacobianOplus; ///< jacobians of the edge (w.r.t. oplus)
+      std::vector<MatrixXD> _whitenedJacobians; ///< scratch of computeWhitenedQuadraticForm(), reused in each iteration
 
       void computeQuadraticForm(const InformationType& omega, const ErrorVector& weightedError);
+      //! quadratic form from the whitened Jacobians and error, weight is the first derivative of the robust kernel
+      void computeWhitenedQuadraticForm(const InformationType& sqrtOmega, double weight);
 
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
     };
 
 
@@ -126,7 +130,7 @@ namespace g2o {
       typedef MatrixXD::MapType JacobianType;
       typedef typename BaseEdge<-1,E>::ErrorVector ErrorVector;
       typedef typename BaseEdge<-1,E>::InformationType InformationType;
-      typedef Eigen::Map<MatrixXD, MatrixXD::Flags & Eigen::AlignedBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockType;
+      typedef Eigen::Map<MatrixXD, MatrixXD::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned > HessianBlockType;
 
       BaseMultiEdge() : BaseEdge<-1,E>()
     {
@@ -154,17 +158,21 @@ namespace g2o {
     protected:
       using BaseEdge<-1,E>::_measurement;
       using BaseEdge<-1,E>::_information;
+      using BaseEdge<-1,E>::currentInformation;
       using BaseEdge<-1,E>::_error;
       using BaseEdge<-1,E>::_vertices;
       using BaseEdge<-1,E>::_dimension;
 
       std::vector<HessianHelper> _hessian;
       std::vector<JacobianType, Eigen::aligned_allocator<JacobianType> > _jacobianOplus; ///< jacobians of the edge (w.r.t. oplus)
+      std::vector<MatrixXD> _whitenedJacobians; ///< scratch of computeWhitenedQuadraticForm(), reused in each iteration
 
       void computeQuadraticForm(const InformationType& omega, const ErrorVector& weightedError);
+      //! quadratic form from the whitened Jacobians and error, weight is the first derivative of the robust kernel
+      void computeWhitenedQuadraticForm(const InformationType& sqrtOmega, double weight);
 
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
     };
 
 
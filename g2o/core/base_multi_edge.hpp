@@ -30,20 +30,95 @@ namespace internal {
     int elemsUpToCol = ((j-1) * j) / 2;
     return elemsUpToCol + i;
   }
+
+  /**
+   * adds the quadratic form of a multi edge from its whitened Jacobians and
+   * error, shared by BaseMultiEdge<D, E> and BaseMultiEdge<-1, E>. The
+   * whitened Jacobians are stored in the scratch buffer of the edge, which
+   * keeps its memory between the iterations.
+   */
+  template <typename InformationType, typename ErrorVector, typename JacobianContainer, typename HessianContainer>
+  void computeMultiEdgeWhitenedQuadraticForm(const HyperGraph::VertexContainer& vertices, const InformationType& sqrtOmega,
+      const ErrorVector& error, double weight, const JacobianContainer& jacobianOplus,
+      std::vector<MatrixXD>& whitenedJacobians, HessianContainer& hessian)
+  {
+    ErrorVector whitenedError = - weight * (sqrtOmega * error);
+    if (whitenedJacobians.size() != vertices.size())
+      whitenedJacobians.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      if (! static_cast<OptimizableGraph::Vertex*>(vertices[i])->fixed())
+        whitenedJacobians[i].noalias() = sqrtOmega * jacobianOplus[i];
+    }
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      OptimizableGraph::Vertex* from = static_cast<OptimizableGraph::Vertex*>(vertices[i]);
+      bool istatus = !(from->fixed());
+
+      if (istatus) {
+        const MatrixXD& WA = whitenedJacobians[i];
+        int fromDim = from->dimension();
+        assert(fromDim >= 0);
+        Eigen::Map<MatrixXD> fromMap(from->hessianData(), fromDim, fromDim);
+        Eigen::Map<VectorXD> fromB(from->bData(), fromDim);
+
+        // ii block in the hessian
+#ifdef G2O_OPENMP
+        from->lockQuadraticForm();
+#endif
+        fromMap.noalias() += weight * WA.transpose() * WA;
+        fromB.noalias() += WA.transpose() * whitenedError;
+
+        // compute the off-diagonal blocks ij for all j
+        for (size_t j = i+1; j < vertices.size(); ++j) {
+          OptimizableGraph::Vertex* to = static_cast<OptimizableGraph::Vertex*>(vertices[j]);
+#ifdef G2O_OPENMP
+          to->lockQuadraticForm();
+#endif
+          bool jstatus = !(to->fixed());
+          if (jstatus) {
+            const MatrixXD& WB = whitenedJacobians[j];
+            int idx = computeUpperTriangleIndex(i, j);
+            assert(idx < (int)hessian.size());
+            if (hessian[idx].transposed) { // we have to write to the block as transposed
+              hessian[idx].matrix.noalias() += weight * WB.transpose() * WA;
+            } else {
+              hessian[idx].matrix.noalias() += weight * WA.transpose() * WB;
+            }
+          }
+#ifdef G2O_OPENMP
+          to->unlockQuadraticForm();
+#endif
+        }
+
+#ifdef G2O_OPENMP
+        from->unlockQuadraticForm();
+#endif
+      }
+
+    }
+  }
 }
 
 template <int D, typename E>
 void BaseMultiEdge<D, E>::constructQuadraticForm()
 {
-  if (this->robustKernel()) {
+  if (const InformationType* sqrtOmega = this->sqrtInformation()) {
+    double weight = 1.;
+    if (this->robustKernel()) {
+      Vector3D rho;
+      this->robustKernel()->robustify(this->chi2(), rho);
+      weight = rho[1];
+    }
+    computeWhitenedQuadraticForm(*sqrtOmega, weight);
+  } else if (this->robustKernel()) {
     double error = this->chi2();
     Vector3D rho;
     this->robustKernel()->robustify(error, rho);
-    Eigen::Matrix<double, D, 1, Eigen::ColMajor> omega_r = - _information * _error;
+    Eigen::Matrix<double, D, 1, Eigen::ColMajor> omega_r = - currentInformation() * _error;
     omega_r *= rho[1];
     computeQuadraticForm(this->robustInformation(rho), omega_r);
   } else {
-    computeQuadraticForm(_information, - _information * _error);
+    computeQuadraticForm(currentInformation(), - currentInformation() * _error);
   }
 }
 
@@ -221,21 +296,35 @@ void BaseMultiEdge<D, E>::computeQuadraticForm(const InformationType& omega, con
   }
 }
 
+template <int D, typename E>
+void BaseMultiEdge<D, E>::computeWhitenedQuadraticForm(const InformationType& sqrtOmega, double weight)
+{
+  internal::computeMultiEdgeWhitenedQuadraticForm(_vertices, sqrtOmega, _error, weight, _jacobianOplus, _whitenedJacobians, _hessian);
+}
+
 
 // PARTIAL TEMPLATE SPECIALIZATION
 
 template <typename E>
 void BaseMultiEdge<-1, E>::constructQuadraticForm()
 {
-  if (this->robustKernel()) {
+  if (const InformationType* sqrtOmega = this->sqrtInformation()) {
+    double weight = 1.;
+    if (this->robustKernel()) {
+      Vector3D rho;
+      this->robustKernel()->robustify(this->chi2(), rho);
+      weight = rho[1];
+    }
+    computeWhitenedQuadraticForm(*sqrtOmega, weight);
+  } else if (this->robustKernel()) {
     double error = this->chi2();
     Vector3D rho;
     this->robustKernel()->robustify(error, rho);
-    Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor> omega_r = - _information * _error;
+    Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor> omega_r = - currentInformation() * _error;
     omega_r *= rho[1];
     computeQuadraticForm(this->robustInformation(rho), omega_r);
   } else {
-    computeQuadraticForm(_information, - _information * _error);
+    computeQuadraticForm(currentInformation(), - currentInformation() * _error);
   }
 }
 
@@ -412,3 +501,9 @@ void BaseMultiEdge<-1, E>::computeQuadraticForm(const InformationType& omega, co
 
   }
 }
+
+template <typename E>
+void BaseMultiEdge<-1, E>::computeWhitenedQuadraticForm(const InformationType& sqrtOmega, double weight)
+{
+  internal::computeMultiEdgeWhitenedQuadraticForm(_vertices, sqrtOmega, _error, weight, _jacobianOplus, _whitenedJacobians, _hessian);
+}
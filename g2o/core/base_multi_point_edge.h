@@ -0,0 +1,114 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, H. Strasdat, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_BASE_MULTI_POINT_EDGE_H
+#define G2O_BASE_MULTI_POINT_EDGE_H
+
+#include "base_multi_edge.h"
+
+namespace g2o {
+
+  /**
+   * \brief base class for an edge between a pose and a variable number of points
+   *
+   * Vertex 0 is the pose, the vertices 1 to n are the observed points. The
+   * error stacks one error of dimension ErrDim per point, which only depends
+   * on the pose and this point. Hence, the Jacobians consist of one ErrDim x
+   * PoseDim and one ErrDim x PointDim block per point. The derived class
+   * computes them in linearizeOplus() and stores them in _poseJacobians and
+   * _pointJacobians instead of _jacobianOplus.
+   *
+   * constructQuadraticForm() assembles the Hessian from these fixed-size
+   * blocks without allocating memory. Whether the information matrix is
+   * block diagonal is determined once after it was modified, in this case
+   * the effort is linear in the number of points. For more than
+   * ParallelThreshold points the points are processed in parallel.
+   *
+   * ErrDim - dimension of the error per point
+   * PoseDim, PointDim - dimension of the pose and the point vertices
+   * E - type to represent the measurement
+   */
+  template <int ErrDim, int PoseDim, int PointDim, typename E>
+  class BaseMultiPointEdge : public BaseMultiEdge<-1, E>
+  {
+    public:
+      typedef Eigen::Matrix<double, ErrDim, PoseDim, Eigen::ColMajor> PoseJacobianType;
+      typedef Eigen::Matrix<double, ErrDim, PointDim, Eigen::ColMajor> PointJacobianType;
+      typedef typename BaseMultiEdge<-1,E>::ErrorVector ErrorVector;
+      typedef typename BaseMultiEdge<-1,E>::InformationType InformationType;
+      typedef typename BaseMultiEdge<-1,E>::HessianHelper HessianHelper;
+
+      static const int ParallelThreshold = 1000;
+
+      BaseMultiPointEdge() : BaseMultiEdge<-1,E>(), _blockDiagonal(false), _blockDiagonalDirty(true)
+      {
+      }
+
+      virtual void resize(size_t size);
+
+      virtual void constructQuadraticForm();
+
+    protected:
+      using BaseMultiEdge<-1,E>::_information;
+      using BaseMultiEdge<-1,E>::currentInformation;
+      using BaseMultiEdge<-1,E>::_error;
+      using BaseMultiEdge<-1,E>::_vertices;
+      using BaseMultiEdge<-1,E>::_hessian;
+      using BaseMultiEdge<-1,E>::_jacobianOplus;
+
+      //! the block structure is determined again in the next constructQuadraticForm()
+      virtual void informationChanged() { _blockDiagonalDirty = true;}
+
+      //! quadratic form of the weighted information matrix, weight is the first derivative of the robust kernel
+      void computePointQuadraticForm(double weight);
+      //! copy the Jacobian blocks to _jacobianOplus for the generic implementation of BaseMultiEdge
+      void writeJacobians();
+
+      template <int R, int C>
+      static void addToHessianBlock(HessianHelper& h, const Eigen::Matrix<double, R, C>& m)
+      {
+        if (h.transposed)
+          Eigen::Map<Eigen::Matrix<double, C, R> >(h.matrix.data()) += m.transpose();
+        else
+          Eigen::Map<Eigen::Matrix<double, R, C> >(h.matrix.data()) += m;
+      }
+
+      std::vector<PoseJacobianType, Eigen::aligned_allocator<PoseJacobianType> > _poseJacobians;      ///< d error_i / d pose
+      std::vector<PointJacobianType, Eigen::aligned_allocator<PointJacobianType> > _pointJacobians;   ///< d error_i / d point_i
+      std::vector<PoseJacobianType, Eigen::aligned_allocator<PoseJacobianType> > _weightedPoseJacobians; ///< row i of Omega times the pose Jacobian
+      ErrorVector _weightedError; ///< -Omega * error
+      bool _blockDiagonal;      ///< the information matrix has no blocks coupling different points
+      bool _blockDiagonalDirty; ///< the information matrix may have changed since _blockDiagonal was computed
+
+    public:
+      G2O_MAKE_POOLED_OPERATOR_NEW;
+  };
+
+#include "base_multi_point_edge.hpp"
+
+} // end namespace g2o
+
+#endif
@@ -0,0 +1,163 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, H. Strasdat, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+template <int ErrDim, int PoseDim, int PointDim, typename E>
+const int BaseMultiPointEdge<ErrDim, PoseDim, PointDim, E>::ParallelThreshold;
+
+template <int ErrDim, int PoseDim, int PointDim, typename E>
+void BaseMultiPointEdge<ErrDim, PoseDim, PointDim, E>::resize(size_t size)
+{
+  BaseMultiEdge<-1,E>::resize(size);
+  size_t numPoints = size > 0 ? size - 1 : 0;
+  _poseJacobians.resize(numPoints);
+  _pointJacobians.resize(numPoints);
+  _weightedPoseJacobians.resize(numPoints);
+  _weightedError.resize(ErrDim * numPoints);
+  _blockDiagonalDirty = true;
+}
+
+template <int ErrDim, int PoseDim, int PointDim, typename E>
+void BaseMultiPointEdge<ErrDim, PoseDim, PointDim, E>::constructQuadraticForm()
+{
+  if (this->sqrtInformation()) {
+    // the whitened Jacobians mix the blocks of the points, use the generic implementation
+    writeJacobians();
+    BaseMultiEdge<-1,E>::constructQuadraticForm();
+    return;
+  }
+  double weight = 1.;
+  if (this->robustKernel()) {
+    Vector3D rho;
+    this->robustKernel()->robustify(this->chi2(), rho);
+    weight = rho[1];
+  }
+  computePointQuadraticForm(weight);
+}
+
+template <int ErrDim, int PoseDim, int PointDim, typename E>
+void BaseMultiPointEdge<ErrDim, PoseDim, PointDim, E>::computePointQuadraticForm(double weight)
+{
+  typedef Eigen::Matrix<double, ErrDim, ErrDim> InformationBlock;
+  typedef Eigen::Matrix<double, ErrDim, 1> ErrorBlock;
+  const int n = static_cast<int>(_vertices.size()) - 1;
+  const InformationType& omega = currentInformation();
+  OptimizableGraph::Vertex* pose = static_cast<OptimizableGraph::Vertex*>(_vertices[0]);
+  const bool poseFree = ! pose->fixed();
+  assert(pose->dimension() == PoseDim);
+
+  if (_blockDiagonalDirty) {
+    _blockDiagonal = true;
+    for (int i = 0; i < n && _blockDiagonal; ++i)
+      for (int j = i+1; j < n && _blockDiagonal; ++j)
+        _blockDiagonal = omega.template block<ErrDim, ErrDim>(ErrDim * i, ErrDim * j).isZero(0.)
+          && omega.template block<ErrDim, ErrDim>(ErrDim * j, ErrDim * i).isZero(0.);
+    _blockDiagonalDirty = false;
+  }
+
+  // row i of the weighted information matrix times the pose Jacobian and the error
+# ifdef G2O_OPENMP
+# pragma omp parallel for default (shared) if (n > ParallelThreshold)
+# endif
+  for (int i = 0; i < n; ++i) {
+    PoseJacobianType weightedJacobian = PoseJacobianType::Zero();
+    ErrorBlock weightedError = ErrorBlock::Zero();
+    const int jBegin = _blockDiagonal ? i : 0;
+    const int jEnd = _blockDiagonal ? i+1 : n;
+    for (int j = jBegin; j < jEnd; ++j) {
+      const InformationBlock omegaIJ = omega.template block<ErrDim, ErrDim>(ErrDim * i, ErrDim * j);
+      if (poseFree)
+        weightedJacobian.noalias() += omegaIJ * _poseJacobians[j];
+      weightedError.noalias() -= omegaIJ * _error.template segment<ErrDim>(ErrDim * j);
+    }
+    _weightedPoseJacobians[i] = weight * weightedJacobian;
+    _weightedError.template segment<ErrDim>(ErrDim * i) = weight * weightedError;
+  }
+
+  if (poseFree) {
+    Eigen::Matrix<double, PoseDim, PoseDim> H = Eigen::Matrix<double, PoseDim, PoseDim>::Zero();
+    Eigen::Matrix<double, PoseDim, 1> b = Eigen::Matrix<double, PoseDim, 1>::Zero();
+    for (int i = 0; i < n; ++i) {
+      H.noalias() += _poseJacobians[i].transpose() * _weightedPoseJacobians[i];
+      b.noalias() += _poseJacobians[i].transpose() * _weightedError.template segment<ErrDim>(ErrDim * i);
+    }
+#ifdef G2O_OPENMP
+    pose->lockQuadraticForm();
+#endif
+    Eigen::Map<Eigen::Matrix<double, PoseDim, PoseDim> >(pose->hessianData()) += H;
+    Eigen::Map<Eigen::Matrix<double, PoseDim, 1> >(pose->bData()) += b;
+#ifdef G2O_OPENMP
+    pose->unlockQuadraticForm();
+#endif
+  }
+
+  // the blocks of the points, the lock of the point also guards the off-diagonal blocks of the point
+# ifdef G2O_OPENMP
+# pragma omp parallel for default (shared) if (n > ParallelThreshold)
+# endif
+  for (int j = 0; j < n; ++j) {
+    OptimizableGraph::Vertex* point = static_cast<OptimizableGraph::Vertex*>(_vertices[j+1]);
+    if (point->fixed())
+      continue;
+    assert(point->dimension() == PointDim);
+    const PointJacobianType& Bj = _pointJacobians[j];
+#ifdef G2O_OPENMP
+    point->lockQuadraticForm();
+#endif
+    const InformationBlock omegaJJ = weight * omega.template block<ErrDim, ErrDim>(ErrDim * j, ErrDim * j);
+    const PointJacobianType omegaBj = omegaJJ * Bj;
+    Eigen::Map<Eigen::Matrix<double, PointDim, PointDim> >(point->hessianData()).noalias() += Bj.transpose() * omegaBj;
+    Eigen::Map<Eigen::Matrix<double, PointDim, 1> >(point->bData()).noalias() += Bj.transpose() * _weightedError.template segment<ErrDim>(ErrDim * j);
+
+    if (poseFree) {
+      const Eigen::Matrix<double, PoseDim, PointDim> Hpj = _weightedPoseJacobians[j].transpose() * Bj;
+      addToHessianBlock(_hessian[internal::computeUpperTriangleIndex(0, j+1)], Hpj);
+    }
+
+    const int kEnd = _blockDiagonal ? 0 : n;
+    for (int k = j+1; k < kEnd; ++k) {
+      if (static_cast<OptimizableGraph::Vertex*>(_vertices[k+1])->fixed())
+        continue;
+      const InformationBlock omegaJK = omega.template block<ErrDim, ErrDim>(ErrDim * j, ErrDim * k);
+      const Eigen::Matrix<double, PointDim, PointDim> Hjk = weight * Bj.transpose() * omegaJK * _pointJacobians[k];
+      addToHessianBlock(_hessian[internal::computeUpperTriangleIndex(j+1, k+1)], Hjk);
+    }
+#ifdef G2O_OPENMP
+    point->unlockQuadraticForm();
+#endif
+  }
+}
+
+template <int ErrDim, int PoseDim, int PointDim, typename E>
+void BaseMultiPointEdge<ErrDim, PoseDim, PointDim, E>::writeJacobians()
+{
+  const int n = static_cast<int>(_vertices.size()) - 1;
+  _jacobianOplus[0].setZero();
+  for (int i = 0; i < n; ++i) {
+    _jacobianOplus[0].template block<ErrDim, PoseDim>(ErrDim * i, 0) = _poseJacobians[i];
+    _jacobianOplus[i+1].setZero();
+    _jacobianOplus[i+1].template block<ErrDim, PointDim>(ErrDim * i, 0) = _pointJacobians[i];
+  }
+}
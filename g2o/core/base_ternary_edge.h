@@ -0,0 +1,179 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, H. Strasdat, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_BASE_TERNARY_EDGE_H
+#define G2O_BASE_TERNARY_EDGE_H
+
+#include <iostream>
+#include <limits>
+
+#include "base_edge.h"
+#include "robust_kernel.h"
+#include "g2o/config.h"
+
+namespace g2o {
+
+  /**
+   * \brief base class for an edge connecting three vertices of known types
+   *
+   * Compared to BaseMultiEdge the Jacobians and the off-diagonal Hessian
+   * blocks have a fixed size. Hence, linearizing the edge and constructing
+   * its quadratic form do not allocate memory, also the numeric Jacobians
+   * use stack storage.
+   */
+  template <int D, typename E, typename VertexXi, typename VertexXj, typename VertexXk>
+  class BaseTernaryEdge : public BaseEdge<D, E>
+  {
+    public:
+
+      typedef VertexXi VertexXiType;
+      typedef VertexXj VertexXjType;
+      typedef VertexXk VertexXkType;
+
+      static const int Di = VertexXiType::Dimension;
+      static const int Dj = VertexXjType::Dimension;
+      static const int Dk = VertexXkType::Dimension;
+
+      static const int Dimension = BaseEdge<D, E>::Dimension;
+      typedef typename BaseEdge<D,E>::Measurement Measurement;
+      typedef typename Eigen::Matrix<double, D, Di, D==1?Eigen::RowMajor:Eigen::ColMajor>::AlignedMapType JacobianXiOplusType;
+      typedef typename Eigen::Matrix<double, D, Dj, D==1?Eigen::RowMajor:Eigen::ColMajor>::AlignedMapType JacobianXjOplusType;
+      typedef typename Eigen::Matrix<double, D, Dk, D==1?Eigen::RowMajor:Eigen::ColMajor>::AlignedMapType JacobianXkOplusType;
+      typedef typename BaseEdge<D,E>::ErrorVector ErrorVector;
+      typedef typename BaseEdge<D,E>::InformationType InformationType;
+
+      /**
+       * \brief off-diagonal block of the Hessian, which is mapped either as R x C or transposed
+       */
+      template <int R, int C>
+      struct HessianHelper {
+        typedef Eigen::Matrix<double, R, C, R==1?Eigen::RowMajor:Eigen::ColMajor> MatrixType;
+        typedef Eigen::Matrix<double, C, R, C==1?Eigen::RowMajor:Eigen::ColMajor> TransposedMatrixType;
+        typedef Eigen::Map<MatrixType, MatrixType::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned > BlockType;
+        typedef Eigen::Map<TransposedMatrixType, TransposedMatrixType::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned > TransposedBlockType;
+
+        BlockType matrix;
+        TransposedBlockType transposedMatrix;
+        bool transposed;    ///< the block has to be transposed
+
+        // HACK we map to the null pointer for initializing the Maps
+        HessianHelper() : matrix(0, R, C), transposedMatrix(0, C, R), transposed(false) {}
+
+        void map(double* d, bool rowMajor)
+        {
+          if (rowMajor)
+            new (&transposedMatrix) TransposedBlockType(d, C, R);
+          else
+            new (&matrix) BlockType(d, R, C);
+          transposed = rowMajor;
+        }
+
+        template <typename Derived>
+        void add(const Eigen::MatrixBase<Derived>& m)
+        {
+          if (transposed)
+            transposedMatrix.noalias() += m.transpose();
+          else
+            matrix.noalias() += m;
+        }
+
+        /**
+         * adds m^T, for a block which is mapped onto the diagonal block of a
+         * vertex connected twice by the edge, hence R == C
+         */
+        template <typename Derived>
+        void addTransposed(const Eigen::MatrixBase<Derived>& m)
+        {
+          assert(R == C);
+          if (transposed)
+            Eigen::Map<MatrixType>(transposedMatrix.data()).noalias() += m;
+          else
+            Eigen::Map<TransposedMatrixType>(matrix.data()).noalias() += m.transpose();
+        }
+      };
+
+      BaseTernaryEdge() : BaseEdge<D,E>(),
+      _jacobianOplusXi(0, D, Di), _jacobianOplusXj(0, D, Dj), _jacobianOplusXk(0, D, Dk)
+      {
+        _vertices.resize(3);
+      }
+
+      virtual OptimizableGraph::Vertex* createVertex(int i);
+
+      virtual void resize(size_t size);
+
+      virtual bool allVerticesFixed() const;
+
+      virtual void linearizeOplus(JacobianWorkspace& jacobianWorkspace);
+
+      /**
+       * Linearizes the oplus operator in the vertex, and stores
+       * the result in temporary variables _jacobianOplusXi, _jacobianOplusXj and _jacobianOplusXk
+       */
+      virtual void linearizeOplus();
+
+      //! returns the result of the linearization in the manifold space for the node xi
+      const JacobianXiOplusType& jacobianOplusXi() const { return _jacobianOplusXi;}
+      //! returns the result of the linearization in the manifold space for the node xj
+      const JacobianXjOplusType& jacobianOplusXj() const { return _jacobianOplusXj;}
+      //! returns the result of the linearization in the manifold space for the node xk
+      const JacobianXkOplusType& jacobianOplusXk() const { return _jacobianOplusXk;}
+
+      virtual void constructQuadraticForm() ;
+
+      virtual void mapHessianMemory(double* d, int i, int j, bool rowMajor);
+
+      using BaseEdge<D,E>::resize;
+      using BaseEdge<D,E>::computeError;
+
+    protected:
+      using BaseEdge<D,E>::_measurement;
+      using BaseEdge<D,E>::_information;
+      using BaseEdge<D,E>::currentInformation;
+      using BaseEdge<D,E>::_error;
+      using BaseEdge<D,E>::_vertices;
+      using BaseEdge<D,E>::_dimension;
+
+      //! central differences of the error w.r.t. the vertex v
+      template <typename VertexType, typename JacobianType>
+      void numericJacobian(VertexType* v, JacobianType& jacobian);
+
+      HessianHelper<Di, Dj> _hessianXiXj;
+      HessianHelper<Di, Dk> _hessianXiXk;
+      HessianHelper<Dj, Dk> _hessianXjXk;
+      JacobianXiOplusType _jacobianOplusXi;
+      JacobianXjOplusType _jacobianOplusXj;
+      JacobianXkOplusType _jacobianOplusXk;
+
+    public:
+      G2O_MAKE_POOLED_OPERATOR_NEW
+  };
+
+#include "base_ternary_edge.hpp"
+
+} // end namespace g2o
+
+#endif
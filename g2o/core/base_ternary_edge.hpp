@@ -0,0 +1,266 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, H. Strasdat, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+OptimizableGraph::Vertex* BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::createVertex(int i){
+  switch(i) {
+  case 0: return new VertexXiType();
+  case 1: return new VertexXjType();
+  case 2: return new VertexXkType();
+  default: return 0;
+  }
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+void BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::resize(size_t size)
+{
+  if (size != 3) {
+    std::cerr << "WARNING, attempting to resize ternary edge " << BaseEdge<D, E>::id() << " to " << size << std::endl;
+  }
+  BaseEdge<D, E>::resize(size);
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+bool BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::allVerticesFixed() const
+{
+  return (static_cast<const VertexXiType*> (_vertices[0])->fixed() &&
+          static_cast<const VertexXjType*> (_vertices[1])->fixed() &&
+          static_cast<const VertexXkType*> (_vertices[2])->fixed());
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+void BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::constructQuadraticForm()
+{
+  VertexXiType* vi = static_cast<VertexXiType*>(_vertices[0]);
+  VertexXjType* vj = static_cast<VertexXjType*>(_vertices[1]);
+  VertexXkType* vk = static_cast<VertexXkType*>(_vertices[2]);
+
+  bool iNotFixed = !(vi->fixed());
+  bool jNotFixed = !(vj->fixed());
+  bool kNotFixed = !(vk->fixed());
+
+  if (!iNotFixed && !jNotFixed && !kNotFixed)
+    return;
+
+  double weight = 1.;
+  if (this->robustKernel()) {
+    Vector3D rho;
+    this->robustKernel()->robustify(this->chi2(), rho);
+    weight = rho[1];
+  }
+
+  // WA, WB, WC are the Jacobians, whitened in the square root form, and
+  // AtO, BtO, CtO their transposed counterparts, such that the blocks of the
+  // Hessian are AtO * WB etc. and the gradient is WA^T * omega_r etc.
+  typename JacobianXiOplusType::PlainObject WA;
+  typename JacobianXjOplusType::PlainObject WB;
+  typename JacobianXkOplusType::PlainObject WC;
+  Eigen::Matrix<double, Di, D, (Di==1 && D!=1) ? Eigen::RowMajor : Eigen::ColMajor> AtO;
+  Eigen::Matrix<double, Dj, D, (Dj==1 && D!=1) ? Eigen::RowMajor : Eigen::ColMajor> BtO;
+  Eigen::Matrix<double, Dk, D, (Dk==1 && D!=1) ? Eigen::RowMajor : Eigen::ColMajor> CtO;
+  Eigen::Matrix<double, D, 1, Eigen::ColMajor> omega_r;
+
+  if (const InformationType* sqrtOmega = this->sqrtInformation()) { // whitened error and Jacobians
+    omega_r.noalias() = - weight * (*sqrtOmega * _error);
+    if (iNotFixed) {
+      WA.noalias() = *sqrtOmega * _jacobianOplusXi;
+      AtO = weight * WA.transpose();
+    }
+    if (jNotFixed) {
+      WB.noalias() = *sqrtOmega * _jacobianOplusXj;
+      BtO = weight * WB.transpose();
+    }
+    if (kNotFixed) {
+      WC.noalias() = *sqrtOmega * _jacobianOplusXk;
+      CtO = weight * WC.transpose();
+    }
+  } else { // in case of a robust kernel the information matrix is weighted by its first derivative
+    const InformationType& omega = currentInformation();
+    omega_r.noalias() = - weight * (omega * _error);
+    if (iNotFixed) {
+      WA = _jacobianOplusXi;
+      AtO.noalias() = weight * WA.transpose() * omega;
+    }
+    if (jNotFixed) {
+      WB = _jacobianOplusXj;
+      BtO.noalias() = weight * WB.transpose() * omega;
+    }
+    if (kNotFixed) {
+      WC = _jacobianOplusXk;
+      CtO.noalias() = weight * WC.transpose() * omega;
+    }
+  }
+
+#ifdef G2O_OPENMP
+  // the same vertex may be connected twice, e.g., a camera observing a point anchored in its own frame
+  const bool lockJ = _vertices[1] != _vertices[0];
+  const bool lockK = _vertices[2] != _vertices[0] && _vertices[2] != _vertices[1];
+  vi->lockQuadraticForm();
+  if (lockJ)
+    vj->lockQuadraticForm();
+  if (lockK)
+    vk->lockQuadraticForm();
+#endif
+  // the block between two slots of the same vertex is its diagonal block,
+  // which additionally receives the transposed term
+  if (iNotFixed) {
+    vi->b().noalias() += WA.transpose() * omega_r;
+    vi->A().noalias() += AtO * WA;
+    if (jNotFixed) {
+      _hessianXiXj.add(AtO * WB);
+      if (_vertices[0] == _vertices[1])
+        _hessianXiXj.addTransposed(AtO * WB);
+    }
+    if (kNotFixed) {
+      _hessianXiXk.add(AtO * WC);
+      if (_vertices[0] == _vertices[2])
+        _hessianXiXk.addTransposed(AtO * WC);
+    }
+  }
+  if (jNotFixed) {
+    vj->b().noalias() += WB.transpose() * omega_r;
+    vj->A().noalias() += BtO * WB;
+    if (kNotFixed) {
+      _hessianXjXk.add(BtO * WC);
+      if (_vertices[1] == _vertices[2])
+        _hessianXjXk.addTransposed(BtO * WC);
+    }
+  }
+  if (kNotFixed) {
+    vk->b().noalias() += WC.transpose() * omega_r;
+    vk->A().noalias() += CtO * WC;
+  }
+#ifdef G2O_OPENMP
+  if (lockK)
+    vk->unlockQuadraticForm();
+  if (lockJ)
+    vj->unlockQuadraticForm();
+  vi->unlockQuadraticForm();
+#endif
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+void BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::linearizeOplus(JacobianWorkspace& jacobianWorkspace)
+{
+  new (&_jacobianOplusXi) JacobianXiOplusType(jacobianWorkspace.workspaceForVertex(0), D, Di);
+  new (&_jacobianOplusXj) JacobianXjOplusType(jacobianWorkspace.workspaceForVertex(1), D, Dj);
+  new (&_jacobianOplusXk) JacobianXkOplusType(jacobianWorkspace.workspaceForVertex(2), D, Dk);
+  linearizeOplus();
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+template <typename VertexType, typename JacobianType>
+void BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::numericJacobian(VertexType* v, JacobianType& jacobian)
+{
+  const double delta = 1e-9;
+  const double scalar = 1.0 / (2*delta);
+  ErrorVector errorBak;
+  double add_v[VertexType::Dimension];
+  std::fill(add_v, add_v + VertexType::Dimension, 0.0);
+  // add small step along the unit vector in each dimension
+  for (int d = 0; d < VertexType::Dimension; ++d) {
+    v->push();
+    add_v[d] = delta;
+    v->oplus(add_v);
+    computeError();
+    errorBak = _error;
+    v->pop();
+    v->push();
+    add_v[d] = -delta;
+    v->oplus(add_v);
+    computeError();
+    errorBak -= _error;
+    v->pop();
+    add_v[d] = 0.0;
+
+    jacobian.col(d) = scalar * errorBak;
+  } // end dimension
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+void BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::linearizeOplus()
+{
+  VertexXiType* vi = static_cast<VertexXiType*>(_vertices[0]);
+  VertexXjType* vj = static_cast<VertexXjType*>(_vertices[1]);
+  VertexXkType* vk = static_cast<VertexXkType*>(_vertices[2]);
+
+  bool iNotFixed = !(vi->fixed());
+  bool jNotFixed = !(vj->fixed());
+  bool kNotFixed = !(vk->fixed());
+
+  if (!iNotFixed && !jNotFixed && !kNotFixed)
+    return;
+
+#ifdef G2O_OPENMP
+  // the same vertex may be connected twice, e.g., a camera observing a point anchored in its own frame
+  const bool lockJ = _vertices[1] != _vertices[0];
+  const bool lockK = _vertices[2] != _vertices[0] && _vertices[2] != _vertices[1];
+  vi->lockQuadraticForm();
+  if (lockJ)
+    vj->lockQuadraticForm();
+  if (lockK)
+    vk->lockQuadraticForm();
+#endif
+
+  // perturbing a vertex connected twice yields the total derivative, which is
+  // assigned to its first slot, the Jacobians of the further slots are zero
+  ErrorVector errorBeforeNumeric = _error;
+  if (iNotFixed)
+    numericJacobian(vi, _jacobianOplusXi);
+  if (jNotFixed) {
+    if (_vertices[1] == _vertices[0])
+      _jacobianOplusXj.setZero();
+    else
+      numericJacobian(vj, _jacobianOplusXj);
+  }
+  if (kNotFixed) {
+    if (_vertices[2] == _vertices[0] || _vertices[2] == _vertices[1])
+      _jacobianOplusXk.setZero();
+    else
+      numericJacobian(vk, _jacobianOplusXk);
+  }
+  _error = errorBeforeNumeric;
+
+#ifdef G2O_OPENMP
+  if (lockK)
+    vk->unlockQuadraticForm();
+  if (lockJ)
+    vj->unlockQuadraticForm();
+  vi->unlockQuadraticForm();
+#endif
+}
+
+template <int D, typename E, typename VertexXiType, typename VertexXjType, typename VertexXkType>
+void BaseTernaryEdge<D, E, VertexXiType, VertexXjType, VertexXkType>::mapHessianMemory(double* d, int i, int j, bool rowMajor)
+{
+  assert(i < j && j < 3);
+  if (i == 0 && j == 1)
+    _hessianXiXj.map(d, rowMajor);
+  else if (i == 0 && j == 2)
+    _hessianXiXk.map(d, rowMajor);
+  else
+    _hessianXjXk.map(d, rowMajor);
+}
@@ -84,6 +84,7 @@ namespace g2o {
     protected:
       using BaseEdge<D,E>::_measurement;
       using BaseEdge<D,E>::_information;
+      using BaseEdge<D,E>::currentInformation;
       using BaseEdge<D,E>::_error;
       using BaseEdge<D,E>::_vertices;
       using BaseEdge<D,E>::_dimension;
@@ -91,7 +92,7 @@ namespace g2o {
       JacobianXiOplusType _jacobianOplusXi;
 
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
   };
 
 #include "base_unary_edge.hpp"
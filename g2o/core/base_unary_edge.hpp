@@ -55,14 +55,26 @@ void BaseUnaryEdge<D, E, VertexXiType>::constructQuadraticForm()
 
   // chain rule to get the Jacobian of the nodes in the manifold domain
   const JacobianXiOplusType& A = jacobianOplusXi();
-  const InformationType& omega = _information;
+  const InformationType& omega = currentInformation();
 
   bool istatus = !from->fixed();
   if (istatus) {
+    const InformationType* sqrtOmega = this->sqrtInformation();
 #ifdef G2O_OPENMP
     from->lockQuadraticForm();
 #endif
-    if (this->robustKernel()) {
+    if (sqrtOmega) { // whitened error and Jacobian, the quadratic form reduces to J^T J
+      double weight = 1.;
+      if (this->robustKernel()) {
+        Vector3D rho;
+        this->robustKernel()->robustify(this->chi2(), rho);
+        weight = rho[1];
+      }
+      typename JacobianXiOplusType::PlainObject WA;
+      WA.noalias() = *sqrtOmega * A;
+      from->b().noalias() -= weight * WA.transpose() * (*sqrtOmega * _error);
+      from->A().noalias() += weight * WA.transpose() * WA;
+    } else if (this->robustKernel()) {
       double error = this->chi2();
       Vector3D rho;
       this->robustKernel()->robustify(error, rho);
@@ -56,7 +56,7 @@ namespace g2o {
 
     static const int Dimension = D;           ///< dimension of the estimate (minimal) in the manifold space
 
-    typedef Eigen::Map<Eigen::Matrix<double, D, D, Eigen::ColMajor>, Eigen::Matrix<double, D, D, Eigen::ColMajor>::Flags & Eigen::AlignedBit ? Eigen::Aligned : Eigen::Unaligned >  HessianBlockType;
+    typedef Eigen::Map<Eigen::Matrix<double, D, D, Eigen::ColMajor>, Eigen::Matrix<double, D, D, Eigen::ColMajor>::Flags & Eigen::PacketAccessBit ? Eigen::Aligned : Eigen::Unaligned >  HessianBlockType;
 
   public:
     BaseVertex();
@@ -106,7 +106,7 @@ namespace g2o {
     EstimateType _estimate;
     BackupStackType _backup;
   public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    G2O_MAKE_POOLED_OPERATOR_NEW
 };
 
 #include "base_vertex.hpp"
@@ -67,6 +67,7 @@ namespace g2o {
     os << PTHING(  timeNumericDecomposition ); // numeric decomposition  (0 if not done);
     os << PTHING(  timeLinearSolution );             // total time for solving Ax=b
     os << PTHING(  iterationsLinearSolver );  // iterations of PCG
+    os << PTHING(  iterationsRefinement );  // iterative refinement of the mixed-precision Cholesky
     os << PTHING(  timeUpdate ); // oplus
     os << PTHING(  timeIteration ); // total time );
 
@@ -82,6 +83,31 @@ namespace g2o {
     return os;
   };
 
+  void G2OBatchStatistics::accumulate(const G2OBatchStatistics& other)
+  {
+    numVertices += other.numVertices;
+    numEdges += other.numEdges;
+    chi2 += other.chi2;
+    timeResiduals += other.timeResiduals;
+    timeLinearize += other.timeLinearize;
+    timeQuadraticForm += other.timeQuadraticForm;
+    levenbergIterations += other.levenbergIterations;
+    timeSchurComplement += other.timeSchurComplement;
+    timeSymbolicDecomposition += other.timeSymbolicDecomposition;
+    timeNumericDecomposition += other.timeNumericDecomposition;
+    timeLinearSolution += other.timeLinearSolution;
+    timeLinearSolver += other.timeLinearSolver;
+    iterationsLinearSolver += other.iterationsLinearSolver;
+    iterationsRefinement += other.iterationsRefinement;
+    timeUpdate += other.timeUpdate;
+    timeIteration += other.timeIteration;
+    timeMarginals += other.timeMarginals;
+    hessianDimension += other.hessianDimension;
+    hessianPoseDimension += other.hessianPoseDimension;
+    hessianLandmarkDimension += other.hessianLandmarkDimension;
+    choleskyNNZ += other.choleskyNNZ;
+  }
+
   void G2OBatchStatistics::setGlobalStats(G2OBatchStatistics* b)
   {
     _globalStats = b;
@@ -59,6 +59,7 @@ namespace g2o {
     double timeLinearSolution;        ///< total time for solving Ax=b (including detup for schur)
     double timeLinearSolver;          ///< time for solving, excluding Schur setup
     int    iterationsLinearSolver;    ///< iterations of PCG, (0 if not used, i.e., Cholesky)
+    int    iterationsRefinement;      ///< iterative refinement steps of a mixed-precision Cholesky (0 if not used)
     double timeUpdate;                ///< time to apply the update
     double timeIteration;             ///< total time;
 
@@ -70,6 +71,12 @@ namespace g2o {
     size_t hessianLandmarkDimension;  ///< dimension of the landmark matrix in Schur
     size_t choleskyNNZ;               ///< number of non-zeros in the cholesky factor
 
+    /**
+     * add the counts and timings of another statistic, e.g., of a part of the
+     * graph which has been solved separately. The iteration is not touched.
+     */
+    void accumulate(const G2OBatchStatistics& other);
+
     static G2OBatchStatistics* globalStats() {return _globalStats;}
     static void setGlobalStats(G2OBatchStatistics* b);
     protected:
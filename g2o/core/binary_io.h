@@ -0,0 +1,96 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_BINARY_IO_H
+#define G2O_BINARY_IO_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace g2o {
+
+  /**
+   * helpers for the binary graph format, see OptimizableGraph::saveBinary(),
+   * and for the Data types implementing HyperGraph::Data::writeBinary().
+   * Values are stored in the byte order of the machine.
+   */
+
+  //! writes the bytes of a plain value, e.g., an int or a double
+  template <typename T>
+  inline void writeBinaryValue(std::ostream& os, const T& value)
+  {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  inline bool readBinaryValue(std::istream& is, T& value)
+  {
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return is.good();
+  }
+
+  //! writes the number of elements followed by the elements
+  template <typename T, typename Allocator>
+  inline void writeBinaryArray(std::ostream& os, const std::vector<T, Allocator>& values)
+  {
+    writeBinaryValue(os, static_cast<int>(values.size()));
+    if (values.size() > 0)
+      os.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+  }
+
+  template <typename T, typename Allocator>
+  inline bool readBinaryArray(std::istream& is, std::vector<T, Allocator>& values)
+  {
+    int size;
+    if (! readBinaryValue(is, size) || size < 0)
+      return false;
+    values.resize(size);
+    if (size > 0)
+      is.read(reinterpret_cast<char*>(&values[0]), size * sizeof(T));
+    return is.good();
+  }
+
+  inline void writeBinaryString(std::ostream& os, const std::string& str)
+  {
+    writeBinaryValue(os, static_cast<int>(str.size()));
+    os.write(str.data(), str.size());
+  }
+
+  inline bool readBinaryString(std::istream& is, std::string& str)
+  {
+    int size;
+    if (! readBinaryValue(is, size) || size < 0)
+      return false;
+    str.resize(size);
+    if (size > 0)
+      is.read(&str[0], size);
+    return is.good();
+  }
+
+} // end namespace
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef G2O_BLOCK_SOLVER_H
 #define G2O_BLOCK_SOLVER_H
 #include <Eigen/Core>
+#include <type_traits>
 #include "solver.h"
 #include "linear_solver.h"
 #include "sparse_block_matrix.h"
@@ -136,6 +137,9 @@ namespace g2o {
       virtual void setWriteDebug(bool writeDebug);
       virtual bool writeDebug() const {return _linearSolver->writeDebug();}
 
+      virtual void setSinglePrecision(bool singlePrecision) { _linearSolver->setSinglePrecision(singlePrecision);}
+      virtual bool singlePrecision() const {return _linearSolver->singlePrecision();}
+
       virtual bool saveHessian(const std::string& fileName) const;
 
       virtual void multiplyHessian(double* dest, const double* src) const { _Hpp->multiplySymmetricUpperTriangle(dest, src);}
@@ -146,6 +150,29 @@ namespace g2o {
 
       void deallocate();
 
+      /**
+       * eliminate a single landmark, i.e., invert its diagonal block and subtract its
+       * contribution from the Schur complement and the right hand side. P and L are the
+       * dimensions of the pose and landmark blocks in the landmark's column, the kernel
+       * operates on fixed size maps of the blocks if they are known at compile time.
+       * @return false, if a block of the Schur complement is missing in its pattern
+       */
+      template <int P, int L>
+      bool marginalizeLandmark(int landmarkIndex);
+
+      typedef bool (BlockSolver<Traits>::*SchurKernel)(int landmarkIndex);
+
+      /**
+       * select the kernel for eliminating a landmark of dimension landmarkDim whose
+       * column in Hpl only contains pose blocks of dimension poseDim. poseDim is
+       * Eigen::Dynamic if the column contains poses of different dimension.
+       */
+      SchurKernel selectSchurKernel(int poseDim, int landmarkDim) const;
+      SchurKernel selectSchurKernel(int poseDim, int landmarkDim, std::false_type) const;
+      SchurKernel selectSchurKernel(int poseDim, int landmarkDim, std::true_type) const;
+      template <int P>
+      SchurKernel selectSchurKernelForPose(int landmarkDim) const;
+
       SparseBlockMatrix<PoseMatrixType>* _Hpp;
       SparseBlockMatrix<LandmarkMatrixType>* _Hll;
       SparseBlockMatrix<PoseLandmarkMatrixType>* _Hpl;
@@ -158,6 +185,8 @@ namespace g2o {
 
       LinearSolver<PoseMatrixType>* _linearSolver;
 
+      std::vector<SchurKernel> _schurKernels; ///< kernel used for eliminating each landmark
+
       std::vector<PoseVectorType, Eigen::aligned_allocator<PoseVectorType> > _diagonalBackupPose;
       std::vector<LandmarkVectorType, Eigen::aligned_allocator<LandmarkVectorType> > _diagonalBackupLandmark;
 
@@ -35,6 +35,38 @@
 
 namespace g2o {
 
+namespace internal {
+  /**
+   * adds the pose blocks of the Schur complement which are filled by
+   * marginalizing v, the range [begin, end) are the edges of v
+   */
+  template <typename SchurLookup, typename EdgeIterator>
+  void addSchurPattern(SchurLookup& schurMatrixLookup, const OptimizableGraph::Vertex* v, EdgeIterator begin, EdgeIterator end)
+  {
+    for (EdgeIterator it1 = begin; it1 != end; ++it1) {
+      for (size_t i=0; i<(*it1)->vertices().size(); ++i)
+      {
+        OptimizableGraph::Vertex* v1= (OptimizableGraph::Vertex*) (*it1)->vertex(i);
+        if (v1->hessianIndex()==-1 || v1==v)
+          continue;
+        for (EdgeIterator it2 = begin; it2 != end; ++it2) {
+          for (size_t j=0; j<(*it2)->vertices().size(); ++j)
+          {
+            OptimizableGraph::Vertex* v2= (OptimizableGraph::Vertex*) (*it2)->vertex(j);
+            if (v2->hessianIndex()==-1 || v2==v)
+              continue;
+            int i1=v1->hessianIndex();
+            int i2=v2->hessianIndex();
+            if (i1<=i2) {
+              schurMatrixLookup.addBlock(i1, i2);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 template <typename Traits>
 BlockSolver<Traits>::BlockSolver(LinearSolverType* linearSolver) :
   BlockSolverBase(),
@@ -256,31 +288,34 @@ bool BlockSolver<Traits>::buildStructure(bool zeroBlocks)
   _DInvSchur->diagonal().resize(landmarkIdx);
   _Hpl->fillSparseBlockMatrixCCS(*_HplCCS);
 
+  // group the landmarks by the dimension of their blocks to select the kernel for the Schur complement
+  _schurKernels.resize(landmarkIdx);
+  for (int i = 0; i < landmarkIdx; ++i) {
+    const typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn& landmarkColumn = _HplCCS->blockCols()[i];
+    int poseDim = landmarkColumn.size() > 0 ? _HplCCS->rowsOfBlock(landmarkColumn.front().row) : Eigen::Dynamic;
+    for (size_t j = 1; j < landmarkColumn.size(); ++j) {
+      if (_HplCCS->rowsOfBlock(landmarkColumn[j].row) != poseDim) {
+        poseDim = Eigen::Dynamic;
+        break;
+      }
+    }
+    _schurKernels[i] = selectSchurKernel(poseDim, _Hll->colsOfBlock(i));
+  }
+
+  // The adjacency of the optimizer only covers the vertices it owns, the
+  // edges of a vertex owned by another graph are taken from the vertex.
+  const HyperGraph::Adjacency* adjacency = 0;
   for (size_t i = 0; i < _optimizer->indexMapping().size(); ++i) {
     OptimizableGraph::Vertex* v = _optimizer->indexMapping()[i];
-    if (v->marginalized()){
-      const HyperGraph::EdgeSet& vedges=v->edges();
-      for (HyperGraph::EdgeSet::const_iterator it1=vedges.begin(); it1!=vedges.end(); ++it1){
-        for (size_t i=0; i<(*it1)->vertices().size(); ++i)
-        {
-          OptimizableGraph::Vertex* v1= (OptimizableGraph::Vertex*) (*it1)->vertex(i);
-          if (v1->hessianIndex()==-1 || v1==v)
-            continue;
-          for  (HyperGraph::EdgeSet::const_iterator it2=vedges.begin(); it2!=vedges.end(); ++it2){
-            for (size_t j=0; j<(*it2)->vertices().size(); ++j)
-            {
-              OptimizableGraph::Vertex* v2= (OptimizableGraph::Vertex*) (*it2)->vertex(j);
-              if (v2->hessianIndex()==-1 || v2==v)
-                continue;
-              int i1=v1->hessianIndex();
-              int i2=v2->hessianIndex();
-              if (i1<=i2) {
-                schurMatrixLookup->addBlock(i1, i2);
-              }
-            }
-          }
-        }
-      }
+    if (! v->marginalized())
+      continue;
+    if (v->graph() == _optimizer) {
+      if (! adjacency)
+        adjacency = &_optimizer->adjacency();
+      HyperGraph::Adjacency::EdgeRange vedges = adjacency->edges(v);
+      internal::addSchurPattern(*schurMatrixLookup, v, vedges.begin(), vedges.end());
+    } else {
+      internal::addSchurPattern(*schurMatrixLookup, v, v->edges().begin(), v->edges().end());
     }
   }
 
@@ -372,60 +407,17 @@ bool BlockSolver<Traits>::solve(){
 
   //_DInvSchur->clear();
   memset (_coefficients, 0, _sizePoses*sizeof(double));
+  bool marginalized = true;
 # ifdef G2O_OPENMP
-# pragma omp parallel for default (shared) schedule(dynamic, 10)
+# pragma omp parallel for default (shared) schedule(dynamic, 10) reduction(&&:marginalized)
 # endif
   for (int landmarkIndex = 0; landmarkIndex < static_cast<int>(_Hll->blockCols().size()); ++landmarkIndex) {
-    const typename SparseBlockMatrix<LandmarkMatrixType>::IntBlockMap& marginalizeColumn = _Hll->blockCols()[landmarkIndex];
-    assert(marginalizeColumn.size() == 1 && "more than one block in _Hll column");
-
-    // calculate inverse block for the landmark
-    const LandmarkMatrixType * D = marginalizeColumn.begin()->second;
-    assert (D && D->rows()==D->cols() && "Error in landmark matrix");
-    LandmarkMatrixType& Dinv = _DInvSchur->diagonal()[landmarkIndex];
-    Dinv = D->inverse();
-
-    LandmarkVectorType  db(D->rows());
-    for (int j=0; j<D->rows(); ++j) {
-      db[j]=_b[_Hll->rowBaseOfBlock(landmarkIndex) + _sizePoses + j];
-    }
-    db=Dinv*db;
-
-    assert((size_t)landmarkIndex < _HplCCS->blockCols().size() && "Index out of bounds");
-    const typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn& landmarkColumn = _HplCCS->blockCols()[landmarkIndex];
-
-    for (typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn::const_iterator it_outer = landmarkColumn.begin();
-        it_outer != landmarkColumn.end(); ++it_outer) {
-      int i1 = it_outer->row;
-
-      const PoseLandmarkMatrixType* Bi = it_outer->block;
-      assert(Bi);
-
-      PoseLandmarkMatrixType BDinv = (*Bi)*(Dinv);
-      assert(_HplCCS->rowBaseOfBlock(i1) < _sizePoses && "Index out of bounds");
-      typename PoseVectorType::MapType Bb(&_coefficients[_HplCCS->rowBaseOfBlock(i1)], Bi->rows());
-#    ifdef G2O_OPENMP
-      ScopedOpenMPMutex mutexLock(&_coefficientsMutex[i1]);
-#    endif
-      Bb.noalias() += (*Bi)*db;
-
-      assert(i1 >= 0 && i1 < static_cast<int>(_HschurTransposedCCS->blockCols().size()) && "Index out of bounds");
-      typename SparseBlockMatrixCCS<PoseMatrixType>::SparseColumn::iterator targetColumnIt = _HschurTransposedCCS->blockCols()[i1].begin();
-
-      typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::RowBlock aux(i1, 0);
-      typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn::const_iterator it_inner = lower_bound(landmarkColumn.begin(), landmarkColumn.end(), aux);
-      for (; it_inner != landmarkColumn.end(); ++it_inner) {
-        int i2 = it_inner->row;
-        const PoseLandmarkMatrixType* Bj = it_inner->block;
-        assert(Bj); 
-        while (targetColumnIt->row < i2 /*&& targetColumnIt != _HschurTransposedCCS->blockCols()[i1].end()*/)
-          ++targetColumnIt;
-        assert(targetColumnIt != _HschurTransposedCCS->blockCols()[i1].end() && targetColumnIt->row == i2 && "invalid iterator, something wrong with the matrix structure");
-        PoseMatrixType* Hi1i2 = targetColumnIt->block;//_Hschur->block(i1,i2);
-        assert(Hi1i2);
-        (*Hi1i2).noalias() -= BDinv*Bj->transpose();
-      }
-    }
+    if (! (this->*_schurKernels[landmarkIndex])(landmarkIndex))
+      marginalized = false;
+  }
+  if (! marginalized) {
+    std::cerr << __PRETTY_FUNCTION__ << ": the pattern of the Schur complement misses blocks, the structure has to be rebuilt" << std::endl;
+    return false;
   }
   //cerr << "Solve [marginalize] = " <<  get_monotonic_time()-t << endl;
 
@@ -483,6 +475,122 @@ bool BlockSolver<Traits>::solve(){
 }
 
 
+template <typename Traits>
+template <int P, int L>
+bool BlockSolver<Traits>::marginalizeLandmark(int landmarkIndex)
+{
+  typedef Eigen::Matrix<double, L, L, Eigen::ColMajor> LandmarkBlock;
+  typedef Eigen::Matrix<double, L, 1, Eigen::ColMajor> LandmarkVector;
+  typedef Eigen::Matrix<double, P, L, Eigen::ColMajor> PoseLandmarkBlock;
+  typedef Eigen::Matrix<double, P, P, Eigen::ColMajor> PoseBlock;
+  typedef Eigen::Matrix<double, P, 1, Eigen::ColMajor> PoseVector;
+
+  const typename SparseBlockMatrix<LandmarkMatrixType>::IntBlockMap& marginalizeColumn = _Hll->blockCols()[landmarkIndex];
+  assert(marginalizeColumn.size() == 1 && "more than one block in _Hll column");
+
+  // calculate inverse block for the landmark
+  const LandmarkMatrixType* DBlock = marginalizeColumn.begin()->second;
+  assert (DBlock && DBlock->rows()==DBlock->cols() && "Error in landmark matrix");
+  const int landmarkDim = DBlock->rows();
+  Eigen::Map<const LandmarkBlock> D(DBlock->data(), landmarkDim, landmarkDim);
+  LandmarkMatrixType& DinvBlock = _DInvSchur->diagonal()[landmarkIndex];
+  DinvBlock.resize(landmarkDim, landmarkDim);
+  Eigen::Map<LandmarkBlock> Dinv(DinvBlock.data(), landmarkDim, landmarkDim);
+  Dinv = D.inverse();
+
+  Eigen::Map<const LandmarkVector> bl(_b + _Hll->rowBaseOfBlock(landmarkIndex) + _sizePoses, landmarkDim);
+  LandmarkVector db = Dinv * bl;
+
+  assert((size_t)landmarkIndex < _HplCCS->blockCols().size() && "Index out of bounds");
+  const typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn& landmarkColumn = _HplCCS->blockCols()[landmarkIndex];
+
+  for (typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn::const_iterator it_outer = landmarkColumn.begin();
+      it_outer != landmarkColumn.end(); ++it_outer) {
+    int i1 = it_outer->row;
+
+    assert(it_outer->block);
+    Eigen::Map<const PoseLandmarkBlock> Bi(it_outer->block->data(), it_outer->block->rows(), landmarkDim);
+
+    PoseLandmarkBlock BDinv = Bi * Dinv;
+    assert(_HplCCS->rowBaseOfBlock(i1) < _sizePoses && "Index out of bounds");
+    Eigen::Map<PoseVector> Bb(&_coefficients[_HplCCS->rowBaseOfBlock(i1)], Bi.rows());
+#  ifdef G2O_OPENMP
+    ScopedOpenMPMutex mutexLock(&_coefficientsMutex[i1]);
+#  endif
+    Bb.noalias() += Bi * db;
+
+    assert(i1 >= 0 && i1 < static_cast<int>(_HschurTransposedCCS->blockCols().size()) && "Index out of bounds");
+    typename SparseBlockMatrixCCS<PoseMatrixType>::SparseColumn::iterator targetColumnIt = _HschurTransposedCCS->blockCols()[i1].begin();
+    typename SparseBlockMatrixCCS<PoseMatrixType>::SparseColumn::iterator targetColumnEnd = _HschurTransposedCCS->blockCols()[i1].end();
+
+    typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::RowBlock aux(i1, 0);
+    typename SparseBlockMatrixCCS<PoseLandmarkMatrixType>::SparseColumn::const_iterator it_inner = lower_bound(landmarkColumn.begin(), landmarkColumn.end(), aux);
+    for (; it_inner != landmarkColumn.end(); ++it_inner) {
+      int i2 = it_inner->row;
+      assert(it_inner->block);
+      Eigen::Map<const PoseLandmarkBlock> Bj(it_inner->block->data(), it_inner->block->rows(), landmarkDim);
+      while (targetColumnIt != targetColumnEnd && targetColumnIt->row < i2)
+        ++targetColumnIt;
+      if (targetColumnIt == targetColumnEnd || targetColumnIt->row != i2)
+        return false; // the pattern of the Schur complement does not match the structure of Hpl
+      PoseMatrixType* Hi1i2 = targetColumnIt->block;//_Hschur->block(i1,i2);
+      assert(Hi1i2);
+      Eigen::Map<PoseBlock> H(Hi1i2->data(), Bi.rows(), Bj.rows());
+      H.noalias() -= BDinv * Bj.transpose();
+    }
+  }
+  return true;
+}
+
+template <typename Traits>
+typename BlockSolver<Traits>::SchurKernel BlockSolver<Traits>::selectSchurKernel(int poseDim, int landmarkDim) const
+{
+  // only the fully dynamic solver needs to dispatch at run time
+  typedef std::integral_constant<bool, PoseDim == Eigen::Dynamic && LandmarkDim == Eigen::Dynamic> IsDynamic;
+  return selectSchurKernel(poseDim, landmarkDim, IsDynamic());
+}
+
+template <typename Traits>
+typename BlockSolver<Traits>::SchurKernel BlockSolver<Traits>::selectSchurKernel(int, int, std::false_type) const
+{
+  return &BlockSolver<Traits>::template marginalizeLandmark<PoseDim, LandmarkDim>;
+}
+
+template <typename Traits>
+typename BlockSolver<Traits>::SchurKernel BlockSolver<Traits>::selectSchurKernel(int poseDim, int landmarkDim, std::true_type) const
+{
+  // fixed size kernels for the block sizes of the common SE2 / SE3 / Sim3 problems,
+  // everything else falls back to the dynamic implementation
+  switch (poseDim) {
+    case 3:
+      return selectSchurKernelForPose<3>(landmarkDim);
+    case 6:
+      return selectSchurKernelForPose<6>(landmarkDim);
+    case 7:
+      return selectSchurKernelForPose<7>(landmarkDim);
+    default:
+      return &BlockSolver<Traits>::template marginalizeLandmark<Eigen::Dynamic, Eigen::Dynamic>;
+  }
+}
+
+template <typename Traits>
+template <int P>
+typename BlockSolver<Traits>::SchurKernel BlockSolver<Traits>::selectSchurKernelForPose(int landmarkDim) const
+{
+  switch (landmarkDim) {
+    case 2:
+      return &BlockSolver<Traits>::template marginalizeLandmark<P, 2>;
+    case 3:
+      return &BlockSolver<Traits>::template marginalizeLandmark<P, 3>;
+    case 4:
+      return &BlockSolver<Traits>::template marginalizeLandmark<P, 4>;
+    case 6:
+      return &BlockSolver<Traits>::template marginalizeLandmark<P, 6>;
+    default:
+      return &BlockSolver<Traits>::template marginalizeLandmark<Eigen::Dynamic, Eigen::Dynamic>;
+  }
+}
+
 template <typename Traits>
 bool BlockSolver<Traits>::computeMarginals(SparseBlockMatrix<MatrixXD>& spinv, const std::vector<std::pair<int, int> >& blockIndices)
 {
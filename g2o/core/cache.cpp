@@ -27,20 +27,64 @@
 #include "cache.h"
 #include "optimizable_graph.h"
 #include "factory.h"
+#include "openmp_mutex.h"
 
 #include <iostream>
+#include <map>
+#include <deque>
+#include <vector>
 
 namespace g2o {
   using namespace std;
 
+  namespace {
+    /**
+     * the interned cache type names, the id is the index into names. Keys are
+     * created while the edges are linearized in parallel, hence the table is
+     * guarded by the mutex. The deque keeps the references returned by type()
+     * valid while new names are appended.
+     */
+    struct CacheTypeTable {
+      map<string, int> ids;
+      deque<string> names;
+      OpenMPMutex mutex;
+    };
+
+    CacheTypeTable& cacheTypeTable()
+    {
+      static CacheTypeTable table;
+      return table;
+    }
+  }
+
   Cache::CacheKey::CacheKey() :
-    _type(), _parameters()
+    _typeId(internType(string())), _parameters()
   {
   }
 
   Cache::CacheKey::CacheKey(const std::string& type_, const ParameterVector& parameters_) :
-    _type(type_), _parameters(parameters_)
+    _typeId(internType(type_)), _parameters(parameters_)
+  {
+  }
+
+  int Cache::CacheKey::internType(const std::string& type_)
   {
+    CacheTypeTable& table = cacheTypeTable();
+    ScopedOpenMPMutex lock(&table.mutex);
+    map<string, int>::const_iterator it = table.ids.find(type_);
+    if (it != table.ids.end())
+      return it->second;
+    int id = static_cast<int>(table.names.size());
+    table.ids.insert(make_pair(type_, id));
+    table.names.push_back(type_);
+    return id;
+  }
+
+  const std::string& Cache::CacheKey::type() const
+  {
+    CacheTypeTable& table = cacheTypeTable();
+    ScopedOpenMPMutex lock(&table.mutex);
+    return table.names[_typeId];
   }
 
   Cache::Cache(CacheContainer* container_, const ParameterVector& parameters_) :
@@ -49,8 +93,8 @@ namespace g2o {
   }
 
   bool Cache::CacheKey::operator<(const Cache::CacheKey& c) const{
-    if (_type < c._type)
-      return true;
+    if (_typeId != c._typeId)
+      return _typeId < c._typeId;
     return std::lexicographical_compare (_parameters.begin( ), _parameters.end( ),
            c._parameters.begin( ), c._parameters.end( ) );
   }
@@ -83,13 +127,22 @@ namespace g2o {
 
   
   void Cache::update(){
-    if (! _updateNeeded)
+    if (! _updateNeeded.load(std::memory_order_acquire))
       return;
     for(std::vector<Cache*>::iterator it=_parentCaches.begin(); it!=_parentCaches.end(); it++){
       (*it)->update();
     }
     updateImpl();
-    _updateNeeded=false;
+    _updateNeeded.store(false, std::memory_order_release);
+  }
+
+  void Cache::lazyUpdate(){
+    if (! _container) {
+      update();
+      return;
+    }
+    ScopedOpenMPMutex lock(&_container->_updateMutex);
+    update(); // does nothing if another thread updated the cache in the meantime
   }
 
   Cache* Cache::installDependency(const std::string& type_, const std::vector<int>& parameterIndices){
@@ -117,6 +170,7 @@ namespace g2o {
 
   CacheContainer::CacheContainer(OptimizableGraph::Vertex* vertex_) {
     _vertex = vertex_;
+    _updateNeeded = false;
   }
 
   Cache* CacheContainer::findCache(const Cache::CacheKey& key) {
@@ -170,7 +224,7 @@ namespace g2o {
   void CacheContainer::setUpdateNeeded(bool needUpdate) {
     _updateNeeded=needUpdate;
     for (iterator it=begin(); it!=end(); ++it){
-      (it->second)->_updateNeeded = needUpdate;
+      (it->second)->_updateNeeded.store(needUpdate, std::memory_order_release);
     }
   }
 
@@ -27,19 +27,36 @@
 #ifndef G2O_CACHE_HH_
 #define G2O_CACHE_HH_
 
+#include <atomic>
 #include <map>
 
 #include "optimizable_graph.h"
+#include "openmp_mutex.h"
 #include "g2o_core_api.h"
 
 namespace g2o {
 
   class CacheContainer;
   
+  /**
+   * \brief cache of values derived from the estimate of a vertex
+   *
+   * Caches are recomputed lazily on their first access after the estimate
+   * changed, not eagerly when the estimate changes. Each accessor of a
+   * derived cache, including caches defined outside of g2o, has to call
+   * ensureUpdated() before returning a value that depends on the estimate.
+   * Otherwise it returns the value of the previous estimate.
+   */
   class G2O_CORE_API Cache: public HyperGraph::HyperGraphElement
   {
     public:
       friend class CacheContainer;
+      /**
+       * \brief key of a cache within the CacheContainer of a vertex
+       *
+       * The type name is interned into an integer id on construction, hence
+       * comparing two keys only compares integers and parameter pointers.
+       */
       class G2O_CORE_API CacheKey
       {
         public:
@@ -49,11 +66,15 @@ namespace g2o {
 
           bool operator<(const CacheKey& c) const;
 
-          const std::string& type() const { return _type;}
+          const std::string& type() const;
+          int typeId() const { return _typeId;}
           const ParameterVector& parameters() const { return _parameters;}
 
+          //! returns the id of the cache type name, assigning a new one on the first call
+          static int internType(const std::string& type_);
+
         protected:
-          std::string _type;
+          int _typeId;
           ParameterVector _parameters;
       };
 
@@ -66,7 +87,10 @@ namespace g2o {
       CacheContainer* container();
       ParameterVector& parameters();
 
+      //! recomputes the cache, and the caches it depends on, if the vertex changed since the last update
       void update();
+      //! true, if the estimate of the vertex changed since the last update()
+      bool updateNeeded() const { return _updateNeeded.load(std::memory_order_acquire);}
 
       virtual HyperGraph::HyperGraphElementType elementType() const { return HyperGraph::HGET_CACHE;}
 
@@ -74,6 +98,23 @@ namespace g2o {
       //! redefine this to do the update
       virtual void updateImpl() = 0;
 
+      /**
+       * Caches are updated lazily: changing the estimate of the vertex only
+       * marks its caches as outdated. Derived caches call this in each
+       * accessor returning a value that depends on the estimate, the first
+       * access recomputes the cache. updateImpl() itself has to use the
+       * members, not the accessors, which would recurse. The flag is cleared
+       * with release semantics after updateImpl(), hence a thread seeing it
+       * cleared also sees the recomputed members.
+       */
+      void ensureUpdated() const
+      {
+        if (_updateNeeded.load(std::memory_order_acquire))
+          const_cast<Cache*>(this)->lazyUpdate();
+      }
+      //! update() guarded by the mutex of the container, edges may access the cache concurrently
+      void lazyUpdate();
+
       /**
        * this function installs and satisfies a cache
        * @param type_: the typename of the dependency
@@ -95,7 +136,7 @@ namespace g2o {
        */
       virtual bool resolveDependancies();
 
-      bool _updateNeeded;
+      std::atomic<bool> _updateNeeded;
       ParameterVector _parameters;
       std::vector<Cache*> _parentCaches;
       CacheContainer* _container;
@@ -104,6 +145,7 @@ namespace g2o {
   class G2O_CORE_API CacheContainer: public std::map<Cache::CacheKey, Cache*>
   {
     public:
+      friend class Cache;
       CacheContainer(OptimizableGraph::Vertex* vertex_);
       virtual ~CacheContainer();
       OptimizableGraph::Vertex* vertex();
@@ -111,10 +153,12 @@ namespace g2o {
       Cache* findCache(const Cache::CacheKey& key);
       Cache* createCache(const Cache::CacheKey& key);
       void setUpdateNeeded(bool needUpdate=true);
+      //! updates all outdated caches
       void update();
     protected:
       OptimizableGraph::Vertex* _vertex;
       bool _updateNeeded;
+      OpenMPMutex _updateMutex;
   };
 
 
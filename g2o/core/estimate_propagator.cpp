@@ -48,6 +48,16 @@ namespace g2o {
   };
 # endif
 
+  //! root of i in the union-find forest c, compresses the path on the way
+  static int componentRoot(std::vector<int>& c, int i)
+  {
+    while (c[i] != i) {
+      c[i] = c[c[i]];
+      i = c[i];
+    }
+    return i;
+  }
+
   EstimatePropagator::AdjacencyMapEntry::AdjacencyMapEntry()
   {
     reset();
@@ -60,29 +70,63 @@ namespace g2o {
     _edge = 0;
     _distance = numeric_limits<double>::max();
     _frontierLevel = -1;
-    inQueue = false;
+    _heapIndex = -1;
+    _heapSequence = 0;
   }
 
   EstimatePropagator::EstimatePropagator(OptimizableGraph* g): _graph(g)
   {
-    for (OptimizableGraph::VertexIDMap::const_iterator it=_graph->vertices().begin(); it!=_graph->vertices().end(); ++it){
-      AdjacencyMapEntry entry;
-      entry._child = static_cast<OptimizableGraph::Vertex*>(it->second);
-      _adjacencyMap.insert(make_pair(entry.child(), entry));
-    }
+    initEntries();
+  }
+
+  void EstimatePropagator::initEntries()
+  {
+    const std::vector<HyperGraph::Vertex*>& vertices = _graph->adjacency().vertices();
+    _adjacencyMap.clear();
+    _adjacencyMap.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+      _adjacencyMap[i]._child = static_cast<OptimizableGraph::Vertex*>(vertices[i]);
+    _visited.clear();
+  }
+
+  EstimatePropagator::AdjacencyMapEntry* EstimatePropagator::entry(OptimizableGraph::Vertex* v)
+  {
+    int idx = v->adjacencyIndex();
+    if (idx < 0 || idx >= static_cast<int>(_adjacencyMap.size()) || _adjacencyMap[idx]._child != v)
+      return 0;
+    return &_adjacencyMap[idx];
   }
 
   void EstimatePropagator::reset()
   {
     for (OptimizableGraph::VertexSet::iterator it=_visited.begin(); it!=_visited.end(); ++it){
-      OptimizableGraph::Vertex* v = static_cast<OptimizableGraph::Vertex*>(*it);
-      AdjacencyMap::iterator at = _adjacencyMap.find(v);
-      assert(at != _adjacencyMap.end());
-      at->second.reset();
+      AdjacencyMapEntry* e = entry(static_cast<OptimizableGraph::Vertex*>(*it));
+      assert(e);
+      e->reset();
+      e->_child = static_cast<OptimizableGraph::Vertex*>(*it);
     }
     _visited.clear();
   }
 
+  void EstimatePropagator::prepare(const OptimizableGraph::VertexSet& vset)
+  {
+    // the adjacency indices change if the graph was modified after creating the entries
+    bool entriesValid = _adjacencyMap.size() == _graph->adjacency().vertices().size();
+    for (OptimizableGraph::VertexSet::const_iterator it=vset.begin(); entriesValid && it!=vset.end(); ++it)
+      entriesValid = entry(static_cast<OptimizableGraph::Vertex*>(*it)) != 0;
+    if (entriesValid)
+      reset();
+    else
+      initEntries();
+  }
+
+  void EstimatePropagator::insertVisited(std::vector<OptimizableGraph::Vertex*>& visited)
+  {
+    // a vertex may be expanded again if a cheaper path is found later on
+    sort(visited.begin(), visited.end());
+    _visited.insert(visited.begin(), unique(visited.begin(), visited.end()));
+  }
+
   void EstimatePropagator::propagate(OptimizableGraph::Vertex* v, 
       const EstimatePropagator::PropagateCost& cost, 
        const EstimatePropagator::PropagateAction& action,
@@ -100,33 +144,130 @@ namespace g2o {
        double maxDistance, 
        double maxEdgeCost)
   {
-    reset();
+    prepare(vset);
+    std::vector<OptimizableGraph::Vertex*> visited;
+    propagateFrom(vset, cost, action, maxDistance, maxEdgeCost, visited);
+    insertVisited(visited);
+
+    // writing debug information like cost for reaching each vertex and the parent used to initialize
+#ifdef DEBUG_ESTIMATE_PROPAGATOR
+    cerr << "Writing cost.dat" << endl;
+    ofstream costStream("cost.dat");
+    for (AdjacencyMap::const_iterator it = _adjacencyMap.begin(); it != _adjacencyMap.end(); ++it) {
+      HyperGraph::Vertex* u = it->child();
+      costStream << "vertex " << u->id() << "  cost " << it->_distance << endl;
+    }
+    cerr << "Writing init.dat" << endl;
+    ofstream initStream("init.dat");
+    vector<AdjacencyMapEntry*> frontierLevels;
+    for (AdjacencyMap::iterator it = _adjacencyMap.begin(); it != _adjacencyMap.end(); ++it) {
+      if (it->_frontierLevel > 0)
+        frontierLevels.push_back(&*it);
+    }
+    sort(frontierLevels.begin(), frontierLevels.end(), FrontierLevelCmp());
+    for (vector<AdjacencyMapEntry*>::const_iterator it = frontierLevels.begin(); it != frontierLevels.end(); ++it) {
+      AdjacencyMapEntry* entry       = *it;
+      OptimizableGraph::Vertex* to   = entry->child();
+
+      initStream << "calling init level = " << entry->_frontierLevel << "\t (";
+      for (OptimizableGraph::VertexSet::iterator pit = entry->parent().begin(); pit != entry->parent().end(); ++pit) {
+        initStream << " " << (*pit)->id();
+      }
+      initStream << " ) -> " << to->id() << endl;
+    }
+#endif
+
+  }
+
+  void EstimatePropagator::propagateComponents(OptimizableGraph::VertexSet& vset,
+      const EstimatePropagator::PropagateCost& cost,
+      const EstimatePropagator::PropagateAction& action,
+      double maxDistance,
+      double maxEdgeCost)
+  {
+    prepare(vset);
+    const HyperGraph::Adjacency& adjacency = _graph->adjacency();
+    const std::vector<HyperGraph::Vertex*>& vertices = adjacency.vertices();
+
+    // union-find over the adjacency indices to label the connected components
+    std::vector<int> component(vertices.size());
+    for (size_t i = 0; i < component.size(); ++i)
+      component[i] = static_cast<int>(i);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      HyperGraph::Adjacency::EdgeRange edges = adjacency.edges(vertices[i]);
+      for (HyperGraph::Adjacency::const_iterator et = edges.begin(); et != edges.end(); ++et) {
+        const std::vector<HyperGraph::Vertex*>& ev = (*et)->vertices();
+        for (size_t k = 0; k < ev.size(); ++k) {
+          if (! ev[k] || ev[k]->adjacencyIndex() < 0)
+            continue;
+          int a = componentRoot(component, static_cast<int>(i));
+          int b = componentRoot(component, ev[k]->adjacencyIndex());
+          if (a != b)
+            component[(max)(a, b)] = (min)(a, b);
+        }
+      }
+    }
+
+    // group the start vertices by their component
+    std::vector<int> seedComponent(vertices.size(), -1);
+    std::vector<OptimizableGraph::VertexSet> seeds;
+    for (OptimizableGraph::VertexSet::iterator vit = vset.begin(); vit != vset.end(); ++vit) {
+      int idx = (*vit)->adjacencyIndex();
+      assert(idx >= 0 && "start vertex is not part of the graph");
+      int root = componentRoot(component, idx);
+      if (seedComponent[root] < 0) {
+        seedComponent[root] = static_cast<int>(seeds.size());
+        seeds.push_back(OptimizableGraph::VertexSet());
+      }
+      seeds[seedComponent[root]].insert(*vit);
+    }
+
+    std::vector< std::vector<OptimizableGraph::Vertex*> > visited(seeds.size());
+    int numSeeds = static_cast<int>(seeds.size());
+#   ifdef G2O_OPENMP
+#   pragma omp parallel for default (shared) schedule(dynamic, 1) if (numSeeds > 1)
+#   endif
+    for (int i = 0; i < numSeeds; ++i)
+      propagateFrom(seeds[i], cost, action, maxDistance, maxEdgeCost, visited[i]);
+
+    for (size_t i = 0; i < visited.size(); ++i)
+      insertVisited(visited[i]);
+  }
+
+  void EstimatePropagator::propagateFrom(const OptimizableGraph::VertexSet& vset,
+      const EstimatePropagator::PropagateCost& cost,
+      const EstimatePropagator::PropagateAction& action,
+      double maxDistance, double maxEdgeCost,
+      std::vector<OptimizableGraph::Vertex*>& visited)
+  {
+    const HyperGraph::Adjacency& adjacency = _graph->adjacency();
 
     PriorityQueue frontier;
-    for (OptimizableGraph::VertexSet::iterator vit=vset.begin(); vit!=vset.end(); ++vit){
+    for (OptimizableGraph::VertexSet::const_iterator vit=vset.begin(); vit!=vset.end(); ++vit){
       OptimizableGraph::Vertex* v = static_cast<OptimizableGraph::Vertex*>(*vit);
-      AdjacencyMap::iterator it = _adjacencyMap.find(v);
-      assert(it != _adjacencyMap.end());
-      it->second._distance = 0.;
-      it->second._parent.clear();
-      it->second._frontierLevel = 0;
-      frontier.push(&it->second);
+      AdjacencyMapEntry* ve = entry(v);
+      assert(ve);
+      ve->_distance = 0.;
+      ve->_parent.clear();
+      ve->_frontierLevel = 0;
+      frontier.push(ve);
     }
 
     while(! frontier.empty()){
-      AdjacencyMapEntry* entry = frontier.pop();
-      OptimizableGraph::Vertex* u = entry->child();
-      double uDistance = entry->distance();
+      AdjacencyMapEntry* ue = frontier.pop();
+      OptimizableGraph::Vertex* u = ue->child();
+      double uDistance = ue->distance();
       //cerr << "uDistance " << uDistance << endl;
 
       // initialize the vertex
-      if (entry->_frontierLevel > 0) {
-        action(entry->edge(), entry->parent(), u);
+      if (ue->_frontierLevel > 0) {
+        action(ue->edge(), ue->parent(), u);
       }
 
-      /* std::pair< OptimizableGraph::VertexSet::iterator, bool> insertResult = */ _visited.insert(u);
-      OptimizableGraph::EdgeSet::iterator et = u->edges().begin();
-      while (et != u->edges().end()){
+      visited.push_back(u);
+      HyperGraph::Adjacency::EdgeRange uEdges = adjacency.edges(u);
+      HyperGraph::Adjacency::const_iterator et = uEdges.begin();
+      while (et != uEdges.end()){
         OptimizableGraph::Edge* edge = static_cast<OptimizableGraph::Edge*>(*et);
         ++et;
 
@@ -136,10 +277,10 @@ namespace g2o {
           OptimizableGraph::Vertex* z = static_cast<OptimizableGraph::Vertex*>(edge->vertex(i));
 	  if (! z)
 	    continue;
-          AdjacencyMap::iterator ot = _adjacencyMap.find(z);
-          if (ot->second._distance != numeric_limits<double>::max()) {
+          AdjacencyMapEntry* ze = entry(z);
+          if (ze->_distance != numeric_limits<double>::max()) {
             initializedVertices.insert(z);
-            maxFrontier = (max)(maxFrontier, ot->second._frontierLevel);
+            maxFrontier = (max)(maxFrontier, ze->_frontierLevel);
           }
         }
         assert(maxFrontier >= 0);
@@ -157,17 +298,15 @@ namespace g2o {
             double zDistance = uDistance + edgeDistance;
             //cerr << z->id() << " " << zDistance << endl;
 
-            AdjacencyMap::iterator ot = _adjacencyMap.find(z);
-            assert(ot!=_adjacencyMap.end());
-
-            if (zDistance < ot->second.distance() && zDistance < maxDistance){
-              //if (ot->second.inQueue)
-                //cerr << "Updating" << endl;
-              ot->second._distance = zDistance;
-              ot->second._parent = initializedVertices;
-              ot->second._edge = edge;
-              ot->second._frontierLevel = maxFrontier + 1;
-              frontier.push(&ot->second);
+            AdjacencyMapEntry* ze = entry(z);
+            assert(ze);
+
+            if (zDistance < ze->distance() && zDistance < maxDistance){
+              ze->_distance = zDistance;
+              ze->_parent = initializedVertices;
+              ze->_edge = edge;
+              ze->_frontierLevel = maxFrontier + 1;
+              frontier.push(ze);
             }
           }
 
@@ -177,61 +316,6 @@ namespace g2o {
         }
       }
     }
-
-    // writing debug information like cost for reaching each vertex and the parent used to initialize
-#ifdef DEBUG_ESTIMATE_PROPAGATOR
-    cerr << "Writing cost.dat" << endl;
-    ofstream costStream("cost.dat");
-    for (AdjacencyMap::const_iterator it = _adjacencyMap.begin(); it != _adjacencyMap.end(); ++it) {
-      HyperGraph::Vertex* u = it->second.child();
-      costStream << "vertex " << u->id() << "  cost " << it->second._distance << endl;
-    }
-    cerr << "Writing init.dat" << endl;
-    ofstream initStream("init.dat");
-    vector<AdjacencyMapEntry*> frontierLevels;
-    for (AdjacencyMap::iterator it = _adjacencyMap.begin(); it != _adjacencyMap.end(); ++it) {
-      if (it->second._frontierLevel > 0)
-        frontierLevels.push_back(&it->second);
-    }
-    sort(frontierLevels.begin(), frontierLevels.end(), FrontierLevelCmp());
-    for (vector<AdjacencyMapEntry*>::const_iterator it = frontierLevels.begin(); it != frontierLevels.end(); ++it) {
-      AdjacencyMapEntry* entry       = *it;
-      OptimizableGraph::Vertex* to   = entry->child();
-
-      initStream << "calling init level = " << entry->_frontierLevel << "\t (";
-      for (OptimizableGraph::VertexSet::iterator pit = entry->parent().begin(); pit != entry->parent().end(); ++pit) {
-        initStream << " " << (*pit)->id();
-      }
-      initStream << " ) -> " << to->id() << endl;
-    }
-#endif
-
-  }
-
-  void EstimatePropagator::PriorityQueue::push(AdjacencyMapEntry* entry)
-  {
-    assert(entry != NULL);
-    if (entry->inQueue) {
-      assert(entry->queueIt->second == entry);
-      erase(entry->queueIt);
-    }
-
-    entry->queueIt = insert(std::make_pair(entry->distance(), entry));
-    assert(entry->queueIt != end());
-    entry->inQueue = true;
-  }
-
-  EstimatePropagator::AdjacencyMapEntry* EstimatePropagator::PriorityQueue::pop()
-  {
-    assert(!empty());
-    iterator it = begin();
-    AdjacencyMapEntry* entry = it->second;
-    erase(it);
-
-    assert(entry != NULL);
-    entry->queueIt = end();
-    entry->inQueue = false;
-    return entry;
   }
 
   EstimatePropagatorCost::EstimatePropagatorCost (SparseOptimizer* graph) :
@@ -30,10 +30,12 @@
 #include "optimizable_graph.h"
 #include "sparse_optimizer.h"
 #include "g2o_core_api.h"
+#include "indexed_heap.h"
 
 #include <map>
 #include <set>
 #include <limits>
+#include <vector>
 
 #include <unordered_map>
 
@@ -92,11 +94,7 @@ namespace g2o {
       /**
        * \brief priority queue for AdjacencyMapEntry
        */
-      class PriorityQueue : public std::multimap<double, AdjacencyMapEntry*> {
-        public:
-          void push(AdjacencyMapEntry* entry);
-          AdjacencyMapEntry* pop();
-      };
+      typedef IndexedBinaryHeap<AdjacencyMapEntry> PriorityQueue;
 
       /**
        * \brief data structure for loopuk during Dijkstra
@@ -104,7 +102,7 @@ namespace g2o {
       class AdjacencyMapEntry {
         public:
           friend class EstimatePropagator;
-          friend class PriorityQueue;
+          template <typename> friend class IndexedBinaryHeap;
           AdjacencyMapEntry();
           void reset();
           OptimizableGraph::Vertex* child() const {return _child;}
@@ -120,8 +118,8 @@ namespace g2o {
           double _distance;
           int _frontierLevel;
         private: // for PriorityQueue
-          bool inQueue;
-          PriorityQueue::iterator queueIt;
+          int _heapIndex;
+          size_t _heapSequence;
       };
 
       /**
@@ -132,7 +130,8 @@ namespace g2o {
           size_t operator ()(const OptimizableGraph::Vertex* v) const { return v->id();}
       };
 
-      typedef std::unordered_map<OptimizableGraph::Vertex*, AdjacencyMapEntry, VertexIDHashFunction> AdjacencyMap;
+      //! one entry per vertex of the graph, indexed by HyperGraph::Vertex::adjacencyIndex()
+      typedef std::vector<AdjacencyMapEntry> AdjacencyMap;
 
     public:
       EstimatePropagator(OptimizableGraph* g);
@@ -160,8 +159,34 @@ namespace g2o {
           double maxDistance=std::numeric_limits<double>::max(), 
           double maxEdgeCost=std::numeric_limits<double>::max());
 
+      /**
+       * same as above, but the start vertices are first split according to the
+       * connected components of the graph. Each component is propagated
+       * independently and, if compiled with OpenMP, in parallel. Hence, cost and
+       * action have to be safe to call concurrently for vertices of
+       * different components. The result equals the one of propagate(vset, ...).
+       */
+      void propagateComponents(OptimizableGraph::VertexSet& vset,
+          const EstimatePropagator::PropagateCost& cost,
+          const EstimatePropagator::PropagateAction& action = PropagateAction(),
+          double maxDistance=std::numeric_limits<double>::max(),
+          double maxEdgeCost=std::numeric_limits<double>::max());
+
     protected:
       void reset();
+      //! (re-)creates one entry per vertex of the current adjacency of the graph
+      void initEntries();
+      //! resets the entries before propagating from vset, re-creates them if the graph changed
+      void prepare(const OptimizableGraph::VertexSet& vset);
+      //! the entry of v, 0 if v is not part of the graph
+      AdjacencyMapEntry* entry(OptimizableGraph::Vertex* v);
+      //! Dijkstra from vset, appends the vertices it expands to visited
+      void propagateFrom(const OptimizableGraph::VertexSet& vset,
+          const EstimatePropagator::PropagateCost& cost,
+          const EstimatePropagator::PropagateAction& action,
+          double maxDistance, double maxEdgeCost,
+          std::vector<OptimizableGraph::Vertex*>& visited);
+      void insertVisited(std::vector<OptimizableGraph::Vertex*>& visited);
 
       AdjacencyMap _adjacencyMap;
       OptimizableGraph::VertexSet _visited;
@@ -56,6 +56,8 @@ Factory::~Factory()
   }
   _creator.clear();
   _tagLookup.clear();
+  _creatorById.clear();
+  _typeInfoLookup.clear();
 }
 
 Factory* Factory::instance()
@@ -85,6 +87,8 @@ void Factory::registerType(const std::string& tag, AbstractHyperGraphElementCrea
 
   CreatorInformation* ci = new CreatorInformation();
   ci->creator = c;
+  ci->tag = tag;
+  ci->typeId = static_cast<int>(_creatorById.size());
 
 #ifdef G2O_DEBUG_FACTORY
   cerr << "# Factory " << (void*)this << " constructing type " << tag << " ";
@@ -122,6 +126,7 @@ void Factory::registerType(const std::string& tag, AbstractHyperGraphElementCrea
 
   _creator[tag] = ci;
   _tagLookup[c->name()] = tag;
+  _creatorById.push_back(ci);
   delete element;
 }
 
@@ -140,6 +145,15 @@ void Factory::registerType(const std::string& tag, AbstractHyperGraphElementCrea
         {
           _tagLookup.erase(classPosition);
         }
+      int typeId = tagPosition->second->typeId;
+      _creatorById[typeId] = 0;
+      ScopedOpenMPMutex lock(&_typeInfoMutex);
+      for (TypeInfoLookup::iterator it = _typeInfoLookup.begin(); it != _typeInfoLookup.end();) {
+        if (it->second == typeId)
+          it = _typeInfoLookup.erase(it);
+        else
+          ++it;
+      }
       _creator.erase(tagPosition);
     }
   }
@@ -156,11 +170,67 @@ HyperGraph::HyperGraphElement* Factory::construct(const std::string& tag) const
 
 const std::string& Factory::tag(const HyperGraph::HyperGraphElement* e) const
 {
-  static std::string emptyStr("");
-  TagLookup::const_iterator foundIt = _tagLookup.find(typeid(*e).name());
-  if (foundIt != _tagLookup.end())
+  return tag(typeId(e));
+}
+
+int Factory::typeId(const std::string& tag) const
+{
+  CreatorMap::const_iterator foundIt = _creator.find(tag);
+  if (foundIt == _creator.end())
+    return -1;
+  return foundIt->second->typeId;
+}
+
+int Factory::typeId(const HyperGraph::HyperGraphElement* e) const
+{
+  const std::type_info* ti = &typeid(*e);
+  ScopedOpenMPMutex lock(&_typeInfoMutex);
+  TypeInfoLookup::const_iterator foundIt = _typeInfoLookup.find(ti);
+  if (foundIt != _typeInfoLookup.end())
     return foundIt->second;
-  return emptyStr;
+
+  // the first element of this class, resolve the tag by the class name.
+  // The name is required, as type_info objects are not unique across shared libraries.
+  // Unknown classes are not cached, they may be registered later on.
+  TagLookup::const_iterator tagIt = _tagLookup.find(ti->name());
+  if (tagIt == _tagLookup.end())
+    return -1;
+  int id = typeId(tagIt->second);
+  _typeInfoLookup.insert(make_pair(ti, id));
+  return id;
+}
+
+const std::string& Factory::tag(int typeId) const
+{
+  static std::string emptyStr("");
+  const CreatorInformation* ci = creatorInformation(typeId);
+  return ci ? ci->tag : emptyStr;
+}
+
+int Factory::elementType(int typeId) const
+{
+  const CreatorInformation* ci = creatorInformation(typeId);
+  return ci ? ci->elementTypeBit : -1;
+}
+
+HyperGraph::HyperGraphElement* Factory::construct(int typeId) const
+{
+  const CreatorInformation* ci = creatorInformation(typeId);
+  if (ci)
+    return ci->creator->construct();
+  return 0;
+}
+
+HyperGraph::HyperGraphElement* Factory::construct(int typeId, const HyperGraph::GraphElemBitset& elemsToConstruct) const
+{
+  if (elemsToConstruct.none()) {
+    return construct(typeId);
+  }
+  const CreatorInformation* ci = creatorInformation(typeId);
+  if (ci && ci->elementTypeBit >= 0 && elemsToConstruct.test(ci->elementTypeBit)) {
+    return ci->creator->construct();
+  }
+  return 0;
 }
 
 void Factory::fillKnownTypes(std::vector<std::string>& types) const
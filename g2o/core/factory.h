@@ -31,10 +31,14 @@
 #include "g2o/stuff/misc.h"
 #include "hyper_graph.h"
 #include "creators.h"
+#include "openmp_mutex.h"
 
 #include <string>
 #include <map>
+#include <vector>
 #include <iostream>
+#include <typeinfo>
+#include <unordered_map>
 
 // define to get some verbose output
 //#define G2O_DEBUG_FACTORY
@@ -57,7 +61,8 @@ namespace g2o {
       static void destroy();
 
       /**
-       * register a tag for a specific creator
+       * register a tag for a specific creator. The type is assigned the next
+       * free integer type id, see typeId().
        */
       void registerType(const std::string& tag, AbstractHyperGraphElementCreator* c);
 
@@ -85,6 +90,33 @@ namespace g2o {
       //! return the TAG given a vertex
       const std::string& tag(const HyperGraph::HyperGraphElement* v) const;
 
+      /**
+       * return the integer id of a registered tag, or -1 if the tag is unknown.
+       * The ids are handed out in the order of registration and do not change
+       * while the type stays registered. They are not stable between runs,
+       * files store the tags instead.
+       */
+      int typeId(const std::string& tag) const;
+
+      /**
+       * return the integer type id of the element, or -1 if its class is not
+       * registered. After the first call for a class this is a hash look-up on
+       * the address of its std::type_info.
+       */
+      int typeId(const HyperGraph::HyperGraphElement* e) const;
+
+      //! return the TAG of a type id, an empty string if the id is not registered
+      const std::string& tag(int typeId) const;
+
+      //! return the HyperGraph::HyperGraphElementType of a type id, -1 if the id is not registered
+      int elementType(int typeId) const;
+
+      //! construct a graph element based on its type id
+      HyperGraph::HyperGraphElement* construct(int typeId) const;
+
+      //! construct a graph element based on its type id, if its type matches the bitmask, see above
+      HyperGraph::HyperGraphElement* construct(int typeId, const HyperGraph::GraphElemBitset& elemsToConstruct) const;
+
       /**
        * get a list of all known types
        */
@@ -101,10 +133,13 @@ namespace g2o {
         public:
           AbstractHyperGraphElementCreator* creator;
           int elementTypeBit;
+          int typeId;
+          std::string tag;
           CreatorInformation()
           {
             creator = 0;
             elementTypeBit = -1;
+            typeId = -1;
           }
         
           ~CreatorInformation()
@@ -117,11 +152,22 @@ namespace g2o {
 
       typedef std::map<std::string, CreatorInformation*>               CreatorMap;
       typedef std::map<std::string, std::string>                      TagLookup;
+      typedef std::unordered_map<const std::type_info*, int>           TypeInfoLookup;
       Factory();
       ~Factory();
 
+      const CreatorInformation* creatorInformation(int typeId) const
+      {
+        if (typeId < 0 || typeId >= static_cast<int>(_creatorById.size()))
+          return 0;
+        return _creatorById[typeId];
+      }
+
       CreatorMap _creator;     ///< look-up map for the existing creators
       TagLookup _tagLookup;    ///< reverse look-up, class name to tag
+      std::vector<CreatorInformation*> _creatorById; ///< creators indexed by type id, 0 if unregistered
+      mutable TypeInfoLookup _typeInfoLookup;        ///< type_info address to type id of registered classes, filled on demand by typeId()
+      mutable OpenMPMutex _typeInfoMutex;            ///< guards _typeInfoLookup, typeId() may be called concurrently
 
     private:
       static Factory* factoryInstance;
@@ -29,6 +29,7 @@
 #include <vector>
 #include <assert.h>
 #include <iostream>
+#include <algorithm>
 #include "hyper_dijkstra.h"
 #include "g2o/stuff/macros.h"
 
@@ -56,67 +57,80 @@ namespace g2o{
     _parent=parent_;
     _edge=edge_;
     _distance=distance_;
+    _heapIndex=-1;
+    _heapSequence=0;
   }
 
   HyperDijkstra::HyperDijkstra(HyperGraph* g): _graph(g)
   {
-    for (HyperGraph::VertexIDMap::const_iterator it=_graph->vertices().begin(); it!=_graph->vertices().end(); it++){
-      AdjacencyMapEntry entry(it->second, 0,0,std::numeric_limits< double >::max());
-      _adjacencyMap.insert(make_pair(entry.child(), entry));
-    }
+    initEntries();
   }
 
-  void HyperDijkstra::reset()
+  void HyperDijkstra::initEntries()
   {
-    for (HyperGraph::VertexSet::iterator it=_visited.begin(); it!=_visited.end(); it++){
-      AdjacencyMap::iterator at=_adjacencyMap.find(*it);
-      assert(at!=_adjacencyMap.end());
-      at->second=AdjacencyMapEntry(at->first,0,0,std::numeric_limits< double >::max());
-    }
+    const std::vector<HyperGraph::Vertex*>& vertices = _graph->adjacency().vertices();
+    _adjacencyMap.clear();
+    _adjacencyMap.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+      _adjacencyMap.push_back(AdjacencyMapEntry(vertices[i], 0, 0, std::numeric_limits< double >::max()));
     _visited.clear();
   }
 
+  HyperDijkstra::AdjacencyMapEntry* HyperDijkstra::entry(AdjacencyMap& amap, HyperGraph::Vertex* v)
+  {
+    int idx = v->adjacencyIndex();
+    if (idx < 0 || idx >= static_cast<int>(amap.size()) || amap[idx]._child != v)
+      return 0;
+    return &amap[idx];
+  }
 
-  bool operator<(const HyperDijkstra::AdjacencyMapEntry& a, const HyperDijkstra::AdjacencyMapEntry& b)
+  void HyperDijkstra::reset()
   {
-    return a.distance()>b.distance();
+    for (HyperGraph::VertexSet::iterator it=_visited.begin(); it!=_visited.end(); it++){
+      AdjacencyMapEntry* e = entry(*it);
+      assert(e);
+      *e=AdjacencyMapEntry(*it,0,0,std::numeric_limits< double >::max());
+    }
+    _visited.clear();
   }
 
 
   void HyperDijkstra::shortestPaths(HyperGraph::VertexSet& vset, HyperDijkstra::CostFunction* cost, 
       double maxDistance, double comparisonConditioner, bool directed, double maxEdgeCost)
   {
-    reset();
-    std::priority_queue< AdjacencyMapEntry > frontier;
+    const HyperGraph::Adjacency& adjacency = _graph->adjacency();
+    // the adjacency indices change if the graph was modified after creating the entries
+    bool entriesValid = _adjacencyMap.size() == adjacency.vertices().size();
+    for (HyperGraph::VertexSet::iterator vit=vset.begin(); entriesValid && vit!=vset.end(); ++vit)
+      entriesValid = entry(*vit) != 0;
+    if (entriesValid)
+      reset();
+    else
+      initEntries();
+    IndexedBinaryHeap<AdjacencyMapEntry> frontier;
+    std::vector<HyperGraph::Vertex*> visited;
     for (HyperGraph::VertexSet::iterator vit=vset.begin(); vit!=vset.end(); ++vit){
       HyperGraph::Vertex* v=*vit;
       assert(v!=0);
-      AdjacencyMap::iterator it=_adjacencyMap.find(v);
-      if (it == _adjacencyMap.end()) {
+      AdjacencyMapEntry* ve=entry(v);
+      if (! ve) {
         cerr << __PRETTY_FUNCTION__ << "Vertex " << v->id() << " is not in the adjacency map" << endl;
       }
-      assert(it!=_adjacencyMap.end());
-      it->second._distance=0.;
-      it->second._parent=0;
-      frontier.push(it->second);
+      assert(ve);
+      ve->_distance=0.;
+      ve->_parent=0;
+      frontier.push(ve);
     }
 
     while(! frontier.empty()){
-      AdjacencyMapEntry entry=frontier.top();
-      frontier.pop();
-      HyperGraph::Vertex* u=entry.child();
-      AdjacencyMap::iterator ut=_adjacencyMap.find(u);
-      if (ut == _adjacencyMap.end()) {
-        cerr << __PRETTY_FUNCTION__ << "Vertex " << u->id() << " is not in the adjacency map" << endl;
-      }
-      assert(ut!=_adjacencyMap.end());
-      double uDistance=ut->second.distance();
+      AdjacencyMapEntry* ue=frontier.pop();
+      HyperGraph::Vertex* u=ue->child();
+      double uDistance=ue->distance();
 
-      std::pair< HyperGraph::VertexSet::iterator, bool> insertResult=_visited.insert(u); (void) insertResult;
-      HyperGraph::EdgeSet::iterator et=u->edges().begin();
-      while (et != u->edges().end()){
+      visited.push_back(u);
+      HyperGraph::Adjacency::EdgeRange uEdges=adjacency.edges(u);
+      for (HyperGraph::Adjacency::const_iterator et=uEdges.begin(); et != uEdges.end(); ++et){
         HyperGraph::Edge* edge=*et;
-        ++et;
 
         if (directed && edge->vertex(0) != u)
           continue;
@@ -130,20 +144,23 @@ namespace g2o{
           if (edgeDistance==std::numeric_limits< double >::max() || edgeDistance > maxEdgeCost)
             continue;
           double zDistance=uDistance+edgeDistance;
-          //cerr << z->id() << " " << zDistance << endl;
 
-          AdjacencyMap::iterator ot=_adjacencyMap.find(z);
-          assert(ot!=_adjacencyMap.end());
+          AdjacencyMapEntry* ze=entry(z);
+          assert(ze);
 
-          if (zDistance+comparisonConditioner<ot->second.distance() && zDistance<maxDistance){
-            ot->second._distance=zDistance;
-            ot->second._parent=u;
-            ot->second._edge=edge;
-            frontier.push(ot->second);
+          if (zDistance+comparisonConditioner<ze->distance() && zDistance<maxDistance){
+            ze->_distance=zDistance;
+            ze->_parent=u;
+            ze->_edge=edge;
+            frontier.push(ze);
           }
         }
       }
     }
+
+    // a vertex may be reached again after it was expanded, keep each one once
+    std::sort(visited.begin(), visited.end());
+    _visited.insert(visited.begin(), std::unique(visited.begin(), visited.end()));
   }
 
   void HyperDijkstra::shortestPaths(HyperGraph::Vertex* v, HyperDijkstra::CostFunction* cost, double maxDistance, 
@@ -157,21 +174,20 @@ namespace g2o{
   void HyperDijkstra::computeTree(AdjacencyMap& amap)
   {
     for (AdjacencyMap::iterator it=amap.begin(); it!=amap.end(); ++it){
-      AdjacencyMapEntry& entry(it->second);
+      AdjacencyMapEntry& entry(*it);
       entry._children.clear();
     }
     for (AdjacencyMap::iterator it=amap.begin(); it!=amap.end(); ++it){
-      AdjacencyMapEntry& entry(it->second);
+      AdjacencyMapEntry& entry(*it);
       HyperGraph::Vertex* parent=entry.parent();
       if (!parent){
         continue;
       }
       HyperGraph::Vertex* v=entry.child();
-      assert (v==it->first);
 
-      AdjacencyMap::iterator pt=amap.find(parent);
-      assert(pt!=amap.end());
-      pt->second._children.insert(v);
+      AdjacencyMapEntry* pe=HyperDijkstra::entry(amap, parent);
+      assert(pe);
+      pe->_children.insert(v);
     }
   }
 
@@ -183,10 +199,10 @@ namespace g2o{
     Deque q;
     // scans for the vertices without the parent (whcih are the roots of the trees) and applies the action to them.
     for (AdjacencyMap::iterator it=amap.begin(); it!=amap.end(); ++it){
-      AdjacencyMapEntry& entry(it->second);
+      AdjacencyMapEntry& entry(*it);
       if (! entry.parent()) {
-        action->perform(it->first,0,0);
-        q.push_back(it->first);
+        action->perform(entry.child(),0,0);
+        q.push_back(entry.child());
       }
     }
 
@@ -196,26 +212,25 @@ namespace g2o{
       HyperGraph::Vertex* parent=q.front();
       q.pop_front();
       ++count;
-      AdjacencyMap::iterator parentIt=amap.find(parent);
-      if (parentIt==amap.end()) {
+      AdjacencyMapEntry* parentEntry=entry(amap, parent);
+      if (! parentEntry) {
         continue;
       }
       //cerr << "parent= " << parent << " parent id= " << parent->id() << "\t children id =";
-      HyperGraph::VertexSet& childs(parentIt->second.children());
+      HyperGraph::VertexSet& childs(parentEntry->children());
       for (HyperGraph::VertexSet::iterator childsIt=childs.begin(); childsIt!=childs.end(); ++childsIt){
         HyperGraph::Vertex* child=*childsIt;
         //cerr << child->id();
-        AdjacencyMap::iterator adjacencyIt=amap.find(child);
-        assert (adjacencyIt!=amap.end());
-        HyperGraph::Edge* edge=adjacencyIt->second.edge();  
+        AdjacencyMapEntry* childEntry=entry(amap, child);
+        assert (childEntry);
+        HyperGraph::Edge* edge=childEntry->edge();  
 
-        assert(adjacencyIt->first==child);
-        assert(adjacencyIt->second.child()==child);
-        assert(adjacencyIt->second.parent()==parent);
+        assert(childEntry->child()==child);
+        assert(childEntry->parent()==parent);
         if (! useDistance) {
           action->perform(child, parent, edge);
         } else {
-          action->perform(child, parent, edge, adjacencyIt->second.distance());
+          action->perform(child, parent, edge, childEntry->distance());
         }
         q.push_back(child);
       }
@@ -253,6 +268,42 @@ namespace g2o{
     }
   }
 
+  void HyperDijkstra::connectedComponents(std::vector<HyperGraph::VertexSet>& components,
+      const HyperGraph::VertexSet& vset, HyperDijkstra::CostFunction* cost, double maxEdgeCost)
+  {
+    typedef std::queue<HyperGraph::Vertex*> VertexDeque;
+    components.clear();
+    HyperGraph::VertexSet visited;
+    for (HyperGraph::VertexSet::const_iterator vit=vset.begin(); vit!=vset.end(); ++vit){
+      if (! visited.insert(*vit).second)
+        continue;
+      components.push_back(HyperGraph::VertexSet());
+      HyperGraph::VertexSet& connected = components.back();
+      VertexDeque frontier;
+      connected.insert(*vit);
+      frontier.push(*vit);
+      while (! frontier.empty()){
+        HyperGraph::Vertex* u=frontier.front();
+        frontier.pop();
+        for (HyperGraph::EdgeSet::const_iterator et=u->edges().begin(); et!=u->edges().end(); ++et){
+          HyperGraph::Edge* edge=*et;
+          for (size_t i = 0; i < edge->vertices().size(); ++i) {
+            HyperGraph::Vertex* z = edge->vertex(i);
+            if (z == u || z == 0 || vset.find(z) == vset.end())
+              continue;
+            double edgeDistance=(*cost)(edge, u, z);
+            if (edgeDistance==std::numeric_limits< double >::max() || edgeDistance > maxEdgeCost)
+              continue;
+            if (visited.insert(z).second){
+              connected.insert(z);
+              frontier.push(z);
+            }
+          }
+        }
+      }
+    }
+  }
+
   double UniformCostFunction::operator () (HyperGraph::Edge* /*edge*/, HyperGraph::Vertex* /*from*/, HyperGraph::Vertex* /*to*/)
   {
     return 1.;
@@ -29,9 +29,11 @@
 
 #include <map>
 #include <set>
+#include <vector>
 #include <limits>
 
 #include "hyper_graph.h"
+#include "indexed_heap.h"
 
 namespace g2o{
 
@@ -49,6 +51,7 @@ namespace g2o{
     
     struct G2O_CORE_API AdjacencyMapEntry{
       friend struct HyperDijkstra;
+      template <typename> friend class IndexedBinaryHeap;
       AdjacencyMapEntry(HyperGraph::Vertex* _child=0, 
           HyperGraph::Vertex* _parent=0, 
           HyperGraph::Edge* _edge=0, 
@@ -65,9 +68,13 @@ namespace g2o{
       HyperGraph::Edge* _edge;
       double _distance;
       HyperGraph::VertexSet _children;
+      private: // for IndexedBinaryHeap
+      int _heapIndex;
+      size_t _heapSequence;
     };
 
-    typedef std::map<HyperGraph::Vertex*, AdjacencyMapEntry> AdjacencyMap;
+    //! one entry per vertex of the graph, indexed by HyperGraph::Vertex::adjacencyIndex()
+    typedef std::vector<AdjacencyMapEntry> AdjacencyMap;
     HyperDijkstra(HyperGraph* g);
     HyperGraph::VertexSet& visited() {return _visited; }
     AdjacencyMap& adjacencyMap() {return _adjacencyMap; }
@@ -95,9 +102,22 @@ namespace g2o{
            HyperGraph* g, HyperGraph::Vertex* v,
            HyperDijkstra::CostFunction* cost, double distance, double comparisonConditioner,
            double maxEdgeCost=std::numeric_limits< double >::max() );
+    /**
+     * computes the connected components of the subgraph spanned by the vertices in vset.
+     * An edge connects two vertices if both are in vset and its cost is below maxEdgeCost.
+     * @param components: one vertex set per connected component
+     */
+    static void connectedComponents(std::vector<HyperGraph::VertexSet>& components,
+           const HyperGraph::VertexSet& vset, HyperDijkstra::CostFunction* cost,
+           double maxEdgeCost=std::numeric_limits< double >::max() );
 
   protected:
     void reset();
+    //! (re-)creates one entry per vertex of the current adjacency of the graph
+    void initEntries();
+    //! the entry of v in amap, 0 if v is not part of it
+    static AdjacencyMapEntry* entry(AdjacencyMap& amap, HyperGraph::Vertex* v);
+    AdjacencyMapEntry* entry(HyperGraph::Vertex* v) { return entry(_adjacencyMap, v);}
 
     AdjacencyMap _adjacencyMap;
     HyperGraph::VertexSet _visited;
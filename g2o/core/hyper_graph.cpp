@@ -25,9 +25,11 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hyper_graph.h"
+#include "memory_pool.h"
 
 #include <assert.h>
 #include <queue>
+#include <algorithm>
 
 namespace g2o {
 
@@ -41,7 +43,7 @@ namespace g2o {
       delete _next;
   }
 
-  HyperGraph::Vertex::Vertex(int id) : _id(id)
+  HyperGraph::Vertex::Vertex(int id) : _id(id), _adjacencyIndex(-1)
   {
   }
 
@@ -78,6 +80,14 @@ namespace g2o {
 
   HyperGraph::Vertex* HyperGraph::vertex(int id)
   {
+    if (_denseVertexIds) {
+      size_t idx = static_cast<size_t>(static_cast<long long>(id) - _denseIdOffset);
+      if (idx < _denseVertices.size()) {
+        Vertex* v = _denseVertices[idx];
+        if (v || _numSparseVertices == 0)
+          return v;
+      }
+    }
     VertexIDMap::iterator it=_vertices.find(id);
     if (it==_vertices.end())
       return 0;
@@ -86,6 +96,14 @@ namespace g2o {
 
   const HyperGraph::Vertex* HyperGraph::vertex(int id) const
   {
+    if (_denseVertexIds) {
+      size_t idx = static_cast<size_t>(static_cast<long long>(id) - _denseIdOffset);
+      if (idx < _denseVertices.size()) {
+        const Vertex* v = _denseVertices[idx];
+        if (v || _numSparseVertices == 0)
+          return v;
+      }
+    }
     VertexIDMap::const_iterator it=_vertices.find(id);
     if (it==_vertices.end())
       return 0;
@@ -98,9 +116,76 @@ namespace g2o {
     if (vn)
       return false;
     _vertices.insert( std::make_pair(v->id(),v) );
+    if (_denseVertexIds)
+      insertDenseVertex(v);
+    _adjacencyValid = false;
     return true;
   }
 
+  bool HyperGraph::insertDenseVertex(Vertex* v)
+  {
+    long long id = v->id();
+    if (_denseVertices.empty())
+      _denseIdOffset = id;
+    long long idx = id - _denseIdOffset;
+    long long size = static_cast<long long>(_denseVertices.size());
+    if (idx < 0 || idx >= size) {
+      // only grow the range [min id, max id] of the table if the ids in it stay reasonably
+      // dense, otherwise keep the vertex in the hash map
+      long long newSize = idx < 0 ? size - idx : idx + 1;
+      if (newSize > 2 * static_cast<long long>(_numDenseVertices) + 1024) {
+        ++_numSparseVertices;
+        return false;
+      }
+      if (idx < 0) {
+        // shift the table, leave room for further ids below the new one
+        long long headroom = std::min(std::max(-idx, size), 2 * static_cast<long long>(_numDenseVertices) + 1024 - size);
+        VertexContainer shifted(size + headroom, 0);
+        std::copy(_denseVertices.begin(), _denseVertices.end(), shifted.begin() + headroom);
+        _denseVertices.swap(shifted);
+        _denseIdOffset -= headroom;
+        idx += headroom;
+      } else {
+        if (static_cast<size_t>(newSize) > _denseVertices.capacity())
+          _denseVertices.reserve(std::max(static_cast<size_t>(newSize), 2 * _denseVertices.capacity()));
+        _denseVertices.resize(newSize, 0);
+      }
+    }
+    _denseVertices[idx] = v;
+    ++_numDenseVertices;
+    return true;
+  }
+
+  void HyperGraph::eraseDenseVertex(const Vertex* v)
+  {
+    size_t idx = static_cast<size_t>(static_cast<long long>(v->id()) - _denseIdOffset);
+    if (idx < _denseVertices.size() && _denseVertices[idx] == v) {
+      _denseVertices[idx] = 0;
+      --_numDenseVertices;
+    } else {
+      --_numSparseVertices;
+    }
+  }
+
+  void HyperGraph::setDenseVertexIds(bool denseVertexIds)
+  {
+    _denseVertexIds = denseVertexIds;
+    _denseVertices.clear();
+    _denseIdOffset = 0;
+    _numDenseVertices = 0;
+    _numSparseVertices = 0;
+    if (! _denseVertexIds)
+      return;
+    // insert in increasing order of the ids to let the table grow over dense ids
+    std::vector<int> ids;
+    ids.reserve(_vertices.size());
+    for (VertexIDMap::const_iterator it=_vertices.begin(); it!=_vertices.end(); ++it)
+      ids.push_back(it->first);
+    std::sort(ids.begin(), ids.end());
+    for (size_t i = 0; i < ids.size(); ++i)
+      insertDenseVertex(_vertices[ids[i]]);
+  }
+
   /**
    * changes the id of a vertex already in the graph, and updates the bookkeeping
    @ returns false if the vertex is not in the graph;
@@ -110,8 +195,12 @@ namespace g2o {
     if (v != v2)
       return false;
     _vertices.erase(v->id());
+    if (_denseVertexIds)
+      eraseDenseVertex(v);
     v->setId(newId);
     _vertices.insert(std::make_pair(v->id(), v));
+    if (_denseVertexIds)
+      insertDenseVertex(v);
     return true;
   }
 
@@ -125,6 +214,7 @@ namespace g2o {
       if (v)
 	v->edges().insert(e);
     }
+    _adjacencyValid = false;
     return true;
   }
 
@@ -136,6 +226,7 @@ namespace g2o {
     e->setVertex(pos, v);
     if (v)
       v->edges().insert(e);
+    _adjacencyValid = false;
     return true;
   }
 
@@ -200,6 +291,9 @@ namespace g2o {
       }
     }
     _vertices.erase(it);
+    if (_denseVertexIds)
+      eraseDenseVertex(v);
+    _adjacencyValid = false;
     delete v;
     return true;
   }
@@ -218,12 +312,41 @@ namespace g2o {
       assert(it!=v->edges().end());
       v->edges().erase(it);
     }
+    _adjacencyValid = false;
 
     delete e;
     return true;
   }
 
-  HyperGraph::HyperGraph()
+  const HyperGraph::Adjacency& HyperGraph::adjacency()
+  {
+    if (_adjacencyValid)
+      return _adjacency;
+
+    size_t numIncidences = 0;
+    _adjacency._vertices.resize(_vertices.size());
+    _adjacency._start.resize(_vertices.size() + 1);
+    int idx = 0;
+    for (VertexIDMap::iterator it=_vertices.begin(); it!=_vertices.end(); ++it, ++idx){
+      Vertex* v = it->second;
+      v->_adjacencyIndex = idx;
+      _adjacency._vertices[idx] = v;
+      _adjacency._start[idx] = numIncidences;
+      numIncidences += v->edges().size();
+    }
+    _adjacency._start[idx] = numIncidences;
+
+    _adjacency._edges.resize(numIncidences);
+    for (size_t i = 0; i < _adjacency._vertices.size(); ++i) {
+      const EdgeSet& vedges = _adjacency._vertices[i]->edges();
+      std::copy(vedges.begin(), vedges.end(), _adjacency._edges.begin() + _adjacency._start[i]);
+    }
+    _adjacencyValid = true;
+    return _adjacency;
+  }
+
+  HyperGraph::HyperGraph() :
+    _adjacencyValid(false), _denseVertexIds(false), _denseIdOffset(0), _numDenseVertices(0), _numSparseVertices(0)
   {
   }
 
@@ -235,6 +358,16 @@ namespace g2o {
       delete (*it);
     _vertices.clear();
     _edges.clear();
+    _adjacency = Adjacency();
+    _adjacencyValid = false;
+    _denseVertices.clear();
+    _denseIdOffset = 0;
+    _numDenseVertices = 0;
+    _numSparseVertices = 0;
+#   ifdef G2O_USE_MEMORY_POOL
+    // hand the slabs back to the system if this was the last graph using the pool
+    MemoryPool::global().release();
+#   endif
   }
 
   HyperGraph::~HyperGraph()
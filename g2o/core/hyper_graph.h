@@ -102,6 +102,14 @@ namespace g2o {
           virtual bool read(std::istream& is) = 0;
           //! write the data to a stream
           virtual bool write(std::ostream& os) const = 0;
+          /**
+           * write the data in a compact binary form, used by the binary format of
+           * the OptimizableGraph. Returns false if the type does not support it,
+           * in this case the output of write() is stored.
+           */
+          virtual bool writeBinary(std::ostream& os) const { (void) os; return false;}
+          //! read the data written by writeBinary()
+          virtual bool readBinary(std::istream& is) { (void) is; return false;}
           virtual HyperGraph::HyperGraphElementType elementType() const { return HyperGraph::HGET_DATA;}
           inline const Data* next() const {return _next;}
           inline Data* next() {return _next;}
@@ -152,9 +160,13 @@ namespace g2o {
           //! returns the set of hyper-edges that are leaving/entering in this vertex
           EdgeSet& edges() {return _edges;}
           virtual HyperGraphElementType elementType() const { return HGET_VERTEX;}
+          //! index of the vertex in the Adjacency of its graph, -1 if not assigned yet
+          int adjacencyIndex() const { return _adjacencyIndex;}
         protected:
+          friend class HyperGraph;
           int _id;
           EdgeSet _edges;
+          int _adjacencyIndex;
       };
 
 
@@ -203,6 +215,54 @@ namespace g2o {
           int _id; ///< unique id
       };
 
+      /**
+       * \brief compact adjacency of the hyper graph.
+       *
+       * Stores for each vertex the incident edges contiguously in compressed
+       * row storage, in the same order as Vertex::edges(). Traversing it
+       * touches two arrays instead of the nodes of one std::set per vertex.
+       * It is a snapshot which is rebuilt by HyperGraph::adjacency() after the
+       * structure of the graph changed.
+       */
+      class G2O_CORE_API Adjacency {
+        public:
+          typedef Edge* const* const_iterator;
+
+          //! the edges incident to a vertex
+          class EdgeRange {
+            public:
+              EdgeRange(const_iterator b, const_iterator e) : _begin(b), _end(e) {}
+              const_iterator begin() const { return _begin;}
+              const_iterator end() const { return _end;}
+              size_t size() const { return _end - _begin;}
+              bool empty() const { return _begin == _end;}
+            protected:
+              const_iterator _begin;
+              const_iterator _end;
+          };
+
+          //! the edges incident to v, v has to be a vertex of the graph
+          EdgeRange edges(const Vertex* v) const
+          {
+            int idx = v->adjacencyIndex();
+            assert(idx >= 0 && idx < static_cast<int>(_vertices.size()) && _vertices[idx] == v && "vertex is not part of the graph, use Vertex::edges()");
+            if (idx < 0 || idx >= static_cast<int>(_vertices.size()) || _vertices[idx] != v)
+              return EdgeRange(0, 0);
+            const_iterator base = _edges.empty() ? 0 : &_edges[0];
+            return EdgeRange(base + _start[idx], base + _start[idx + 1]);
+          }
+          //! the vertices in the order of their adjacency index
+          const VertexContainer& vertices() const { return _vertices;}
+          //! number of (vertex, edge) incidences stored
+          size_t numIncidences() const { return _edges.size();}
+
+        protected:
+          friend class HyperGraph;
+          VertexContainer _vertices;
+          std::vector<int> _start;
+          std::vector<Edge*> _edges;
+      };
+
     public:
       //! constructs an empty hyper graph
       HyperGraph();
@@ -270,9 +330,43 @@ namespace g2o {
        */
       virtual bool changeId(Vertex* v, int newId);
 
+      /**
+       * returns the compact adjacency of the graph, rebuilding it if the
+       * structure changed since the last call. If you modify the EdgeSet of a
+       * vertex directly, call invalidateAdjacency() afterwards.
+       */
+      const Adjacency& adjacency();
+      //! marks the adjacency as outdated, it gets rebuilt on the next call of adjacency()
+      void invalidateAdjacency() { _adjacencyValid = false;}
+
+      /**
+       * Enables the dense vertex table. If the vertex ids are (mostly) dense
+       * in a range [a, b], vertex(id) is answered by indexing a vector by
+       * id - a instead of hashing the id. Ids which would make the range much
+       * larger than the number of vertices in it are only kept in the hash
+       * map and are still found through it. The
+       * hash map stays the authoritative storage returned by vertices(), call
+       * this function again after modifying vertices() directly to rebuild
+       * the table. Ideally called right after constructing the graph.
+       * OptimizableGraph::load() and loadBinary() enable it if the graph is empty.
+       */
+      void setDenseVertexIds(bool denseVertexIds);
+      //! true if the dense vertex table is used, see setDenseVertexIds()
+      bool denseVertexIds() const { return _denseVertexIds;}
+
     protected:
       VertexIDMap _vertices;
       EdgeSet _edges;
+      Adjacency _adjacency;
+      bool _adjacencyValid;
+      bool _denseVertexIds;
+      VertexContainer _denseVertices; ///< vertices indexed by their id - _denseIdOffset, if _denseVertexIds is set
+      long long _denseIdOffset;       ///< id of the first element of _denseVertices
+      int _numDenseVertices;          ///< vertices stored in _denseVertices
+      int _numSparseVertices;         ///< vertices which are only stored in the hash map
+
+      bool insertDenseVertex(Vertex* v);
+      void eraseDenseVertex(const Vertex* v);
 
     private:
       // Disable the copy constructor and assignment operator
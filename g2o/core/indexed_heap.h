@@ -0,0 +1,145 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_INDEXED_HEAP_H
+#define G2O_INDEXED_HEAP_H
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace g2o {
+
+  /**
+   * \brief binary min-heap over pointers to entries, supporting decrease-key
+   *
+   * The entries are ordered by their _distance member. Ties are broken by the
+   * order of the last push, which reproduces the processing order of a
+   * std::multimap keyed by the distance. Each entry stores its position in the
+   * heap in _heapIndex (-1 if not contained) and its insertion stamp in
+   * _heapSequence, hence EntryType has to befriend IndexedBinaryHeap.
+   */
+  template <typename EntryType>
+  class IndexedBinaryHeap
+  {
+    public:
+      IndexedBinaryHeap() : _sequence(0) {}
+
+      bool empty() const { return _heap.empty();}
+      size_t size() const { return _heap.size();}
+
+      /**
+       * inserts the entry, or restores the heap order if the entry is already
+       * contained and its distance changed.
+       */
+      void push(EntryType* entry)
+      {
+        assert(entry);
+        entry->_heapSequence = _sequence++;
+        if (entry->_heapIndex < 0) {
+          entry->_heapIndex = static_cast<int>(_heap.size());
+          _heap.push_back(entry);
+          siftUp(entry->_heapIndex);
+        } else {
+          assert(_heap[entry->_heapIndex] == entry);
+          siftUp(entry->_heapIndex);
+          siftDown(entry->_heapIndex);
+        }
+      }
+
+      //! removes and returns the entry with the smallest distance
+      EntryType* pop()
+      {
+        assert(! _heap.empty());
+        EntryType* top = _heap[0];
+        EntryType* last = _heap.back();
+        _heap.pop_back();
+        top->_heapIndex = -1;
+        if (! _heap.empty()) {
+          _heap[0] = last;
+          last->_heapIndex = 0;
+          siftDown(0);
+        }
+        return top;
+      }
+
+      void clear()
+      {
+        for (size_t i = 0; i < _heap.size(); ++i)
+          _heap[i]->_heapIndex = -1;
+        _heap.clear();
+      }
+
+    protected:
+      static bool less(const EntryType* a, const EntryType* b)
+      {
+        return a->_distance < b->_distance || (a->_distance == b->_distance && a->_heapSequence < b->_heapSequence);
+      }
+
+      void place(EntryType* entry, int i)
+      {
+        _heap[i] = entry;
+        entry->_heapIndex = i;
+      }
+
+      void siftUp(int i)
+      {
+        EntryType* entry = _heap[i];
+        while (i > 0) {
+          int parent = (i - 1) / 2;
+          if (! less(entry, _heap[parent]))
+            break;
+          place(_heap[parent], i);
+          i = parent;
+        }
+        place(entry, i);
+      }
+
+      void siftDown(int i)
+      {
+        EntryType* entry = _heap[i];
+        int n = static_cast<int>(_heap.size());
+        while (true) {
+          int child = 2 * i + 1;
+          if (child >= n)
+            break;
+          if (child + 1 < n && less(_heap[child + 1], _heap[child]))
+            ++child;
+          if (! less(_heap[child], entry))
+            break;
+          place(_heap[child], i);
+          i = child;
+        }
+        place(entry, i);
+      }
+
+      std::vector<EntryType*> _heap;
+      size_t _sequence;
+  };
+
+} // end namespace
+
+#endif
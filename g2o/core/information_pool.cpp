@@ -0,0 +1,67 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "information_pool.h"
+
+#include <cstring>
+
+namespace g2o {
+
+  std::string InformationPool::key(int staticDimension, int dimension, const double* data)
+  {
+    size_t dataSize = static_cast<size_t>(dimension) * dimension * sizeof(double);
+    std::string result(2 * sizeof(int) + dataSize, '\0');
+    memcpy(&result[0], &staticDimension, sizeof(int));
+    memcpy(&result[sizeof(int)], &dimension, sizeof(int));
+    if (dataSize > 0)
+      memcpy(&result[2 * sizeof(int)], data, dataSize);
+    return result;
+  }
+
+  std::shared_ptr<void> InformationPool::find(int staticDimension, int dimension, const double* data) const
+  {
+    MatrixMap::const_iterator it = _matrices.find(key(staticDimension, dimension, data));
+    if (it == _matrices.end())
+      return std::shared_ptr<void>();
+    return it->second;
+  }
+
+  void InformationPool::insert(int staticDimension, int dimension, const double* data, const std::shared_ptr<void>& matrix)
+  {
+    std::shared_ptr<void>& entry = _matrices[key(staticDimension, dimension, data)];
+    if (! entry)
+      _bytes += static_cast<size_t>(dimension) * dimension * sizeof(double);
+    entry = matrix;
+  }
+
+  void InformationPool::clear()
+  {
+    _matrices.clear();
+    _bytes = 0;
+  }
+
+} // end namespace
@@ -0,0 +1,84 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef G2O_INFORMATION_POOL_H
+#define G2O_INFORMATION_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "g2o_core_api.h"
+
+namespace g2o {
+
+  /**
+   * \brief deduplicates the information matrices of the edges
+   *
+   * Large graphs often carry the same information matrix on most of their
+   * edges, e.g., odometry or reprojection edges with a constant noise model.
+   * The pool maps the entries of a matrix to one reference counted instance,
+   * which the edges may reference instead of their own copy, see
+   * OptimizableGraph::Edge::shareInformation() and
+   * OptimizableGraph::setInformationPool(). The matrices are stored type
+   * erased, they are identified by the compile time dimension of the edge
+   * together with the actual dimension and the bit pattern of the entries.
+   */
+  class G2O_CORE_API InformationPool
+  {
+    public:
+      InformationPool() : _bytes(0) {}
+
+      /**
+       * returns the matrix stored for the given entries, 0 if there is none.
+       * @param staticDimension the dimension of the matrix type, -1 if dynamic
+       * @param dimension the number of rows and columns of the matrix
+       * @param data the entries of the matrix in column major order
+       */
+      std::shared_ptr<void> find(int staticDimension, int dimension, const double* data) const;
+      //! stores matrix for the given entries, replacing a previous one
+      void insert(int staticDimension, int dimension, const double* data, const std::shared_ptr<void>& matrix);
+
+      //! number of distinct matrices in the pool
+      size_t size() const { return _matrices.size();}
+      //! bytes occupied by the entries of the distinct matrices
+      size_t bytes() const { return _bytes;}
+
+      void clear();
+
+    protected:
+      typedef std::unordered_map<std::string, std::shared_ptr<void> > MatrixMap;
+      MatrixMap _matrices;
+      size_t _bytes;
+
+      static std::string key(int staticDimension, int dimension, const double* data);
+  };
+
+} // end namespace
+
+#endif
@@ -78,6 +78,10 @@ class LinearSolver
     //! write a debug dump of the system matrix if it is not PSD in solve
     virtual bool writeDebug() const { return false;}
     virtual void setWriteDebug(bool) {}
+
+    //! factorize in single precision and refine the solution in double precision, if supported
+    virtual bool singlePrecision() const { return false;}
+    virtual void setSinglePrecision(bool) {}
 };
 
 /**
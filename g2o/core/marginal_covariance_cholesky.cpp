@@ -51,7 +51,7 @@ MarginalCovarianceCholesky::~MarginalCovarianceCholesky()
 {
 }
 
-void MarginalCovarianceCholesky::setCholeskyFactor(int n, int* Lp, int* Li, double* Lx, int* permInv)
+void MarginalCovarianceCholesky::setCholeskyFactor(int n, SparseIndex* Lp, SparseIndex* Li, double* Lx, SparseIndex* permInv)
 {
   _n = n;
   _Ap = Lp;
@@ -62,7 +62,7 @@ void MarginalCovarianceCholesky::setCholeskyFactor(int n, int* Lp, int* Li, doub
   // pre-compute reciprocal values of the diagonal of L
   _diag.resize(n);
   for (int r = 0; r < n; ++r) {
-    const int& sc = _Ap[r]; // L is lower triangular, thus the first elem in the column is the diagonal entry
+    const SparseIndex& sc = _Ap[r]; // L is lower triangular, thus the first elem in the column is the diagonal entry
     assert(r == _Ai[sc] && "Error in CCS storage of L");
     _diag[r] = 1.0 / _Ax[sc];
   }
@@ -71,7 +71,7 @@ void MarginalCovarianceCholesky::setCholeskyFactor(int n, int* Lp, int* Li, doub
 double MarginalCovarianceCholesky::computeEntry(int r, int c)
 {
   assert(r <= c);
-  int idx = computeIndex(r, c);
+  long long idx = computeIndex(r, c);
 
   LookupMap::const_iterator foundIt = _map.find(idx);
   if (foundIt != _map.end()) {
@@ -80,10 +80,10 @@ double MarginalCovarianceCholesky::computeEntry(int r, int c)
 
   // compute the summation over column r
   double s = 0.;
-  const int& sc = _Ap[r];
-  const int& ec = _Ap[r+1];
-  for (int j = sc+1; j < ec; ++j) { // sum over row r while skipping the element on the diagonal
-    const int& rr = _Ai[j];
+  const SparseIndex& sc = _Ap[r];
+  const SparseIndex& ec = _Ap[r+1];
+  for (SparseIndex j = sc+1; j < ec; ++j) { // sum over row r while skipping the element on the diagonal
+    int rr = static_cast<int>(_Ai[j]);
     double val = rr < c ? computeEntry(rr, c) : computeEntry(c, rr);
     s += val * _Ax[j];
   }
@@ -109,8 +109,8 @@ void MarginalCovarianceCholesky::computeCovariance(double** covBlocks, const std
     int vdim = nbase - base;
     for (int rr = 0; rr < vdim; ++rr)
       for (int cc = rr; cc < vdim; ++cc) {
-        int r = _perm ? _perm[rr + base] : rr + base; // apply permutation
-        int c = _perm ? _perm[cc + base] : cc + base;
+        int r = _perm ? static_cast<int>(_perm[rr + base]) : rr + base; // apply permutation
+        int c = _perm ? static_cast<int>(_perm[cc + base]) : cc + base;
         if (r > c) // make sure it's still upper triangular after applying the permutation
           swap(r, c);
         elemsToCompute.push_back(MatrixElem(r, c));
@@ -135,11 +135,11 @@ void MarginalCovarianceCholesky::computeCovariance(double** covBlocks, const std
     double* cov = covBlocks[i];
     for (int rr = 0; rr < vdim; ++rr)
       for (int cc = rr; cc < vdim; ++cc) {
-        int r = _perm ? _perm[rr + base] : rr + base; // apply permutation
-        int c = _perm ? _perm[cc + base] : cc + base;
+        int r = _perm ? static_cast<int>(_perm[rr + base]) : rr + base; // apply permutation
+        int c = _perm ? static_cast<int>(_perm[cc + base]) : cc + base;
         if (r > c) // upper triangle
           swap(r, c);
-        int idx = computeIndex(r, c);
+        long long idx = computeIndex(r, c);
         LookupMap::const_iterator foundIt = _map.find(idx);
         assert(foundIt != _map.end());
         cov[rr*vdim + cc] = foundIt->second;
@@ -177,8 +177,8 @@ void MarginalCovarianceCholesky::computeCovariance(SparseBlockMatrix<MatrixXD>&
       for (int iCol=0; iCol<block->cols(); ++iCol){
         int rr=rowBase+iRow;
         int cc=colBase+iCol;
-        int r = _perm ? _perm[rr] : rr; // apply permutation
-        int c = _perm ? _perm[cc] : cc;
+        int r = _perm ? static_cast<int>(_perm[rr]) : rr; // apply permutation
+        int c = _perm ? static_cast<int>(_perm[cc]) : cc;
         if (r > c)
           swap(r, c);
         elemsToCompute.push_back(MatrixElem(r, c));
@@ -207,11 +207,11 @@ void MarginalCovarianceCholesky::computeCovariance(SparseBlockMatrix<MatrixXD>&
       for (int iCol=0; iCol<block->cols(); ++iCol){
         int rr=rowBase+iRow;
         int cc=colBase+iCol;
-        int r = _perm ? _perm[rr] : rr; // apply permutation
-        int c = _perm ? _perm[cc] : cc;
+        int r = _perm ? static_cast<int>(_perm[rr]) : rr; // apply permutation
+        int c = _perm ? static_cast<int>(_perm[cc]) : cc;
         if (r > c)
           swap(r, c);
-        int idx = computeIndex(r, c);
+        long long idx = computeIndex(r, c);
         LookupMap::const_iterator foundIt = _map.find(idx);
         assert(foundIt != _map.end());
         (*block)(iRow, iCol) = foundIt->second;
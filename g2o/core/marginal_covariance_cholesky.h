@@ -29,6 +29,7 @@
 
 #include "optimizable_graph.h"
 #include "sparse_block_matrix.h"
+#include "sparse_index.h"
 
 #include <cassert>
 #include <vector>
@@ -47,7 +48,7 @@ namespace g2o {
       /**
        * hash struct for storing the matrix elements needed to compute the covariance
        */
-      typedef std::unordered_map<int, double>     LookupMap;
+      typedef std::unordered_map<long long, double>     LookupMap;
     
     public:
       MarginalCovarianceCholesky();
@@ -73,21 +74,21 @@ namespace g2o {
        * The pointers provided by the user need to be still valid when calling computeCovariance(). The pointers
        * are owned by the caller, MarginalCovarianceCholesky does not free the pointers.
        */
-      void setCholeskyFactor(int n, int* Lp, int* Li, double* Lx, int* permInv);
+      void setCholeskyFactor(int n, SparseIndex* Lp, SparseIndex* Li, double* Lx, SparseIndex* permInv);
 
     protected:
       // information about the cholesky factor (lower triangle)
       int _n;           ///< L is an n X n matrix
-      int* _Ap;         ///< column pointer of the CCS storage
-      int* _Ai;         ///< row indices of the CCS storage
-      double* _Ax;      ///< values of the cholesky factor
-      int* _perm;       ///< permutation of the cholesky factor. Variable re-ordering for better fill-in
+      SparseIndex* _Ap;   ///< column pointer of the CCS storage
+      SparseIndex* _Ai;   ///< row indices of the CCS storage
+      double* _Ax;        ///< values of the cholesky factor
+      SparseIndex* _perm; ///< permutation of the cholesky factor. Variable re-ordering for better fill-in
 
       LookupMap _map;             ///< hash look up table for the already computed entries
       std::vector<double> _diag;  ///< cache 1 / H_ii to avoid recalculations
 
-      //! compute the index used for hashing
-      int computeIndex(int r, int c) const { /*assert(r <= c);*/ return r*_n + c;}
+      //! compute the index used for hashing, 64 bit as r*n+c exceeds the range of int for n > 46340
+      long long computeIndex(int r, int c) const { /*assert(r <= c);*/ return static_cast<long long>(r)*_n + c;}
       /**
        * compute one entry in the covariance, r and c are values after applying the permutation, and upper triangular.
        * May issue recursive calls to itself to compute the missing values.
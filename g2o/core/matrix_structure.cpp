@@ -57,20 +57,20 @@ void MatrixStructure::alloc(int n_, int nz)
   if (n == 0) {
     maxN = n = n_;
     maxNz = nz;
-    Ap  = new int[maxN + 1];
-    Aii = new int[maxNz];
+    Ap  = new SparseIndex[maxN + 1];
+    Aii = new SparseIndex[maxNz];
   }
   else {
     n = n_;
     if (maxNz < nz) {
       maxNz = 2 * nz;
       delete[] Aii;
-      Aii = new int[maxNz];
+      Aii = new SparseIndex[maxNz];
     }
     if (maxN < n) {
       maxN = 2 * n;
       delete[] Ap;
-      Ap = new int[maxN + 1];
+      Ap = new SparseIndex[maxN + 1];
     }
   }
 }
@@ -97,9 +97,9 @@ bool MatrixStructure::write(const char* filename) const
 
   vector<pair<int, int> > entries;
   for (int i=0; i < cols; ++i) {
-    const int& rbeg = Ap[i];
-    const int& rend = Ap[i+1];
-    for (int j = rbeg; j < rend; ++j) {
+    const SparseIndex& rbeg = Ap[i];
+    const SparseIndex& rend = Ap[i+1];
+    for (SparseIndex j = rbeg; j < rend; ++j) {
       entries.push_back(make_pair(Aii[j], i));
       if (Aii[j] != i)
         entries.push_back(make_pair(i, Aii[j]));
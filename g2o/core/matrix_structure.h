@@ -28,6 +28,7 @@
 #define G2O_MATRIX_STRUCTURE_H
 
 #include "g2o_core_api.h"
+#include "sparse_index.h"
 
 namespace g2o {
 
@@ -54,8 +55,8 @@ class G2O_CORE_API MatrixStructure
 
     int n;    ///< A is m-by-n.  n must be >= 0.
     int m;    ///< A is m-by-n.  m must be >= 0.
-    int* Ap;  ///< column pointers for A, of size n+1
-    int* Aii; ///< row indices of A, of size nz = Ap [n]
+    SparseIndex* Ap;  ///< column pointers for A, of size n+1
+    SparseIndex* Aii; ///< row indices of A, of size nz = Ap [n]
 
     //! max number of non-zeros blocks
     int nzMax() const { return maxNz;}
@@ -0,0 +1,150 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "memory_pool.h"
+
+#include <cassert>
+#include <iostream>
+
+namespace g2o {
+
+  MemoryPool::Statistics::Statistics() :
+    numAllocations(0), numDeallocations(0), bytesAllocated(0), bytesInUse(0), bytesReserved(0)
+  {
+  }
+
+  MemoryPool::MemoryPool() :
+    _sizeClasses(sizeClass(MaxPooledSize) + 1)
+  {
+  }
+
+  MemoryPool::~MemoryPool()
+  {
+    for (size_t i = 0; i < _slabs.size(); ++i)
+      Eigen::internal::aligned_free(_slabs[i]);
+  }
+
+  void* MemoryPool::allocate(size_t size)
+  {
+    if (size == 0)
+      size = 1;
+    if (size > MaxPooledSize) {
+      void* ptr = Eigen::internal::aligned_malloc(size);
+      ScopedOpenMPMutex lock(&_mutex);
+      ++_statistics.numAllocations;
+      _statistics.bytesAllocated += size;
+      _statistics.bytesInUse += size;
+      return ptr;
+    }
+
+    ScopedOpenMPMutex lock(&_mutex);
+    size_t c = sizeClass(size);
+    size_t classBytes = (c + 1) * Alignment;
+    SizeClass& sc = _sizeClasses[c];
+    ++_statistics.numAllocations;
+    _statistics.bytesAllocated += classBytes;
+    _statistics.bytesInUse += classBytes;
+    if (sc.freeList) {
+      FreeNode* node = sc.freeList;
+      sc.freeList = node->next;
+      return node;
+    }
+    if (sc.current + classBytes > sc.end) {
+      void* slab = Eigen::internal::aligned_malloc(SlabSize);
+      _slabs.push_back(slab);
+      _statistics.bytesReserved += SlabSize;
+      sc.current = static_cast<char*>(slab);
+      sc.end = sc.current + (SlabSize / classBytes) * classBytes;
+    }
+    void* ptr = sc.current;
+    sc.current += classBytes;
+    return ptr;
+  }
+
+  void MemoryPool::deallocate(void* ptr, size_t size)
+  {
+    if (! ptr)
+      return;
+    if (size == 0)
+      size = 1;
+    if (size > MaxPooledSize) {
+      Eigen::internal::aligned_free(ptr);
+      ScopedOpenMPMutex lock(&_mutex);
+      ++_statistics.numDeallocations;
+      _statistics.bytesInUse -= size;
+      return;
+    }
+
+    ScopedOpenMPMutex lock(&_mutex);
+    size_t c = sizeClass(size);
+    SizeClass& sc = _sizeClasses[c];
+    FreeNode* node = static_cast<FreeNode*>(ptr);
+    node->next = sc.freeList;
+    sc.freeList = node;
+    ++_statistics.numDeallocations;
+    _statistics.bytesInUse -= (c + 1) * Alignment;
+  }
+
+  bool MemoryPool::release()
+  {
+    ScopedOpenMPMutex lock(&_mutex);
+    if (_statistics.bytesInUse != 0)
+      return false;
+    for (size_t i = 0; i < _slabs.size(); ++i)
+      Eigen::internal::aligned_free(_slabs[i]);
+    _slabs.clear();
+    for (size_t i = 0; i < _sizeClasses.size(); ++i)
+      _sizeClasses[i] = SizeClass();
+    _statistics.bytesReserved = 0;
+    return true;
+  }
+
+  void MemoryPool::resetCounters()
+  {
+    ScopedOpenMPMutex lock(&_mutex);
+    _statistics.numAllocations = 0;
+    _statistics.numDeallocations = 0;
+    _statistics.bytesAllocated = 0;
+  }
+
+  MemoryPool& MemoryPool::global()
+  {
+    // intentionally never destroyed, elements may be freed during static destruction
+    static MemoryPool* pool = new MemoryPool;
+    return *pool;
+  }
+
+  std::ostream& operator<<(std::ostream& os, const MemoryPool::Statistics& st)
+  {
+    os << "allocations= " << st.numAllocations
+      << "\t deallocations= " << st.numDeallocations
+      << "\t bytesAllocated= " << st.bytesAllocated
+      << "\t bytesInUse= " << st.bytesInUse
+      << "\t bytesReserved= " << st.bytesReserved;
+    return os;
+  }
+
+} // end namespace
@@ -0,0 +1,179 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_MEMORY_POOL_H
+#define G2O_MEMORY_POOL_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "g2o/config.h"
+#include "openmp_mutex.h"
+#include "g2o_core_api.h"
+
+namespace g2o {
+
+  /**
+   * \brief slab allocator for small objects of the graph and the solver
+   *
+   * Objects are grouped into size classes which are a multiple of the
+   * alignment Eigen requires for fixed size members. Each size class carves
+   * its objects from slabs of SlabSize bytes and recycles freed objects via an
+   * intrusive free list. Larger objects are passed on to Eigen's aligned
+   * malloc. The slabs are returned to the system in one go by release() once
+   * no object of the pool is alive anymore.
+   *
+   * The pool is only used if g2o is configured with G2O_USE_MEMORY_POOL, see
+   * G2O_MAKE_POOLED_OPERATOR_NEW and newPooled() / deletePooled().
+   */
+  class G2O_CORE_API MemoryPool
+  {
+    public:
+      /**
+       * \brief counters of the pool
+       *
+       * numAllocations, numDeallocations and bytesAllocated count since the
+       * last call of resetCounters(), which allows to report them per phase,
+       * e.g., loading, optimizing and clearing the graph.
+       */
+      struct G2O_CORE_API Statistics {
+        size_t numAllocations;
+        size_t numDeallocations;
+        size_t bytesAllocated;  ///< bytes requested by the allocations
+        size_t bytesInUse;      ///< bytes of the objects which are currently alive
+        size_t bytesReserved;   ///< bytes held by the slabs
+        Statistics();
+      };
+
+      static const size_t Alignment = EIGEN_MAX_ALIGN_BYTES > 16 ? EIGEN_MAX_ALIGN_BYTES : 16;
+      static const size_t MaxPooledSize = 4096;
+      static const size_t SlabSize = 64 * 1024;
+
+      MemoryPool();
+      ~MemoryPool();
+
+      void* allocate(size_t size);
+      void deallocate(void* ptr, size_t size);
+
+      /**
+       * frees all slabs if no object of the pool is alive.
+       * @returns true if the memory was released
+       */
+      bool release();
+
+      const Statistics& statistics() const { return _statistics;}
+      //! resets the per phase counters of the statistics
+      void resetCounters();
+
+      //! the pool shared by the graph elements and the solver blocks
+      static MemoryPool& global();
+
+    protected:
+      struct FreeNode {
+        FreeNode* next;
+      };
+      struct SizeClass {
+        FreeNode* freeList;
+        char* current;
+        char* end;
+        SizeClass() : freeList(0), current(0), end(0) {}
+      };
+
+      static size_t sizeClass(size_t size) { return (size + Alignment - 1) / Alignment - 1;}
+
+      std::vector<SizeClass> _sizeClasses;
+      std::vector<void*> _slabs;
+      Statistics _statistics;
+      OpenMPMutex _mutex;
+
+    private:
+      MemoryPool(const MemoryPool&);
+      MemoryPool& operator=(const MemoryPool&);
+  };
+
+  G2O_CORE_API std::ostream& operator<<(std::ostream& os, const MemoryPool::Statistics& st);
+
+#ifdef G2O_USE_MEMORY_POOL
+
+  //! creates an object from the memory pool, to be freed by deletePooled()
+  template <typename T, typename... Args>
+  T* newPooled(Args&&... args)
+  {
+    void* mem = MemoryPool::global().allocate(sizeof(T));
+    return new (mem) T(std::forward<Args>(args)...);
+  }
+
+  //! destroys an object created by newPooled()
+  template <typename T>
+  void deletePooled(T* ptr)
+  {
+    if (! ptr)
+      return;
+    ptr->~T();
+    MemoryPool::global().deallocate(ptr, sizeof(T));
+  }
+
+/**
+ * class specific operator new / delete drawing from MemoryPool::global(),
+ * replaces EIGEN_MAKE_ALIGNED_OPERATOR_NEW if G2O_USE_MEMORY_POOL is set.
+ * The sized delete receives the size of the dynamic type via the virtual
+ * destructor.
+ */
+#define G2O_MAKE_POOLED_OPERATOR_NEW \
+  void* operator new(std::size_t size) { return g2o::MemoryPool::global().allocate(size); } \
+  void operator delete(void* ptr, std::size_t size) { g2o::MemoryPool::global().deallocate(ptr, size); } \
+  void* operator new[](std::size_t size) { return Eigen::internal::conditional_aligned_malloc<true>(size); } \
+  void operator delete[](void* ptr) { Eigen::internal::conditional_aligned_free<true>(ptr); } \
+  static void* operator new(std::size_t, void* ptr) { return ptr; } \
+  static void operator delete(void*, void*) {} \
+  typedef void eigen_aligned_operator_new_marker_type;
+
+#else
+
+  template <typename T, typename... Args>
+  T* newPooled(Args&&... args)
+  {
+    return new T(std::forward<Args>(args)...);
+  }
+
+  template <typename T>
+  void deletePooled(T* ptr)
+  {
+    delete ptr;
+  }
+
+#define G2O_MAKE_POOLED_OPERATOR_NEW EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+#endif
+
+} // end namespace
+
+#endif
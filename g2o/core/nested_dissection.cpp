@@ -0,0 +1,279 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "nested_dissection.h"
+
+#include "matrix_structure.h"
+
+#include <Eigen/SparseCore>
+#include <Eigen/OrderingMethods>
+
+#include <cassert>
+using namespace std;
+
+namespace g2o {
+
+namespace {
+  struct Part
+  {
+    vector<int> vertices;
+    int offset; ///< position of the first vertex of the part in the ordering
+  };
+}
+
+NestedDissection::NestedDissection() :
+  _leafSize(64)
+{
+}
+
+void NestedDissection::compute(const MatrixStructure& A, std::vector<int>& perm)
+{
+  const int n = A.n;
+  perm.resize(n);
+  if (n == 0)
+    return;
+
+  // symmetric adjacency without the diagonal from the upper triangle
+  _adjacencyStart.assign(n + 1, 0);
+  for (int c = 0; c < n; ++c) {
+    for (SparseIndex p = A.Ap[c]; p < A.Ap[c+1]; ++p) {
+      int r = static_cast<int>(A.Aii[p]);
+      if (r >= c)
+        continue;
+      ++_adjacencyStart[r + 1];
+      ++_adjacencyStart[c + 1];
+    }
+  }
+  for (int i = 0; i < n; ++i)
+    _adjacencyStart[i + 1] += _adjacencyStart[i];
+  _adjacency.resize(_adjacencyStart[n]);
+  vector<int> fill(_adjacencyStart.begin(), _adjacencyStart.end() - 1);
+  for (int c = 0; c < n; ++c) {
+    for (SparseIndex p = A.Ap[c]; p < A.Ap[c+1]; ++p) {
+      int r = static_cast<int>(A.Aii[p]);
+      if (r >= c)
+        continue;
+      _adjacency[fill[r]++] = c;
+      _adjacency[fill[c]++] = r;
+    }
+  }
+
+  _part.assign(n, 0);
+  _level.assign(n, -1);
+  vector<int> queue;
+  vector<int> levelStart;
+  queue.reserve(n);
+
+  vector<Part> parts(1);
+  parts[0].offset = 0;
+  parts[0].vertices.resize(n);
+  for (int i = 0; i < n; ++i)
+    parts[0].vertices[i] = i;
+
+  int partId = 0;
+  while (! parts.empty()) {
+    Part part;
+    part.vertices.swap(parts.back().vertices);
+    part.offset = parts.back().offset;
+    parts.pop_back();
+    const vector<int>& vertices = part.vertices;
+    const int size = static_cast<int>(vertices.size());
+    ++partId;
+    for (int i = 0; i < size; ++i)
+      _part[vertices[i]] = partId;
+
+    if (size <= _leafSize) {
+      orderLeaf(vertices, &perm[part.offset]);
+      continue;
+    }
+
+    // split a disconnected part into its connected components
+    if (bfs(vertices[0], partId, queue, levelStart) < size) {
+      int offset = part.offset;
+      size_t first = parts.size();
+      for (int i = 0; i < size; ++i) {
+        if (_level[vertices[i]] >= 0 && i > 0)
+          continue;
+        if (i > 0)
+          bfs(vertices[i], partId, queue, levelStart);
+        parts.push_back(Part());
+        parts.back().vertices = queue;
+        parts.back().offset = offset;
+        offset += static_cast<int>(queue.size());
+      }
+      for (size_t i = first; i < parts.size(); ++i)
+        for (size_t j = 0; j < parts[i].vertices.size(); ++j)
+          _level[parts[i].vertices[j]] = -1;
+      continue;
+    }
+
+    // level structure rooted at a pseudo-peripheral vertex
+    for (int i = 0; i < size; ++i)
+      _level[queue[i]] = -1;
+    pseudoPeripheralVertex(vertices[0], partId, queue, levelStart);
+    const int numLevels = static_cast<int>(levelStart.size()) - 1;
+    if (numLevels < 3) { // no useful separator, e.g., a dense part
+      for (int i = 0; i < size; ++i)
+        _level[queue[i]] = -1;
+      orderLeaf(vertices, &perm[part.offset]);
+      continue;
+    }
+
+    // the level containing the median vertex is the separator
+    int m = 1;
+    while (m < numLevels - 2 && levelStart[m + 1] <= size / 2)
+      ++m;
+
+    // split into A (levels below m), B (levels above m), and the separator.
+    // A separator vertex without a neighbor in level m+1 is moved to A.
+    Part partA, partB;
+    vector<int> separator;
+    for (int i = 0; i < levelStart[m]; ++i)
+      partA.vertices.push_back(queue[i]);
+    for (int i = levelStart[m + 1]; i < size; ++i)
+      partB.vertices.push_back(queue[i]);
+    for (int i = levelStart[m]; i < levelStart[m + 1]; ++i) {
+      const int v = queue[i];
+      bool touchesB = false;
+      for (int p = _adjacencyStart[v]; p < _adjacencyStart[v + 1] && ! touchesB; ++p) {
+        const int u = _adjacency[p];
+        touchesB = _part[u] == partId && _level[u] == m + 1;
+      }
+      if (touchesB)
+        separator.push_back(v);
+      else
+        partA.vertices.push_back(v);
+    }
+    for (int i = 0; i < size; ++i)
+      _level[queue[i]] = -1;
+
+    partA.offset = part.offset;
+    partB.offset = partA.offset + static_cast<int>(partA.vertices.size());
+    int separatorOffset = partB.offset + static_cast<int>(partB.vertices.size());
+    for (size_t i = 0; i < separator.size(); ++i)
+      perm[separatorOffset + i] = separator[i];
+    parts.push_back(Part());
+    parts.back().vertices.swap(partB.vertices);
+    parts.back().offset = partB.offset;
+    parts.push_back(Part());
+    parts.back().vertices.swap(partA.vertices);
+    parts.back().offset = partA.offset;
+  }
+}
+
+int NestedDissection::bfs(int root, int partId, std::vector<int>& queue, std::vector<int>& levelStart)
+{
+  queue.clear();
+  levelStart.clear();
+  queue.push_back(root);
+  _level[root] = 0;
+  size_t begin = 0;
+  int level = 0;
+  while (begin < queue.size()) {
+    levelStart.push_back(static_cast<int>(begin));
+    size_t end = queue.size();
+    for (size_t i = begin; i < end; ++i) {
+      const int v = queue[i];
+      for (int p = _adjacencyStart[v]; p < _adjacencyStart[v + 1]; ++p) {
+        const int u = _adjacency[p];
+        if (_part[u] == partId && _level[u] < 0) {
+          _level[u] = level + 1;
+          queue.push_back(u);
+        }
+      }
+    }
+    begin = end;
+    ++level;
+  }
+  levelStart.push_back(static_cast<int>(queue.size()));
+  return static_cast<int>(queue.size());
+}
+
+int NestedDissection::pseudoPeripheralVertex(int start, int partId, std::vector<int>& queue, std::vector<int>& levelStart)
+{
+  int root = start;
+  bfs(root, partId, queue, levelStart);
+  int eccentricity = static_cast<int>(levelStart.size());
+  for (int iter = 0; iter < 8; ++iter) {
+    // candidate is a vertex of minimal degree in the last level
+    int candidate = queue[levelStart[levelStart.size() - 2]];
+    for (int i = levelStart[levelStart.size() - 2]; i < levelStart.back(); ++i) {
+      const int v = queue[i];
+      if (_adjacencyStart[v + 1] - _adjacencyStart[v] < _adjacencyStart[candidate + 1] - _adjacencyStart[candidate])
+        candidate = v;
+    }
+    for (size_t i = 0; i < queue.size(); ++i)
+      _level[queue[i]] = -1;
+    bfs(candidate, partId, queue, levelStart);
+    if (static_cast<int>(levelStart.size()) <= eccentricity) {
+      // no improvement, restore the level structure of the root
+      for (size_t i = 0; i < queue.size(); ++i)
+        _level[queue[i]] = -1;
+      bfs(root, partId, queue, levelStart);
+      break;
+    }
+    root = candidate;
+    eccentricity = static_cast<int>(levelStart.size());
+  }
+  return root;
+}
+
+void NestedDissection::orderLeaf(const std::vector<int>& vertices, int* perm)
+{
+  const int size = static_cast<int>(vertices.size());
+  if (size <= 2) {
+    for (int i = 0; i < size; ++i)
+      perm[i] = vertices[i];
+    return;
+  }
+
+  // AMD on the sub-graph induced by the vertices, _level temporarily holds the local index
+  for (int i = 0; i < size; ++i)
+    _level[vertices[i]] = i;
+  typedef Eigen::Triplet<double> Triplet;
+  vector<Triplet> triplets;
+  for (int i = 0; i < size; ++i) {
+    const int v = vertices[i];
+    triplets.push_back(Triplet(i, i, 1.));
+    for (int p = _adjacencyStart[v]; p < _adjacencyStart[v + 1]; ++p) {
+      const int u = _adjacency[p];
+      if (_level[u] > i && _part[u] == _part[v])
+        triplets.push_back(Triplet(i, _level[u], 1.));
+    }
+  }
+  for (int i = 0; i < size; ++i)
+    _level[vertices[i]] = -1;
+
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int> pattern(size, size);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> P;
+  Eigen::AMDOrdering<int> ordering;
+  ordering(pattern, P);
+  for (int i = 0; i < size; ++i)
+    perm[i] = vertices[P.indices()(i)];
+}
+
+} // end namespace
@@ -0,0 +1,76 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_NESTED_DISSECTION_H
+#define G2O_NESTED_DISSECTION_H
+
+#include "g2o_core_api.h"
+
+#include <vector>
+
+namespace g2o {
+
+class MatrixStructure;
+
+/**
+ * \brief fill-reducing ordering of a symmetric matrix by recursive graph bisection
+ *
+ * Each connected part of the adjacency graph is split by a vertex separator
+ * taken from a breadth-first level structure rooted at a pseudo-peripheral
+ * vertex. Both halves are ordered recursively before the separator, which
+ * yields an elimination tree with two independent subtrees below each
+ * separator. Parts with at most leafSize vertices are ordered by AMD.
+ */
+class G2O_CORE_API NestedDissection
+{
+  public:
+    NestedDissection();
+
+    /**
+     * compute the ordering for the pattern given by the upper (or full) triangle of A.
+     * perm[new] = old, i.e., the i-th eliminated column is perm[i].
+     */
+    void compute(const MatrixStructure& A, std::vector<int>& perm);
+
+    //! parts with at most this number of vertices are not split further
+    int leafSize() const { return _leafSize;}
+    void setLeafSize(int leafSize) { _leafSize = leafSize;}
+
+  protected:
+    int _leafSize;
+    std::vector<int> _adjacencyStart; ///< CSR adjacency of the symmetric graph without the diagonal
+    std::vector<int> _adjacency;
+    std::vector<int> _part;           ///< id of the part a vertex currently belongs to
+    std::vector<int> _level;          ///< BFS level or local index, depending on the phase
+
+    int bfs(int root, int partId, std::vector<int>& queue, std::vector<int>& levelStart);
+    int pseudoPeripheralVertex(int start, int partId, std::vector<int>& queue, std::vector<int>& levelStart);
+    void orderLeaf(const std::vector<int>& vertices, int* perm);
+};
+
+} // end namespace
+
+#endif
@@ -31,6 +31,7 @@
 #include <iomanip>
 #include <fstream>
 #include <algorithm>
+#include <limits>
 
 #include <Eigen/Dense>
 
@@ -39,6 +40,8 @@
 #include "optimization_algorithm_property.h"
 #include "hyper_graph_action.h"
 #include "cache.h"
+#include "information_pool.h"
+#include "binary_io.h"
 #include "robust_kernel.h"
 
 #include "g2o/stuff/macros.h"
@@ -65,10 +68,9 @@ namespace g2o {
 
 
   void OptimizableGraph::Vertex::updateCache(){
-    if (_cacheContainer){
+    // the caches recompute themselves on the next access
+    if (_cacheContainer)
       _cacheContainer->setUpdateNeeded();
-      _cacheContainer->update();
-    }
   }
 
   OptimizableGraph::Vertex::~Vertex()
@@ -222,6 +224,7 @@ namespace g2o {
   {
     _nextEdgeId = 0; _edge_has_id = false;
     _graphActions.resize(AT_NUM_ELEMENTS);
+    _informationPool = 0;
   }
 
   OptimizableGraph::~OptimizableGraph()
@@ -288,6 +291,15 @@ namespace g2o {
     return true;
   }
 
+  bool OptimizableGraph::addLoadedEdge(Edge* e)
+  {
+    if (! addEdge(e))
+      return false;
+    if (_informationPool)
+      e->shareInformation(*_informationPool);
+    return true;
+  }
+
   bool OptimizableGraph::setEdgeVertex(HyperGraph::Edge* e, int pos, HyperGraph::Vertex* v){
     if (! HyperGraph::setEdgeVertex(e,pos,v)){
       return false;
@@ -383,6 +395,10 @@ void OptimizableGraph::discardTop(HyperGraph::VertexSet& vset)
 
 bool OptimizableGraph::load(istream& is, bool createEdges)
 {
+  // the ids of a file are usually dense, which allows to look up the vertices of the edges by index
+  if (_vertices.empty() && ! _denseVertexIds)
+    setDenseVertexIds(true);
+
   // scna for the paramers in the whole file
   if (!_parameters.read(is,&_renamedTypesLookup))
     return false;
@@ -403,6 +419,10 @@ bool OptimizableGraph::load(istream& is, bool createEdges)
   HyperGraph::DataContainer*  previousDataContainer = 0;
   Data* previousData = 0;
 
+  // files usually contain long runs of the same tag, resolve it once per run
+  string previousToken;
+  int previousTypeId = -1;
+
   int lineNumber = 0;
   while (1) {
     int bytesRead = readLine(is, currentLine);
@@ -444,7 +464,11 @@ bool OptimizableGraph::load(istream& is, bool createEdges)
       }
     }
 
-    if (! factory->knowsTag(token)) {
+    if (token != previousToken) {
+      previousToken = token;
+      previousTypeId = factory->typeId(token);
+    }
+    if (previousTypeId < 0) {
       if (warnedUnknownTypes.count(token) != 1) {
         warnedUnknownTypes.insert(token);
         cerr << CL_RED(__PRETTY_FUNCTION__ << " unknown type: " << token) << endl;
@@ -452,7 +476,7 @@ bool OptimizableGraph::load(istream& is, bool createEdges)
       continue;
     }
 
-    HyperGraph::HyperGraphElement* element = factory->construct(token, elemBitset);
+    HyperGraph::HyperGraphElement* element = factory->construct(previousTypeId, elemBitset);
     if (dynamic_cast<Vertex*>(element)) { // it's a vertex type
       //cerr << "it is a vertex" << endl;
       previousData = 0;
@@ -519,7 +543,7 @@ bool OptimizableGraph::load(istream& is, bool createEdges)
           e->setVertex(0, from);
           e->setVertex(1, to);
           e->read(currentLine);
-          if (!addEdge(e)) {
+          if (!addLoadedEdge(e)) {
             cerr << __PRETTY_FUNCTION__ << ": Unable to add edge " << token << " " << id1 << " <-> " << id2 << endl;
             delete e;
           } else {
@@ -583,7 +607,7 @@ bool OptimizableGraph::load(istream& is, bool createEdges)
           delete e;
         } else {
           bool r = e->read(currentLine);
-          if (!r || !addEdge(e)) {
+          if (!r || !addLoadedEdge(e)) {
             cerr << __PRETTY_FUNCTION__ << ": Unable to add edge " << token;
             for (int l = 0; l < numV; ++l) {
               if (l > 0)
@@ -683,6 +707,475 @@ bool OptimizableGraph::save(ostream& os, int level) const
 }
 
 
+namespace {
+  const char binaryMagic[4] = {'G', '2', 'O', 'B'};
+  const int binaryVersion = 3; ///< version 2 added the encoding of the data records, version 3 stores the parameter ids as int
+  const int binaryTypeDefinition = -1; ///< record introducing a type id and its tag
+  const unsigned char binaryPayloadText = 0; ///< element stored by write()
+  const unsigned char binaryPayloadData = 1; ///< element stored by its estimate or measurement data
+  //! digits compared by binaryDataComplete(), conversions like quaternion -> matrix -> quaternion may change the last bits
+  const int binaryProbePrecision = 10;
+
+  template <typename T>
+  string writtenText(const T* element, stringstream& buffer)
+  {
+    buffer.str(string());
+    buffer.clear();
+    element->write(buffer);
+    return buffer.str();
+  }
+
+  //! the upper triangle of the information matrix and the parameter ids
+  void getEdgeData(const OptimizableGraph::Edge* e, vector<double>& measurement, vector<double>& information, vector<int>& parameters)
+  {
+    measurement.resize(max(0, e->measurementDimension()));
+    if (measurement.size() > 0)
+      e->getMeasurementData(&measurement[0]);
+    int d = e->dimension();
+    const double* info = e->informationData();
+    information.clear();
+    for (int c = 0; c < d; ++c)
+      for (int r = 0; r <= c; ++r)
+        information.push_back(info[c * d + r]);
+    parameters.resize(e->numParameters());
+    for (size_t i = 0; i < parameters.size(); ++i)
+      parameters[i] = e->parameterId(i);
+  }
+
+  bool setEdgeData(OptimizableGraph::Edge* e, const vector<double>& measurement, const vector<double>& information, const vector<int>& parameters)
+  {
+    int d = e->dimension();
+    if (static_cast<int>(measurement.size()) != e->measurementDimension() || static_cast<int>(information.size()) != d * (d + 1) / 2
+        || parameters.size() != e->numParameters())
+      return false;
+    if (measurement.size() > 0 && ! e->setMeasurementData(&measurement[0]))
+      return false;
+    double* info = e->informationData();
+    int k = 0;
+    for (int c = 0; c < d; ++c)
+      for (int r = 0; r <= c; ++r, ++k)
+        info[c * d + r] = info[r * d + c] = information[k];
+    for (size_t i = 0; i < parameters.size(); ++i)
+      e->setParameterId(i, parameters[i]);
+    return true;
+  }
+
+  /**
+   * writes the records of the binary format, the type of an element is
+   * defined by a separate record before its first use.
+   */
+  class BinaryWriter
+  {
+    public:
+      BinaryWriter(ostream& os, const OptimizableGraph* graph) : _os(os), _graph(graph), _factory(Factory::instance())
+      {
+        _text.precision(numeric_limits<double>::digits10 + 2);
+      }
+
+      void writeParameter(const Parameter* p)
+      {
+        if (! writeType(p))
+          return;
+        writeBinaryValue(_os, p->id());
+        writeBinaryString(_os, writtenText(p, _text));
+      }
+
+      bool writeVertex(OptimizableGraph::Vertex* v)
+      {
+        int typeId = writeType(v);
+        if (typeId < 0)
+          return true;
+        if (v->binaryEstimateData() && ! checkFirst(typeId, v)) {
+          cerr << __PRETTY_FUNCTION__ << ": the estimate data does not capture the vertex " << _factory->tag(typeId) << " " << v->id() << endl;
+          return false;
+        }
+        writeBinaryValue(_os, v->id());
+        writeBinaryValue(_os, static_cast<unsigned char>(v->fixed()));
+        if (v->binaryEstimateData()) {
+          writeBinaryValue(_os, binaryPayloadData);
+          v->getEstimateData(_values);
+          writeBinaryArray(_os, _values);
+        } else {
+          writeBinaryValue(_os, binaryPayloadText);
+          writeBinaryString(_os, writtenText(v, _text));
+        }
+        writeUserData(v->userData());
+        return true;
+      }
+
+      bool writeEdge(OptimizableGraph::Edge* e)
+      {
+        int typeId = writeType(e);
+        if (typeId < 0)
+          return true;
+        if (e->binaryMeasurementData() && ! checkFirst(typeId, e)) {
+          cerr << __PRETTY_FUNCTION__ << ": the measurement data does not capture the edge " << _factory->tag(typeId) << " " << e->id() << endl;
+          return false;
+        }
+        writeBinaryValue(_os, e->id());
+        writeBinaryValue(_os, static_cast<int>(e->vertices().size()));
+        for (vector<HyperGraph::Vertex*>::const_iterator it = e->vertices().begin(); it != e->vertices().end(); ++it) {
+          int vertexId = (*it) ? (*it)->id() : HyperGraph::UnassignedId;
+          writeBinaryValue(_os, vertexId);
+        }
+        if (e->binaryMeasurementData()) {
+          writeBinaryValue(_os, binaryPayloadData);
+          getEdgeData(e, _values, _information, _parameterIds);
+          writeBinaryArray(_os, _values);
+          writeBinaryArray(_os, _information);
+          writeBinaryArray(_os, _parameterIds);
+        } else {
+          writeBinaryValue(_os, binaryPayloadText);
+          writeBinaryString(_os, writtenText(e, _text));
+        }
+        writeUserData(e->userData());
+        return true;
+      }
+
+    protected:
+      int writeType(const HyperGraph::HyperGraphElement* e)
+      {
+        int typeId = _factory->typeId(e);
+        if (typeId < 0)
+          return -1;
+        if (typeId >= static_cast<int>(_typeState.size()))
+          _typeState.resize(typeId + 1, TypeUnknown);
+        if (_typeState[typeId] == TypeUnknown) {
+          _typeState[typeId] = TypeDefined;
+          writeBinaryValue(_os, binaryTypeDefinition);
+          writeBinaryValue(_os, typeId);
+          writeBinaryValue(_os, static_cast<int>(e->elementType()));
+          writeBinaryString(_os, _factory->tag(typeId));
+        }
+        writeBinaryValue(_os, typeId);
+        return typeId;
+      }
+
+      void writeUserData(HyperGraph::Data* d)
+      {
+        for (; d; d = d->next()) {
+          if (writeType(d) < 0)
+            continue;
+          _text.str(string());
+          _text.clear();
+          if (d->writeBinary(_text)) {
+            writeBinaryValue(_os, binaryPayloadData);
+            writeBinaryString(_os, _text.str());
+          } else {
+            writeBinaryValue(_os, binaryPayloadText);
+            writeBinaryString(_os, writtenText(d, _text));
+          }
+        }
+      }
+
+      //! checks the first element of a type opting in to be stored by its data, see OptimizableGraph::binaryDataComplete()
+      template <typename T>
+      bool checkFirst(int typeId, T* element)
+      {
+        if (_typeState[typeId] == TypeChecked)
+          return true;
+        _typeState[typeId] = TypeChecked;
+        return _graph->binaryDataComplete(element);
+      }
+
+      enum TypeState { TypeUnknown, TypeDefined, TypeChecked };
+      ostream& _os;
+      const OptimizableGraph* _graph;
+      Factory* _factory;
+      vector<TypeState> _typeState; ///< per type id, whether its definition was written and its data checked
+      stringstream _text;
+      vector<double> _values;
+      vector<double> _information;
+      vector<int> _parameterIds;
+  };
+}
+
+bool OptimizableGraph::saveBinary(const char* filename, int level) const
+{
+  ofstream ofs(filename, ios::binary);
+  if (!ofs)
+    return false;
+  return saveBinary(ofs, level);
+}
+
+bool OptimizableGraph::saveBinary(ostream& os, int level) const
+{
+  os.write(binaryMagic, sizeof(binaryMagic));
+  writeBinaryValue(os, binaryVersion);
+
+  BinaryWriter writer(os, this);
+  for (ParameterContainer::const_iterator it = _parameters.begin(); it != _parameters.end(); ++it)
+    writer.writeParameter(it->second);
+
+  set<Vertex*, VertexIDCompare> verticesToSave;
+  for (HyperGraph::EdgeSet::const_iterator it = edges().begin(); it != edges().end(); ++it) {
+    OptimizableGraph::Edge* e = static_cast<OptimizableGraph::Edge*>(*it);
+    if (e->level() == level) {
+      for (vector<HyperGraph::Vertex*>::const_iterator it = e->vertices().begin(); it != e->vertices().end(); ++it) {
+        if (*it)
+          verticesToSave.insert(static_cast<OptimizableGraph::Vertex*>(*it));
+      }
+    }
+  }
+  for (set<Vertex*, VertexIDCompare>::const_iterator it = verticesToSave.begin(); it != verticesToSave.end(); ++it)
+    if (! writer.writeVertex(*it))
+      return false;
+
+  EdgeContainer edgesToSave;
+  for (HyperGraph::EdgeSet::const_iterator it = edges().begin(); it != edges().end(); ++it) {
+    OptimizableGraph::Edge* e = static_cast<OptimizableGraph::Edge*>(*it);
+    if (e->level() == level)
+      edgesToSave.push_back(e);
+  }
+  sort(edgesToSave.begin(), edgesToSave.end(), EdgeIDCompare());
+  for (EdgeContainer::const_iterator it = edgesToSave.begin(); it != edgesToSave.end(); ++it)
+    if (! writer.writeEdge(*it))
+      return false;
+
+  return os.good();
+}
+
+bool OptimizableGraph::binaryDataComplete(Vertex* v) const
+{
+  Factory* factory = Factory::instance();
+  Vertex* probe = dynamic_cast<Vertex*>(factory->construct(factory->typeId(v)));
+  vector<double> estimate;
+  stringstream vText, probeText;
+  vText.precision(binaryProbePrecision);
+  probeText.precision(binaryProbePrecision);
+  bool result = probe && v->estimateDimension() >= 0 && v->getEstimateData(estimate)
+    && (estimate.empty() || probe->setEstimateData(estimate))
+    && v->write(vText) && probe->write(probeText) && vText.str() == probeText.str();
+  delete probe;
+  return result;
+}
+
+bool OptimizableGraph::binaryDataComplete(Edge* e) const
+{
+  Factory* factory = Factory::instance();
+  Edge* probe = dynamic_cast<Edge*>(factory->construct(factory->typeId(e)));
+  bool result = false;
+  if (probe && e->measurementDimension() >= 0) {
+    if (probe->vertices().size() != e->vertices().size())
+      probe->resize(e->vertices().size());
+    for (size_t i = 0; i < e->vertices().size(); ++i)
+      probe->setVertex(i, e->vertex(i));
+    vector<double> measurement, information;
+    vector<int> parameterIds;
+    getEdgeData(e, measurement, information, parameterIds);
+    // the probe is not added to the graph, but write() may need the parameters
+    if (setEdgeData(probe, measurement, information, parameterIds) && probe->resolveParameters()) {
+      stringstream eText, probeText;
+      eText.precision(binaryProbePrecision);
+      probeText.precision(binaryProbePrecision);
+      result = e->write(eText) && probe->write(probeText) && eText.str() == probeText.str();
+    }
+  }
+  delete probe;
+  return result;
+}
+
+bool OptimizableGraph::loadBinary(const char* filename)
+{
+  ifstream ifs(filename, ios::binary);
+  if (!ifs) {
+    cerr << __PRETTY_FUNCTION__ << " unable to open file " << filename << endl;
+    return false;
+  }
+  return loadBinary(ifs);
+}
+
+bool OptimizableGraph::loadBinary(istream& is)
+{
+  if (_vertices.empty() && ! _denseVertexIds)
+    setDenseVertexIds(true);
+
+  char magic[sizeof(binaryMagic)];
+  int version;
+  is.read(magic, sizeof(magic));
+  if (! is.good() || ! equal(magic, magic + sizeof(magic), binaryMagic) || ! readBinaryValue(is, version) || version < 1 || version > binaryVersion) {
+    cerr << __PRETTY_FUNCTION__ << ": not a binary g2o file or unsupported version" << endl;
+    return false;
+  }
+
+  Factory* factory = Factory::instance();
+  vector<int> localTypeIds;    // type id of the file -> type id of the factory, -1 if unknown
+  vector<int> elementTypes;    // type id of the file -> HyperGraph::HyperGraphElementType
+  vector<string> tags;         // type id of the file -> tag, for the error messages
+  set<string> warnedUnknownTypes;
+  stringstream payload;
+  string payloadString;
+  vector<int> ids;
+  vector<double> values, information;
+  vector<int> parameterIds;
+  vector<double> legacyParameterIds; // version 2 stored the parameter ids as double
+
+  HyperGraph::DataContainer* previousDataContainer = 0;
+  Data* previousData = 0;
+
+  int fileTypeId;
+  while (readBinaryValue(is, fileTypeId)) {
+    if (fileTypeId == binaryTypeDefinition) {
+      int elementType;
+      string tag;
+      if (! readBinaryValue(is, fileTypeId) || fileTypeId < 0 || ! readBinaryValue(is, elementType) || ! readBinaryString(is, tag))
+        return false;
+      if (fileTypeId >= static_cast<int>(localTypeIds.size())) {
+        localTypeIds.resize(fileTypeId + 1, -1);
+        elementTypes.resize(fileTypeId + 1, -1);
+        tags.resize(fileTypeId + 1);
+      }
+      map<string, string>::const_iterator foundIt = _renamedTypesLookup.find(tag);
+      localTypeIds[fileTypeId] = factory->typeId(foundIt != _renamedTypesLookup.end() ? foundIt->second : tag);
+      elementTypes[fileTypeId] = elementType;
+      tags[fileTypeId] = tag;
+      continue;
+    }
+    if (fileTypeId < 0 || fileTypeId >= static_cast<int>(elementTypes.size()) || elementTypes[fileTypeId] < 0) {
+      cerr << __PRETTY_FUNCTION__ << ": record of undefined type " << fileTypeId << endl;
+      return false;
+    }
+
+    // read the whole record first, the type may be unknown and the record skipped
+    int elementType = elementTypes[fileTypeId];
+    int id = 0;
+    unsigned char fixed = 0;
+    unsigned char encoding = binaryPayloadText;
+    ids.clear();
+    bool ok = true;
+    if (elementType == HyperGraph::HGET_PARAMETER) {
+      ok = readBinaryValue(is, id);
+    } else if (elementType == HyperGraph::HGET_VERTEX) {
+      ok = readBinaryValue(is, id) && readBinaryValue(is, fixed) && readBinaryValue(is, encoding);
+    } else if (elementType == HyperGraph::HGET_EDGE) {
+      int numV;
+      ok = readBinaryValue(is, id) && readBinaryValue(is, numV) && numV >= 0;
+      if (ok) {
+        ids.resize(numV);
+        for (int l = 0; l < numV && ok; ++l)
+          ok = readBinaryValue(is, ids[l]);
+      }
+      ok = ok && readBinaryValue(is, encoding);
+    } else if (elementType == HyperGraph::HGET_DATA && version > 1) {
+      ok = readBinaryValue(is, encoding);
+    }
+    if (ok && encoding == binaryPayloadData && elementType != HyperGraph::HGET_DATA) {
+      ok = readBinaryArray(is, values);
+      if (ok && elementType == HyperGraph::HGET_EDGE) {
+        ok = readBinaryArray(is, information);
+        if (ok && version < 3) {
+          ok = readBinaryArray(is, legacyParameterIds);
+          parameterIds.assign(legacyParameterIds.begin(), legacyParameterIds.end());
+        } else if (ok) {
+          ok = readBinaryArray(is, parameterIds);
+        }
+      }
+    } else if (ok) {
+      ok = readBinaryString(is, payloadString);
+      payload.str(payloadString);
+      payload.clear();
+    }
+    if (! ok) {
+      cerr << __PRETTY_FUNCTION__ << ": unexpected end of file" << endl;
+      return false;
+    }
+
+    HyperGraph::HyperGraphElement* element = factory->construct(localTypeIds[fileTypeId]);
+    if (! element) {
+      if (warnedUnknownTypes.insert(tags[fileTypeId]).second)
+        cerr << CL_RED(__PRETTY_FUNCTION__ << " unknown type: " << tags[fileTypeId]) << endl;
+      continue;
+    }
+
+    switch (element->elementType()) {
+      case HyperGraph::HGET_PARAMETER:
+        {
+          Parameter* p = static_cast<Parameter*>(element);
+          p->setId(id);
+          if (! p->read(payload) || ! _parameters.addParameter(p)) {
+            cerr << __PRETTY_FUNCTION__ << ": Error reading parameter " << tags[fileTypeId] << " " << id << endl;
+            delete p;
+          }
+          break;
+        }
+      case HyperGraph::HGET_VERTEX:
+        {
+          previousData = 0;
+          previousDataContainer = 0;
+          Vertex* v = static_cast<Vertex*>(element);
+          bool r = encoding == binaryPayloadData ? values.empty() || v->setEstimateData(values) : v->read(payload);
+          if (! r)
+            cerr << __PRETTY_FUNCTION__ << ": Error reading vertex " << tags[fileTypeId] << " " << id << endl;
+          v->setId(id);
+          v->setFixed(fixed != 0);
+          if (! addVertex(v)) {
+            cerr << __PRETTY_FUNCTION__ << ": Failure adding Vertex, " << tags[fileTypeId] << " " << id << endl;
+            delete v;
+          } else {
+            previousDataContainer = v;
+          }
+          break;
+        }
+      case HyperGraph::HGET_EDGE:
+        {
+          previousData = 0;
+          previousDataContainer = 0;
+          Edge* e = static_cast<Edge*>(element);
+          e->setId(id);
+          if (e->vertices().size() != ids.size())
+            e->resize(ids.size());
+          bool vertsOkay = e->vertices().size() == ids.size();
+          for (size_t l = 0; vertsOkay && l < ids.size(); ++l) {
+            if (ids[l] == HyperGraph::UnassignedId)
+              continue;
+            HyperGraph::Vertex* v = vertex(ids[l]);
+            vertsOkay = v != 0;
+            e->setVertex(l, v);
+          }
+          bool r = vertsOkay && (encoding == binaryPayloadData ? setEdgeData(e, values, information, parameterIds) : e->read(payload));
+          if (! r || ! addLoadedEdge(e)) {
+            cerr << __PRETTY_FUNCTION__ << ": Unable to add edge " << tags[fileTypeId];
+            for (size_t l = 0; l < ids.size(); ++l)
+              cerr << " " << ids[l];
+            cerr << endl;
+            delete e;
+          } else {
+            previousDataContainer = e;
+          }
+          break;
+        }
+      case HyperGraph::HGET_DATA:
+        {
+          Data* d = static_cast<Data*>(element);
+          bool r = encoding == binaryPayloadData ? d->readBinary(payload) : d->read(payload);
+          if (! r) {
+            cerr << __PRETTY_FUNCTION__ << ": Error reading data " << tags[fileTypeId] << endl;
+            delete d;
+            previousData = 0;
+          } else if (previousData) {
+            previousData->setNext(d);
+            d->setDataContainer(previousData->dataContainer());
+            previousData = d;
+          } else if (previousDataContainer) {
+            previousDataContainer->setUserData(d);
+            d->setDataContainer(previousDataContainer);
+            previousData = d;
+            previousDataContainer = 0;
+          } else {
+            cerr << __PRETTY_FUNCTION__ << ": got data element, but no data container available" << endl;
+            delete d;
+          }
+          break;
+        }
+      default:
+        delete element;
+        break;
+    }
+  }
+
+  return is.eof();
+}
+
 bool OptimizableGraph::saveSubset(ostream& os, HyperGraph::VertexSet& vset, int level)
 {
   if (! _parameters.write(os))
@@ -950,8 +1443,8 @@ bool OptimizableGraph::verifyInformationMatrices(bool verbose) const
   bool allEdgeOk = true;
   Eigen::SelfAdjointEigenSolver<MatrixXD> eigenSolver;
   for (OptimizableGraph::EdgeSet::const_iterator it = edges().begin(); it != edges().end(); ++it) {
-    OptimizableGraph::Edge* e = static_cast<OptimizableGraph::Edge*>(*it);
-    MatrixXD::MapType information(e->informationData(), e->dimension(), e->dimension());
+    const OptimizableGraph::Edge* e = static_cast<const OptimizableGraph::Edge*>(*it);
+    MatrixXD::ConstMapType information(e->informationData(), e->dimension(), e->dimension());
     // test on symmetry
     bool isSymmetric = information.transpose() == information;
     bool okay = isSymmetric;
@@ -35,6 +35,7 @@
 #include <typeinfo>
 
 #include "openmp_mutex.h"
+#include "memory_pool.h"
 #include "hyper_graph.h"
 #include "parameter.h"
 #include "parameter_container.h"
@@ -50,6 +51,7 @@ namespace g2o {
   class Cache;
   class CacheContainer;
   class RobustKernel;
+  class InformationPool;
 
   /**
      @addtogroup g2o
@@ -194,6 +196,13 @@ namespace g2o {
          */
         virtual int estimateDimension() const;
 
+        /**
+         * true, if the estimate data captures everything written by write(),
+         * such that OptimizableGraph::saveBinary() may store the vertex by
+         * its estimate data. Types opt in by redefining it.
+         */
+        virtual bool binaryEstimateData() const { return false;}
+
         /**
          * sets the initial estimate from an array of double.
          * Implement setMinimalEstimateDataImpl()
@@ -373,6 +382,14 @@ namespace g2o {
         //! by get/setMeasurement;
         virtual int measurementDimension() const;
 
+        /**
+         * true, if the measurement data, the information matrix, and the
+         * parameter ids capture everything written by write(), such that
+         * OptimizableGraph::saveBinary() may store the edge by this data.
+         * Types opt in by redefining it.
+         */
+        virtual bool binaryMeasurementData() const { return false;}
+
         /**
          * sets the estimate to have a zero error, based on the current value of the state variables
          * returns false if not supported.
@@ -394,6 +411,26 @@ namespace g2o {
         virtual const double* informationData() const = 0;
         virtual double* informationData() = 0;
 
+        /**
+         * Enables the square root form of the information matrix. The edge then
+         * stores the upper triangular factor U with Omega = U^T U and builds
+         * the quadratic form from the whitened error U e and the whitened
+         * Jacobians U J. Returns false if the edge does not support it.
+         */
+        virtual bool setUseSqrtInformation(bool use) { (void) use; return false;}
+        //! true, if the square root form of the information matrix is used
+        virtual bool useSqrtInformation() const { return false;}
+
+        /**
+         * lets the edge reference the matrix of the pool which equals its
+         * information matrix instead of its own copy, or adds a copy of its
+         * matrix to the pool. Modifying the information afterwards detaches
+         * the edge again. Returns true if the edge now references the pool.
+         */
+        virtual bool shareInformation(InformationPool& pool) { (void) pool; return false;}
+        //! true, if the information matrix is referenced by other edges as well
+        virtual bool informationShared() const { return false;}
+
         //! computes the chi2 based on the cached error value, only valid after computeError has been called.
         virtual double chi2() const = 0;
 
@@ -455,7 +492,11 @@ namespace g2o {
         const OptimizableGraph* graph() const;
 
         bool setParameterId(int argNum, int paramId);
+        //! the id of the parameter argNo, -1 if not specified
+        int parameterId(int argNo) const { return _parameterIds.at(argNo);}
         inline const Parameter* parameter(int argNo) const {return *_parameters.at(argNo);}
+        //! the type of the parameter argNo as given by typeid(ParameterType).name()
+        const std::string& parameterType(int argNo) const { return _parameterTypes.at(argNo);}
         inline size_t numParameters() const {return _parameters.size();}
         inline void resizeParameters(size_t newSize) {
           _parameters.resize(newSize, 0);
@@ -564,6 +605,15 @@ namespace g2o {
     //! discard the last backup of the estimate for all variables by removing it from the stack
     virtual void discardTop();
 
+    /**
+     * lets the edges loaded by load() or loadBinary() share identical
+     * information matrices through the given pool, see
+     * Edge::shareInformation(). The pool is not owned by the graph, 0
+     * (the default) keeps an information matrix in each edge.
+     */
+    void setInformationPool(InformationPool* pool) { _informationPool = pool;}
+    InformationPool* informationPool() const { return _informationPool;}
+
     //! load the graph from a stream. Uses the Factory singleton for creating the vertices and edges.
     virtual bool load(std::istream& is, bool createEdges=true);
     bool load(const char* filename, bool createEdges=true);
@@ -572,6 +622,39 @@ namespace g2o {
     //! function provided for convenience, see save() above
     bool save(const char* filename, int level = 0) const;
 
+    /**
+     * save the graph in a binary format. Each record starts with the integer
+     * type id of the Factory, the tag of a type is written once before its
+     * first record. Ids, vertex ids and the fixed flag are stored in binary.
+     * Vertices are stored by their estimate data, edges by measurement data,
+     * information matrix and parameter ids, if the type opts in by
+     * Vertex::binaryEstimateData() or Edge::binaryMeasurementData().
+     * Otherwise, and for parameters, the output of write() is stored. Data is
+     * stored by Data::writeBinary() if the type supports it and by write() otherwise.
+     * @return false, if the data of the first element of an opting in type does
+     * not capture the element, see binaryDataComplete()
+     */
+    bool saveBinary(std::ostream& os, int level = 0) const;
+    //! function provided for convenience, see saveBinary() above
+    bool saveBinary(const char* filename, int level = 0) const;
+    /**
+     * true, if a new vertex of the same type with the estimate data of v
+     * writes the same as v up to rounding. Checks a type opting in by
+     * Vertex::binaryEstimateData(), see saveBinary()
+     */
+    bool binaryDataComplete(Vertex* v) const;
+    /**
+     * true, if a new edge of the same type with measurement data, information
+     * matrix and parameter ids of e writes the same as e up to rounding.
+     * Checks a type opting in by Edge::binaryMeasurementData(), see
+     * saveBinary()
+     */
+    bool binaryDataComplete(Edge* e) const;
+    //! load a graph stored by saveBinary()
+    bool loadBinary(std::istream& is);
+    //! function provided for convenience, see loadBinary() above
+    bool loadBinary(const char* filename);
+
 
     //! save a subgraph to a stream. Again uses the Factory system.
     bool saveSubset(std::ostream& os, HyperGraph::VertexSet& vset, int level = 0);
@@ -624,6 +707,7 @@ namespace g2o {
      */
     bool verifyInformationMatrices(bool verbose = false) const;
 
+
     // helper functions to save an individual vertex
     bool saveVertex(std::ostream& os, Vertex* v) const;
 
@@ -661,6 +745,10 @@ namespace g2o {
 
     ParameterContainer _parameters;
     JacobianWorkspace _jacobianWorkspace;
+    InformationPool* _informationPool;
+
+    //! adds an edge read by load() or loadBinary(), sharing its information if a pool is set
+    bool addLoadedEdge(Edge* e);
   };
 
   /**
@@ -40,6 +40,7 @@ namespace g2o {
     _solver(solver)
   {
     _writeDebug = _properties.makeProperty<Property<bool> >("writeDebug", true);
+    _mixedPrecision = _properties.makeProperty<Property<bool> >("mixedPrecision", false);
   }
 
   OptimizationAlgorithmWithHessian::~OptimizationAlgorithmWithHessian()
@@ -52,6 +53,7 @@ namespace g2o {
     assert(_optimizer && "_optimizer not set");
     assert(_solver && "Solver not set");
     _solver->setWriteDebug(_writeDebug->value());
+    _solver->setSinglePrecision(_mixedPrecision->value());
     bool useSchur=false;
     for (OptimizableGraph::VertexContainer::const_iterator it=_optimizer->activeVertices().begin(); it!=_optimizer->activeVertices().end(); ++it) {
       OptimizableGraph::Vertex* v= *it;
@@ -98,4 +100,9 @@ namespace g2o {
     _writeDebug->setValue(writeDebug);
   }
 
+  void OptimizationAlgorithmWithHessian::setMixedPrecision(bool mixedPrecision)
+  {
+    _mixedPrecision->setValue(mixedPrecision);
+  }
+
 } // end namespace
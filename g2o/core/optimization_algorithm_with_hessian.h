@@ -62,9 +62,17 @@ namespace g2o {
       virtual void setWriteDebug(bool writeDebug);
       virtual bool writeDebug() const { return _writeDebug->value();}
 
+      /**
+       * factorize in single precision with iterative refinement in double
+       * precision, if the linear solver supports it. Off by default.
+       */
+      virtual void setMixedPrecision(bool mixedPrecision);
+      virtual bool mixedPrecision() const { return _mixedPrecision->value();}
+
     protected:
       Solver* _solver;
       Property<bool>* _writeDebug;
+      Property<bool>* _mixedPrecision;
 
   };
 
@@ -66,6 +66,9 @@ namespace g2o {
 
       // stuff of the base class that should re-appear
       using BaseClass::size;
+      using BaseClass::const_iterator;
+      using BaseClass::begin;
+      using BaseClass::end;
 
     protected:
       bool _isMainStorage;
@@ -129,6 +129,13 @@ namespace g2o {
       virtual void setWriteDebug(bool) = 0;
       virtual bool writeDebug() const = 0;
 
+      /**
+       * factorize the system in single precision and refine the solution
+       * against the double precision system, if the linear solver supports it
+       */
+      virtual void setSinglePrecision(bool) = 0;
+      virtual bool singlePrecision() const = 0;
+
       //! write the hessian to disk using the specified file name
       virtual bool saveHessian(const std::string& /*fileName*/) const = 0;
 
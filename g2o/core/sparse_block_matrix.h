@@ -37,7 +37,9 @@
 
 #include "sparse_block_matrix_ccs.h"
 #include "matrix_structure.h"
+#include "sparse_index.h"
 #include "matrix_operations.h"
+#include "memory_pool.h"
 #include "g2o/config.h"
 
 namespace g2o {
@@ -162,13 +164,13 @@ class SparseBlockMatrix {
     /**
      * fill the CCS arrays of a matrix, arrays have to be allocated beforehand
      */
-    int fillCCS(int* Cp, int* Ci, double* Cx, bool upperTriangle = false) const;
+    SparseIndex fillCCS(SparseIndex* Cp, SparseIndex* Ci, double* Cx, bool upperTriangle = false) const;
 
     /**
      * fill the CCS arrays of a matrix, arrays have to be allocated beforehand. This function only writes
      * the values and assumes that column and row structures have already been written.
      */
-    int fillCCS(double* Cx, bool upperTriangle = false) const;
+    SparseIndex fillCCS(double* Cx, bool upperTriangle = false) const;
 
     //! exports the non zero blocks in the structure matrix ms
     void fillBlockStructure(MatrixStructure& ms) const;
@@ -72,7 +72,7 @@ namespace g2o {
       for (typename SparseBlockMatrix<MatrixType>::IntBlockMap::const_iterator it=_blockCols[i].begin(); it!=_blockCols[i].end(); ++it){
         typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock* b=it->second;
         if (_hasStorage && dealloc)
-          delete b;
+          deletePooled(b);
         else
           b->setZero();
       }
@@ -97,7 +97,7 @@ namespace g2o {
       else {
         int rb=rowsOfBlock(r);
         int cb=colsOfBlock(c);
-        _block=new typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock(rb,cb);
+        _block=newPooled<typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock>(rb,cb);
         _block->setZero();
         std::pair < typename SparseBlockMatrix<MatrixType>::IntBlockMap::iterator, bool> result
           =_blockCols[c].insert(std::make_pair(r,_block)); (void) result;
@@ -123,7 +123,7 @@ namespace g2o {
     SparseBlockMatrix* ret= new SparseBlockMatrix(&_rowBlockIndices[0], &_colBlockIndices[0], _rowBlockIndices.size(), _colBlockIndices.size());
     for (size_t i=0; i<_blockCols.size(); ++i){
       for (typename SparseBlockMatrix<MatrixType>::IntBlockMap::const_iterator it=_blockCols[i].begin(); it!=_blockCols[i].end(); ++it){
-        typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock* b=new typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock(*it->second);
+        typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock* b=newPooled<typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock>(*it->second);
         ret->_blockCols[i].insert(std::make_pair(it->first, b));
       }
     }
@@ -340,7 +340,7 @@ namespace g2o {
       int mc=cmin+i;
       for (typename SparseBlockMatrix<MatrixType>::IntBlockMap::const_iterator it=_blockCols[mc].begin(); it!=_blockCols[mc].end(); ++it){
         if (it->first >= rmin && it->first < rmax){
-          typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock* b = alloc ? new typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock (* (it->second) ) : it->second;
+          typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock* b = alloc ? newPooled<typename SparseBlockMatrix<MatrixType>::SparseMatrixBlock>(* (it->second) ) : it->second;
           s->_blockCols[i].insert(std::make_pair(it->first-rmin, b));
         }
       }
@@ -461,7 +461,7 @@ namespace g2o {
   }
 
   template <class MatrixType>
-  int SparseBlockMatrix<MatrixType>::fillCCS(double* Cx, bool upperTriangle) const
+  SparseIndex SparseBlockMatrix<MatrixType>::fillCCS(double* Cx, bool upperTriangle) const
   {
     assert(Cx && "Target destination is NULL");
     double* CxStart = Cx;
@@ -486,10 +486,10 @@ namespace g2o {
   }
 
   template <class MatrixType>
-  int SparseBlockMatrix<MatrixType>::fillCCS(int* Cp, int* Ci, double* Cx, bool upperTriangle) const
+  SparseIndex SparseBlockMatrix<MatrixType>::fillCCS(SparseIndex* Cp, SparseIndex* Ci, double* Cx, bool upperTriangle) const
   {
     assert(Cp && Ci && Cx && "Target destination is NULL");
-    int nz=0;
+    SparseIndex nz=0;
     for (size_t i=0; i<_blockCols.size(); ++i){
       int cstart=i ? _colBlockIndices[i-1] : 0;
       int csize=colsOfBlock(i);
@@ -524,9 +524,9 @@ namespace g2o {
     ms.alloc(n, nzMax);
     ms.m = _rowBlockIndices.size();
 
-    int nz = 0;
-    int* Cp = ms.Ap;
-    int* Ci = ms.Aii;
+    SparseIndex nz = 0;
+    SparseIndex* Cp = ms.Ap;
+    SparseIndex* Ci = ms.Aii;
     for (int i = 0; i < static_cast<int>(_blockCols.size()); ++i){
       *Cp = nz;
       const int& c = i;
@@ -33,6 +33,8 @@
 
 #include "g2o/config.h"
 #include "matrix_operations.h"
+#include "sparse_index.h"
+#include "memory_pool.h"
 
 #include <unordered_map>
 
@@ -136,10 +138,10 @@ namespace g2o {
       /**
        * fill the CCS arrays of a matrix, arrays have to be allocated beforehand
        */
-      int fillCCS(int* Cp, int* Ci, double* Cx, bool upperTriangle = false) const
+      SparseIndex fillCCS(SparseIndex* Cp, SparseIndex* Ci, double* Cx, bool upperTriangle = false) const
       {
         assert(Cp && Ci && Cx && "Target destination is NULL");
-        int nz=0;
+        SparseIndex nz=0;
         for (size_t i=0; i<_blockCols.size(); ++i){
           int cstart=i ? _colBlockIndices[i-1] : 0;
           int csize=colsOfBlock(i);
@@ -169,7 +171,7 @@ namespace g2o {
        * fill the CCS arrays of a matrix, arrays have to be allocated beforehand. This function only writes
        * the values and assumes that column and row structures have already been written.
        */
-      int fillCCS(double* Cx, bool upperTriangle = false) const
+      SparseIndex fillCCS(double* Cx, bool upperTriangle = false) const
       {
         assert(Cx && "Target destination is NULL");
         double* CxStart = Cx;
@@ -194,6 +196,35 @@ namespace g2o {
         return Cx - CxStart;
       }
 
+      /**
+       * fill an array with the addresses of the values in the same order as fillCCS() writes them.
+       * Allows to read the values of the blocks in place as long as the structure does not change.
+       */
+      SparseIndex fillValuePointers(const double** Cx, bool upperTriangle = false) const
+      {
+        assert(Cx && "Target destination is NULL");
+        const double** CxStart = Cx;
+        int cstart = 0;
+        for (size_t i=0; i<_blockCols.size(); ++i){
+          int csize = _colBlockIndices[i] - cstart;
+          for (int c=0; c<csize; ++c) {
+            for (typename SparseColumn::const_iterator it = _blockCols[i].begin(); it!=_blockCols[i].end(); ++it) {
+              const SparseMatrixBlock* b = it->block;
+              int rstart = it->row ? _rowBlockIndices[it->row-1] : 0;
+
+              int elemsToCopy = b->rows();
+              if (upperTriangle && rstart == cstart)
+                elemsToCopy = c + 1;
+              const double* column = b->data() + c*b->rows();
+              for (int r=0; r<elemsToCopy; ++r)
+                *Cx++ = column + r;
+            }
+          }
+          cstart = _colBlockIndices[i];
+        }
+        return Cx - CxStart;
+      }
+
     protected:
       const std::vector<int>& _rowBlockIndices; ///< vector of the indices of the blocks along the rows.
       const std::vector<int>& _colBlockIndices; ///< vector of the indices of the blocks along the cols
@@ -258,7 +289,7 @@ namespace g2o {
         if (foundIt == sparseColumn.end()) {
           int rb = rowsOfBlock(r);
           int cb = colsOfBlock(c);
-          MatrixType* m = new MatrixType(rb, cb);
+          MatrixType* m = newPooled<MatrixType>(rb, cb);
           if (zeroBlock)
             m->setZero();
           sparseColumn[r] = m;
@@ -0,0 +1,56 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef G2O_SPARSE_INDEX_H
+#define G2O_SPARSE_INDEX_H
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include "g2o/config.h"
+
+namespace g2o {
+
+  /**
+   * integer type of the scalar column pointers and row indices of the
+   * sparse matrices handed to the linear solvers (CCS format). With
+   * G2O_USE_64BIT_INDEX it matches the long interface of CHOLMOD and the
+   * default csi of CSparse, which allows more than 2^31 non-zeros. The
+   * block indices and the scalar dimension of the matrices remain int.
+   */
+#ifdef G2O_USE_64BIT_INDEX
+  typedef std::ptrdiff_t SparseIndex;
+#else
+  typedef int SparseIndex;
+#endif
+
+  typedef Eigen::Matrix<SparseIndex,Eigen::Dynamic,1,Eigen::ColMajor> VectorXSparseIndex;
+
+} // end namespace
+
+#endif
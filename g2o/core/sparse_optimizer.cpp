@@ -32,8 +32,10 @@
 #include <iterator>
 #include <cassert>
 #include <algorithm>
+#include <limits>
 
 #include "estimate_propagator.h"
+#include "hyper_dijkstra.h"
 #include "optimization_algorithm.h"
 #include "batch_stats.h"
 #include "hyper_graph_action.h"
@@ -46,9 +48,29 @@
 namespace g2o{
   using namespace std;
 
+  namespace {
+    /**
+     * \brief only traverse the edges which are active in the optimizer
+     */
+    class ActiveEdgeCostFunction : public HyperDijkstra::CostFunction {
+      public:
+        ActiveEdgeCostFunction(const SparseOptimizer* optimizer) : _optimizer(optimizer) {}
+        virtual double operator()(HyperGraph::Edge* edge, HyperGraph::Vertex* /*from*/, HyperGraph::Vertex* /*to*/)
+        {
+          OptimizableGraph::Edge* e = static_cast<OptimizableGraph::Edge*>(edge);
+          if (_optimizer->findActiveEdge(e) == _optimizer->activeEdges().end())
+            return std::numeric_limits<double>::max();
+          return 1.;
+        }
+      protected:
+        const SparseOptimizer* _optimizer;
+    };
+  } // end anonymous namespace
+
 
   SparseOptimizer::SparseOptimizer() :
-    _forceStopFlag(0), _verbose(false), _algorithm(0), _computeBatchStatistics(false)
+    _forceStopFlag(0), _verbose(false),
+    _algorithm(0), _computeBatchStatistics(false)
   {
     _graphActions.resize(AT_NUM_ELEMENTS);
   }
@@ -153,7 +175,8 @@ namespace g2o{
           return false;
         }
         // test for full dimension prior
-        for (HyperGraph::EdgeSet::const_iterator eit = v->edges().begin(); eit != v->edges().end(); ++eit) {
+        HyperGraph::Adjacency::EdgeRange vEdges = adjacency().edges(v);
+        for (HyperGraph::Adjacency::const_iterator eit = vEdges.begin(); eit != vEdges.end(); ++eit) {
           OptimizableGraph::Edge* e = static_cast<OptimizableGraph::Edge*>(*eit);
           if (e->vertices().size() == 1 && e->dimension() == maxDim)
             return false;
@@ -215,13 +238,14 @@ namespace g2o{
     _activeVertices.clear();
     _activeVertices.reserve(vset.size());
     _activeEdges.clear();
-    set<Edge*> auxEdgeSet; // temporary structure to avoid duplicates
+    const HyperGraph::Adjacency& adj = adjacency();
+    vector<Edge*> auxEdges; // collects the edges, duplicates are removed below
     for (HyperGraph::VertexSet::iterator it=vset.begin(); it!=vset.end(); ++it){
       OptimizableGraph::Vertex* v= (OptimizableGraph::Vertex*) *it;
-      const OptimizableGraph::EdgeSet& vEdges=v->edges();
+      HyperGraph::Adjacency::EdgeRange vEdges=adj.edges(v);
       // count if there are edges in that level. If not remove from the pool
       int levelEdges=0;
-      for (OptimizableGraph::EdgeSet::const_iterator it=vEdges.begin(); it!=vEdges.end(); ++it){
+      for (HyperGraph::Adjacency::const_iterator it=vEdges.begin(); it!=vEdges.end(); ++it){
         OptimizableGraph::Edge* e=reinterpret_cast<OptimizableGraph::Edge*>(*it);
         if (level < 0 || e->level() == level) {
 
@@ -233,7 +257,7 @@ namespace g2o{
             }
           }
           if (allVerticesOK && !e->allVerticesFixed()) {
-            auxEdgeSet.insert(e);
+            auxEdges.push_back(e);
             levelEdges++;
           }
 
@@ -259,12 +283,13 @@ namespace g2o{
       }
     }
 
-    _activeEdges.reserve(auxEdgeSet.size());
-    for (set<Edge*>::iterator it = auxEdgeSet.begin(); it != auxEdgeSet.end(); ++it)
-      _activeEdges.push_back(*it);
+    std::sort(auxEdges.begin(), auxEdges.end());
+    auxEdges.erase(std::unique(auxEdges.begin(), auxEdges.end()), auxEdges.end());
+    _activeEdges.swap(auxEdges);
 
     sortVectorContainers();
     bool indexMappingStatus = buildIndexMapping(_activeVertices);
+    _activeComponents.clear();
     postIteration(-1);
     return indexMappingStatus;
   }
@@ -294,6 +319,7 @@ namespace g2o{
 
     sortVectorContainers();
     bool indexMappingStatus = buildIndexMapping(_activeVertices);
+    _activeComponents.clear();
     postIteration(-1);
     return indexMappingStatus;
   }
@@ -316,6 +342,7 @@ namespace g2o{
     OptimizableGraph::VertexSet emptySet;
     std::set<Vertex*> backupVertices;
     HyperGraph::VertexSet fixedVertices; // these are the root nodes where to start the initialization
+    const HyperGraph::Adjacency& adj = adjacency();
     for (EdgeContainer::iterator it = _activeEdges.begin(); it != _activeEdges.end(); ++it) {
       OptimizableGraph::Edge* e = *it;
       for (size_t i = 0; i < e->vertices().size(); ++i) {
@@ -325,7 +352,8 @@ namespace g2o{
         if (v->fixed())
           fixedVertices.insert(v);
         else { // check for having a prior which is able to fully initialize a vertex
-          for (EdgeSet::const_iterator vedgeIt = v->edges().begin(); vedgeIt != v->edges().end(); ++vedgeIt) {
+          HyperGraph::Adjacency::EdgeRange vEdges = adj.edges(v);
+          for (HyperGraph::Adjacency::const_iterator vedgeIt = vEdges.begin(); vedgeIt != vEdges.end(); ++vedgeIt) {
             OptimizableGraph::Edge* vedge = static_cast<OptimizableGraph::Edge*>(*vedgeIt);
             if (vedge->vertices().size() == 1 && vedge->initialEstimatePossible(emptySet, v) > 0.) {
               //cerr << "Initialize with prior for " << v->id() << endl;
@@ -345,7 +373,11 @@ namespace g2o{
     }
 
     EstimatePropagator estimatePropagator(this);
+#   ifdef G2O_OPENMP
+    estimatePropagator.propagateComponents(fixedVertices, costFunction);
+#   else
     estimatePropagator.propagate(fixedVertices, costFunction);
+#   endif
 
     // restoring the vertices that should not be initialized
     for (std::set<Vertex*>::iterator it = backupVertices.begin(); it != backupVertices.end(); ++it) {
@@ -368,6 +400,15 @@ namespace g2o{
       return -1;
     }
 
+    _batchStatistics.clear();
+    if (_computeBatchStatistics)
+      _batchStatistics.resize(iterations);
+
+    return runAlgorithm(iterations, online, _batchStatistics);
+  }
+
+  int SparseOptimizer::runAlgorithm(int iterations, bool online, BatchStatisticsContainer& statistics)
+  {
     int cjIterations=0;
     double cumTime=0;
     bool ok=true;
@@ -378,16 +419,12 @@ namespace g2o{
       return -1;
     }
 
-    _batchStatistics.clear();
-    if (_computeBatchStatistics)
-      _batchStatistics.resize(iterations);
-    
     OptimizationAlgorithm::SolverResult result = OptimizationAlgorithm::OK;
     for (int i=0; i<iterations && ! terminate() && ok; i++){
       preIteration(i);
 
       if (_computeBatchStatistics) {
-        G2OBatchStatistics& cstat = _batchStatistics[i];
+        G2OBatchStatistics& cstat = statistics[i];
         G2OBatchStatistics::setGlobalStats(&cstat);
         cstat.iteration = i;
         cstat.numEdges =  _activeEdges.size();
@@ -402,8 +439,8 @@ namespace g2o{
       if (_computeBatchStatistics) {
         computeActiveErrors();
         errorComputed = true;
-        _batchStatistics[i].chi2 = activeRobustChi2();
-        _batchStatistics[i].timeIteration = get_monotonic_time()-ts;
+        statistics[i].chi2 = activeRobustChi2();
+        statistics[i].timeIteration = get_monotonic_time()-ts;
       }
 
       if (verbose()){
@@ -428,6 +465,146 @@ namespace g2o{
     return cjIterations;
   }
 
+  int SparseOptimizer::optimizeComponents(int iterations)
+  {
+    if (_ivMap.size() == 0) {
+      cerr << __PRETTY_FUNCTION__ << ": 0 vertices to optimize, maybe forgot to call initializeOptimization()" << endl;
+      return -1;
+    }
+
+    computeActiveComponents();
+    int numComponents = static_cast<int>(_activeComponents.size());
+    if (numComponents <= 1)
+      return optimize(iterations);
+
+    _batchStatistics.clear();
+    if (_computeBatchStatistics)
+      _batchStatistics.resize(iterations);
+
+    // the active set is restricted to one component at a time
+    VertexContainer activeVertices;
+    EdgeContainer activeEdges;
+    activeVertices.swap(_activeVertices);
+    activeEdges.swap(_activeEdges);
+
+    std::vector<int> componentIterations(numComponents, 0);
+    std::vector<double> componentChi2(numComponents, 0.);
+    BatchStatisticsContainer componentStatistics;
+    double ts = get_monotonic_time();
+    for (int c = 0; c < numComponents; ++c) {
+      const Component& component = _activeComponents[c];
+      _activeVertices = component.vertices;
+      _activeEdges = component.edges;
+      clearIndexMapping();
+      buildIndexMapping(_activeVertices);
+
+      // each component is a new run for the actions, as after initializeOptimization()
+      if (c > 0) {
+        preIteration(-1);
+        postIteration(-1);
+      }
+
+      componentStatistics.clear();
+      if (_computeBatchStatistics)
+        componentStatistics.resize(iterations);
+      componentIterations[c] = runAlgorithm(iterations, false, componentStatistics);
+
+      // the statistics of the whole graph, a component which stopped earlier contributes its final chi2
+      int lastIteration = componentIterations[c] - 1;
+      for (int i = 0; i < static_cast<int>(componentStatistics.size()); ++i) {
+        if (i <= lastIteration) {
+          _batchStatistics[i].iteration = i;
+          _batchStatistics[i].accumulate(componentStatistics[i]);
+        } else if (lastIteration >= 0) {
+          _batchStatistics[i].chi2 += componentStatistics[lastIteration].chi2;
+        }
+      }
+      if (verbose()) {
+        computeActiveErrors();
+        componentChi2[c] = activeRobustChi2();
+      }
+    }
+
+    // restore the whole active graph
+    _activeVertices.swap(activeVertices);
+    _activeEdges.swap(activeEdges);
+    clearIndexMapping();
+    buildIndexMapping(_activeVertices);
+    _algorithm->init();
+
+    // report the longest run, or the failure if one of the components failed
+    int result = 0;
+    bool failed = false;
+    for (int c = 0; c < numComponents; ++c) {
+      if (componentIterations[c] <= 0) {
+        result = failed ? std::min(result, componentIterations[c]) : componentIterations[c];
+        failed = true;
+      } else if (! failed) {
+        result = std::max(result, componentIterations[c]);
+      }
+    }
+
+    // drop the iterations no component reached, the global statistics point into the container
+    int numStatistics = 0;
+    while (numStatistics < static_cast<int>(_batchStatistics.size()) && _batchStatistics[numStatistics].iteration >= 0)
+      ++numStatistics;
+    _batchStatistics.resize(numStatistics);
+    G2OBatchStatistics::setGlobalStats(numStatistics > 0 ? &_batchStatistics.back() : 0);
+
+    if (verbose()) {
+      for (int c = 0; c < numComponents; ++c) {
+        cerr << "component= " << c
+          << "\t vertices= " << _activeComponents[c].vertices.size()
+          << "\t edges= " << _activeComponents[c].edges.size()
+          << "\t iterations= " << componentIterations[c]
+          << "\t chi2= " << FIXED(componentChi2[c]) << endl;
+      }
+      computeActiveErrors();
+      cerr << "components= " << numComponents
+        << "\t chi2= " << FIXED(activeRobustChi2())
+        << "\t time= " << get_monotonic_time() - ts << endl;
+    }
+    return result;
+  }
+
+  void SparseOptimizer::computeActiveComponents()
+  {
+    _activeComponents.clear();
+
+    HyperGraph::VertexSet vset;
+    for (VertexContainer::const_iterator it = _activeVertices.begin(); it != _activeVertices.end(); ++it) {
+      if (! (*it)->fixed())
+        vset.insert(*it);
+    }
+    ActiveEdgeCostFunction costFunction(this);
+    std::vector<HyperGraph::VertexSet> components;
+    HyperDijkstra::connectedComponents(components, vset, &costFunction);
+
+    std::map<HyperGraph::Vertex*, int> componentOfVertex;
+    _activeComponents.resize(components.size());
+    for (size_t c = 0; c < components.size(); ++c) {
+      Component& component = _activeComponents[c];
+      component.vertices.reserve(components[c].size());
+      for (HyperGraph::VertexSet::const_iterator it = components[c].begin(); it != components[c].end(); ++it) {
+        component.vertices.push_back(static_cast<OptimizableGraph::Vertex*>(*it));
+        componentOfVertex[*it] = c;
+      }
+      sort(component.vertices.begin(), component.vertices.end(), VertexIDCompare());
+    }
+
+    // _activeEdges is sorted, hence the edges of each component are sorted as well
+    for (EdgeContainer::const_iterator it = _activeEdges.begin(); it != _activeEdges.end(); ++it) {
+      OptimizableGraph::Edge* e = *it;
+      for (size_t i = 0; i < e->vertices().size(); ++i) {
+        std::map<HyperGraph::Vertex*, int>::const_iterator foundIt = componentOfVertex.find(e->vertex(i));
+        if (foundIt != componentOfVertex.end()) {
+          _activeComponents[foundIt->second].edges.push_back(e);
+          break;
+        }
+      }
+    }
+  }
+
   void SparseOptimizer::update(const double* update)
   {
     // update the graph by calling oplus on the vertices
@@ -456,6 +633,7 @@ namespace g2o{
   {
     std::vector<HyperGraph::Vertex*> newVertices;
     newVertices.reserve(vset.size());
+    _activeComponents.clear(); // online processing always operates on the whole system
     _activeVertices.reserve(_activeVertices.size() + vset.size());
     _activeEdges.reserve(_activeEdges.size() + eset.size());
     for (HyperGraph::EdgeSet::iterator it = eset.begin(); it != eset.end(); ++it) {
@@ -497,6 +675,7 @@ namespace g2o{
 
   void SparseOptimizer::clear() {
     _ivMap.clear();
+    _activeComponents.clear();
     _activeVertices.clear();
     _activeEdges.clear();
     OptimizableGraph::clear();
@@ -591,6 +770,7 @@ namespace g2o{
     if (vv->hessianIndex() >= 0) {
       clearIndexMapping();
       _ivMap.clear();
+      _activeComponents.clear();
     }
     return HyperGraph::removeVertex(v, detach);
   }
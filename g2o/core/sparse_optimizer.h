@@ -53,6 +53,15 @@ namespace g2o {
 
     friend class ActivePathCostFunction;
 
+    /**
+     * \brief a connected component of the active graph, see activeComponents()
+     */
+    struct G2O_CORE_API Component {
+      VertexContainer vertices;   ///< the non-fixed vertices of the component, sorted according to VertexIDCompare
+      EdgeContainer edges;        ///< the active edges of the component, sorted according to EdgeIDCompare
+    };
+    typedef std::vector<Component> ComponentContainer;
+
     // Attention: _solver & _statistics is own by SparseOptimizer and will be
     // deleted in its destructor.
     SparseOptimizer();
@@ -121,6 +130,17 @@ namespace g2o {
      */
     int optimize(int iterations, bool online = false);
 
+    /**
+     * same as optimize() but solves the connected components of the active graph
+     * one after another with the algorithm of the optimizer. Each component is
+     * a separate run of at most iterations, i.e., the post iteration actions are
+     * signalled with iteration -1 before each component and may stop it early.
+     * The batch statistics sum up the components per iteration.
+     * It can be called only after initializeOptimization
+     * @return the maximum number of iterations carried out on a component
+     */
+    int optimizeComponents(int iterations);
+
     /**
      * computes the blocks of the inverse of the specified pattern.
      * the pattern is given via pairs <row, col> of the blocks in the hessian
@@ -194,6 +214,11 @@ namespace g2o {
     const VertexContainer& activeVertices() const { return _activeVertices;}
     //! the edges active in the current optimization
     const EdgeContainer& activeEdges() const { return _activeEdges;}
+    /**
+     * the connected components of the active graph. Vertices which are fixed do not
+     * connect components. Computed by optimizeComponents().
+     */
+    const ComponentContainer& activeComponents() const { return _activeComponents;}
 
     /**
      * Remove a vertex. If the vertex is contained in the currently active set
@@ -295,7 +320,20 @@ namespace g2o {
     VertexContainer _activeVertices;   ///< sorted according to VertexIDCompare
     EdgeContainer _activeEdges;        ///< sorted according to EdgeIDCompare
 
+    ComponentContainer _activeComponents;
+
     void sortVectorContainers();
+
+    /**
+     * computes the connected components of the active vertices / edges
+     */
+    void computeActiveComponents();
+
+    /**
+     * runs the iterations of the algorithm on the active vertices / edges
+     * @param statistics: filled if computeBatchStatistics() is set, holds at least iterations elements
+     */
+    int runAlgorithm(int iterations, bool online, BatchStatisticsContainer& statistics);
  
     OptimizationAlgorithm* _algorithm;
 
@@ -150,8 +150,8 @@ int main(int argc, char** argv)
   // adding the measurements
   vector<MotionInformation, Eigen::aligned_allocator<MotionInformation> > motions;
   {
-    std::map<double, RobotData*>::const_iterator it = robotLaserQueue.buffer().begin();
-    std::map<double, RobotData*>::const_iterator prevIt = it++;
+    DataQueue::Buffer::const_iterator it = robotLaserQueue.buffer().begin();
+    DataQueue::Buffer::const_iterator prevIt = it++;
     for (; it != robotLaserQueue.buffer().end(); ++it) {
       MotionInformation mi;
       RobotLaser* prevLaser = dynamic_cast<RobotLaser*>(prevIt->second);
@@ -35,6 +35,8 @@
 #include "g2o/core/optimization_algorithm_levenberg.h"
 #include "g2o/solvers/dense/linear_solver_dense.h"
 #include "g2o/types/icp/types_icp.h"
+#include "g2o/stuff/command_args.h"
+#include "g2o/stuff/timeutil.h"
 
 using namespace Eigen;
 using namespace std;
@@ -84,10 +86,18 @@ using namespace g2o;
 // set up simulated system with noise, optimize it
 //
 
-int main()
+int main(int argc, char** argv)
 {
   double euc_noise = 0.01;       // noise in position, m
   //  double outlier_ratio = 0.1;
+  int numPoints;
+  int maxIterations;
+  bool planeToPlane;
+  CommandArgs arg;
+  arg.param("n", numPoints, 1000, "number of correspondences");
+  arg.param("i", maxIterations, 5, "number of iterations");
+  arg.param("plpl", planeToPlane, false, "use the plane-to-plane metric");
+  arg.parseArgs(argc, argv);
 
 
   SparseOptimizer optimizer;
@@ -101,7 +111,7 @@ int main()
   optimizer.setAlgorithm(solver);
 
   vector<Vector3d> true_points;
-  for (size_t i=0;i<1000; ++i)
+  for (int i=0;i<numPoints; ++i)
   {
     true_points.push_back(Vector3d((Sample::uniform()-0.5)*3,
                                    Sample::uniform()-0.5,
@@ -141,6 +151,7 @@ int main()
   }
 
   // set up point matches
+  double setupTime = 0.;
   for (size_t i=0; i<true_points.size(); ++i)
   {
     // get two poses
@@ -187,8 +198,12 @@ int main()
     //        e->inverseMeasurement().pos() = -kp;
     
     meas = e->measurement();
-    // use this for point-plane
-    e->information() = meas.prec0(0.01);
+    double ts = get_monotonic_time();
+    if (planeToPlane)
+      e->setPlaneToPlane(0.01);
+    else // use this for point-plane
+      e->information() = meas.prec0(0.01);
+    setupTime += get_monotonic_time() - ts;
 
     // use this for point-point 
     //    e->information().setIdentity();
@@ -207,12 +222,17 @@ int main()
   vc->setEstimate(cam);
 
   optimizer.initializeOptimization();
+  double t = get_monotonic_time();
   optimizer.computeActiveErrors();
+  double errorTime = get_monotonic_time() - t;
   cout << "Initial chi2 = " << FIXED(optimizer.chi2()) << endl;
+  cout << "Setting up the information matrices took " << setupTime << " s, computing the errors " << errorTime << " s" << endl;
 
   optimizer.setVerbose(true);
 
-  optimizer.optimize(5);
+  t = get_monotonic_time();
+  optimizer.optimize(maxIterations);
+  cout << "Optimization took " << get_monotonic_time() - t << " s for " << numPoints << " correspondences" << endl;
 
   cout << endl << "Second vertex should be near 0,0,1" << endl;
   cout <<  dynamic_cast<VertexSE3*>(optimizer.vertices().find(0)->second)
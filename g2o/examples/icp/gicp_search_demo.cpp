@@ -0,0 +1,159 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <random>
+#include <iostream>
+
+#include "g2o/core/sparse_optimizer.h"
+#include "g2o/core/block_solver.h"
+#include "g2o/core/optimization_algorithm_levenberg.h"
+#include "g2o/solvers/dense/linear_solver_dense.h"
+#include "g2o/types/icp/gicp_correspondence_search.h"
+#include "g2o/stuff/command_args.h"
+#include "g2o/stuff/timeutil.h"
+
+using namespace Eigen;
+using namespace std;
+using namespace g2o;
+
+/**
+ * sample points on the walls, floor and ceiling of a box shaped room and on a
+ * sphere inside of the room
+ */
+static void sampleScene(PointCloud3D& cloud, int numPoints, double noise, default_random_engine& gen)
+{
+  uniform_real_distribution<double> unif(-1., 1.);
+  normal_distribution<double> gauss(0., noise);
+  const Vector3D room(4., 3., 1.5);
+  const Vector3D sphereCenter(1., 0.5, 0.);
+  const double sphereRadius = 0.7;
+  cloud.resize(numPoints);
+  for (int i = 0; i < numPoints; ++i) {
+    Vector3D p;
+    int surface = i % 7;
+    if (surface < 6) {
+      // one of the six faces of the box
+      int axis = surface / 2;
+      p = Vector3D(unif(gen), unif(gen), unif(gen)).cwiseProduct(room);
+      p(axis) = surface % 2 ? room(axis) : -room(axis);
+    } else {
+      p = Vector3D(gauss(gen) + 1e-9, gauss(gen), gauss(gen)).normalized() * sphereRadius + sphereCenter;
+    }
+    cloud[i] = p + Vector3D(gauss(gen), gauss(gen), gauss(gen));
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int numPoints;
+  int maxIterations;
+  int interval;
+  double maxDistance;
+  double normalRadius;
+  bool planeToPlane;
+  CommandArgs arg;
+  arg.param("n", numPoints, 100000, "number of points per cloud");
+  arg.param("i", maxIterations, 10, "number of iterations");
+  arg.param("interval", interval, 1, "re-associate every n-th iteration");
+  arg.param("maxDistance", maxDistance, 0.5, "maximal distance of corresponding points");
+  arg.param("normalRadius", normalRadius, 0.1, "radius for estimating the normals");
+  arg.param("plpl", planeToPlane, false, "use the plane-to-plane metric");
+  arg.parseArgs(argc, argv);
+
+  default_random_engine gen;
+  PointCloud3D target, source;
+  sampleScene(target, numPoints, 0.002, gen);
+  sampleScene(source, numPoints, 0.002, gen);
+
+  // true pose of the second scan, the points are observed in its frame
+  Isometry3D trueOffset = Isometry3D::Identity();
+  trueOffset.translation() = Vector3D(0.2, -0.1, 0.05);
+  trueOffset.linear() = AngleAxisd(0.1, Vector3D::UnitZ()).toRotationMatrix();
+  for (size_t i = 0; i < source.size(); ++i)
+    source[i] = trueOffset.inverse() * source[i];
+
+  SparseOptimizer optimizer;
+  BlockSolverX::LinearSolverType* linearSolver = new LinearSolverDense<BlockSolverX::PoseMatrixType>();
+  BlockSolverX* blockSolver = new BlockSolverX(linearSolver);
+  optimizer.setAlgorithm(new OptimizationAlgorithmLevenberg(blockSolver));
+
+  VertexSE3* v0 = new VertexSE3;
+  v0->setId(0);
+  v0->setEstimate(Isometry3D::Identity());
+  v0->setFixed(true);
+  optimizer.addVertex(v0);
+  VertexSE3* v1 = new VertexSE3;
+  v1->setId(1);
+  v1->setEstimate(Isometry3D::Identity());
+  optimizer.addVertex(v1);
+
+  GICPCorrespondenceSearch search;
+  search.setVertices(v0, v1);
+  search.setMaxDistance(maxDistance);
+  search.setNormalRadius(normalRadius);
+  search.setAssociationInterval(interval);
+  search.setPlaneToPlane(planeToPlane);
+
+  double t = get_monotonic_time();
+  search.setTargetCloud(target);
+  search.setSourceCloud(source);
+  double tTree = get_monotonic_time() - t;
+
+  t = get_monotonic_time();
+  search.computeNormals();
+  double tNormals = get_monotonic_time() - t;
+
+  t = get_monotonic_time();
+  search.createEdges(&optimizer);
+  double tEdges = get_monotonic_time() - t;
+
+  t = get_monotonic_time();
+  const int numAssociations = 10;
+  for (int i = 0; i < numAssociations; ++i)
+    search.associate();
+  double tAssociate = (get_monotonic_time() - t) / numAssociations;
+
+  cout << "# points per cloud:  " << numPoints << endl;
+  cout << "# k-d tree:          " << tTree << " s" << endl;
+  cout << "# normals:           " << tNormals << " s (" << 2 * numPoints / tNormals << " points/s)" << endl;
+  cout << "# creating edges:    " << tEdges << " s" << endl;
+  cout << "# association:       " << tAssociate << " s (" << numPoints / tAssociate << " points/s)" << endl;
+  cout << "# associated points: " << search.numAssociated() << endl;
+
+  optimizer.addPreIterationAction(&search);
+  optimizer.initializeOptimization();
+  optimizer.setVerbose(true);
+  t = get_monotonic_time();
+  optimizer.optimize(maxIterations);
+  double tOptimize = get_monotonic_time() - t;
+  optimizer.removePreIterationAction(&search);
+
+  Isometry3D delta = trueOffset.inverse() * v1->estimate();
+  cout << "# optimization:      " << tOptimize << " s" << endl;
+  cout << "# translation error: " << delta.translation().norm() << endl;
+  cout << "# rotation error:    " << AngleAxisd(delta.linear()).angle() << endl;
+  return 0;
+}
@@ -64,6 +64,8 @@ SparseOptimizerOnline::SparseOptimizerOnline(bool pcg) :
   slamDimension(3), newEdges(0), batchStep(true), vizWithGnuplot(false),
   _gnuplot(0), _usePcg(pcg), _underlyingSolver(0)
 {
+  // the SLAM protocol numbers the nodes consecutively
+  setDenseVertexIds(true);
 }
 
 SparseOptimizerOnline::~SparseOptimizerOnline()
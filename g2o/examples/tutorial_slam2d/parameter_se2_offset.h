@@ -58,8 +58,8 @@ namespace g2o {
       public:
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
 
-        const SE2& w2n() const { return _w2n;}
-        const SE2& n2w() const { return _n2w;}
+        const SE2& w2n() const { ensureUpdated(); return _w2n;}
+        const SE2& n2w() const { ensureUpdated(); return _n2w;}
 
       protected:
         virtual void updateImpl();
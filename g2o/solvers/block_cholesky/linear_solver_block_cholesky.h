@@ -0,0 +1,675 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_LINEAR_SOLVER_BLOCK_CHOLESKY_H
+#define G2O_LINEAR_SOLVER_BLOCK_CHOLESKY_H
+
+#include "g2o/core/linear_solver.h"
+#include "g2o/core/batch_stats.h"
+#include "g2o/core/marginal_covariance_cholesky.h"
+#include "g2o/core/matrix_structure.h"
+#include "g2o/core/nested_dissection.h"
+#include "g2o/core/sparse_index.h"
+#include "g2o/stuff/timeutil.h"
+#include "g2o/config.h"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <Eigen/SparseCore>
+#include <Eigen/OrderingMethods>
+
+#ifdef G2O_OPENMP
+#include <omp.h>
+#endif
+
+namespace g2o {
+
+/**
+ * \brief sparse Cholesky decomposition operating directly on the block structure
+ *
+ * Factorizes A = P^T L L^T P without converting A into a scalar CCS matrix.
+ * Each block column of A is treated as a supernode and L is stored as one dense
+ * per block column holding the diagonal block and all non-zero blocks
+ * below it. The ordering is a block AMD or a nested dissection ordering, the
+ * factorization is left-looking and the updates are done with Eigen kernels
+ * fixed to the block size of MatrixType. If OpenMP is enabled, disjoint
+ * subtrees of the block elimination tree are factorized concurrently and the
+ * remaining columns close to the roots are factorized level by level.
+ *
+ * Optionally the factorization is computed in single precision and the
+ * solution is refined by a few steps of iterative refinement against A in
+ * double precision, which halves the memory traffic of the factorization.
+ */
+template <typename MatrixType>
+class LinearSolverBlockCholesky : public LinearSolver<MatrixType>
+{
+  public:
+    static const int BlockDim = MatrixType::RowsAtCompileTime;
+    typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> MatrixXF;
+    typedef Eigen::Matrix<float, Eigen::Dynamic, 1> VectorXF;
+
+  public:
+    LinearSolverBlockCholesky() :
+      LinearSolver<MatrixType>(),
+      _symbolicDone(false), _writeDebug(false), _singlePrecision(false), _refinementSteps(2), _nestedDissection(false), _nnzL(0)
+    {
+    }
+
+    virtual ~LinearSolverBlockCholesky()
+    {
+    }
+
+    virtual bool init()
+    {
+      _symbolicDone = false;
+      return true;
+    }
+
+    bool solve(const SparseBlockMatrix<MatrixType>& A, double* x, double* b)
+    {
+      if (! _symbolicDone)
+        computeSymbolicDecomposition(A);
+
+      double t = get_monotonic_time();
+      bool ok = _singlePrecision ? computeNumericDecomposition(_Lf) : computeNumericDecomposition(_L);
+      if (! ok) {
+        if (_writeDebug) {
+          std::cerr << "Cholesky failure, writing debug.txt (Hessian loadable by Octave)" << std::endl;
+          A.writeOctave("debug.txt");
+        }
+        return false;
+      }
+
+      if (! _singlePrecision) {
+        solveFactorized(A, x, b);
+      } else {
+        // iterative refinement in double precision: x += (L L^T)^-1 (b - A x)
+        const int n = A.cols();
+        _b = VectorXD::ConstMapType(b, n);
+        solveFactorized(A, x, _b.data());
+        VectorXD::MapType xx(x, n);
+        _residual.resize(n);
+        _dx.resize(n);
+        for (int i = 0; i < _refinementSteps; ++i) {
+          _residual.setZero();
+          double* residual = _residual.data();
+          A.multiplySymmetricUpperTriangle(residual, x);
+          _residual = _b - _residual;
+          solveFactorized(A, _dx.data(), _residual.data());
+          xx += _dx;
+        }
+      }
+
+      G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
+      if (globalStats) {
+        globalStats->timeNumericDecomposition = get_monotonic_time() - t;
+        globalStats->choleskyNNZ = _nnzL;
+        if (_singlePrecision)
+          globalStats->iterationsRefinement = _refinementSteps;
+      }
+      return true;
+    }
+
+    bool solveBlocks(double**& blocks, const SparseBlockMatrix<MatrixType>& A)
+    {
+      if (! _symbolicDone)
+        computeSymbolicDecomposition(A);
+
+      if (! blocks){
+        blocks=new double*[A.rows()];
+        double **block=blocks;
+        for (size_t i=0; i < A.rowBlockIndices().size(); ++i){
+          int dim = A.rowsOfBlock(i) * A.colsOfBlock(i);
+          *block = new double [dim];
+          block++;
+        }
+      }
+
+      if (! computeNumericDecomposition(_L)) {
+        std::cerr << "inverse fail (numeric decomposition)" << std::endl;
+        return false;
+      }
+      fillScalarFactor(A);
+      MarginalCovarianceCholesky mcc;
+      mcc.setCholeskyFactor(A.cols(), &_Lp[0], &_Li[0], &_Lx[0], &_scalarPermInv[0]);
+      mcc.computeCovariance(blocks, A.rowBlockIndices());
+
+      G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
+      if (globalStats)
+        globalStats->choleskyNNZ = _nnzL;
+      return true;
+    }
+
+    virtual bool solvePattern(SparseBlockMatrix<MatrixXD>& spinv, const std::vector<std::pair<int, int> >& blockIndices, const SparseBlockMatrix<MatrixType>& A)
+    {
+      if (! _symbolicDone)
+        computeSymbolicDecomposition(A);
+
+      if (! computeNumericDecomposition(_L)) {
+        std::cerr << "inverse fail (numeric decomposition)" << std::endl;
+        return false;
+      }
+      fillScalarFactor(A);
+      MarginalCovarianceCholesky mcc;
+      mcc.setCholeskyFactor(A.cols(), &_Lp[0], &_Li[0], &_Lx[0], &_scalarPermInv[0]);
+      mcc.computeCovariance(spinv, A.rowBlockIndices(), blockIndices);
+
+      G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
+      if (globalStats)
+        globalStats->choleskyNNZ = _nnzL;
+      return true;
+    }
+
+    //! write a debug dump of the system matrix if it is not SPD in solve
+    virtual bool writeDebug() const { return _writeDebug;}
+    virtual void setWriteDebug(bool b) { _writeDebug = b;}
+
+    /**
+     * factorize A in single precision and refine the solution in double
+     * precision, the marginals are always computed in double precision
+     */
+    virtual bool singlePrecision() const { return _singlePrecision;}
+    virtual void setSinglePrecision(bool singlePrecision) { _singlePrecision = singlePrecision;}
+
+    //! number of iterative refinement steps if the factorization is done in single precision
+    int refinementSteps() const { return _refinementSteps;}
+    void setRefinementSteps(int steps) { _refinementSteps = steps;}
+
+    /**
+     * use a nested dissection ordering of the blocks instead of AMD. Gives a
+     * balanced elimination tree for trajectory-like graphs which exposes more
+     * parallelism to the factorization.
+     */
+    bool nestedDissection() const { return _nestedDissection;}
+    void setNestedDissection(bool nestedDissection) { _nestedDissection = nestedDissection;}
+
+  protected:
+    /**
+     * \brief a block of A which contributes to a panel of L
+     */
+    struct InputBlock
+    {
+      enum Type { Diagonal, Regular, Transposed };
+      const MatrixType* block;
+      int offset; ///< row offset inside the panel
+      Type type;
+      InputBlock(const MatrixType* b, int o, Type t) : block(b), offset(o), type(t) {}
+    };
+    typedef std::vector<InputBlock> InputBlockVector;
+
+    /**
+     * \brief descendant column k whose panel updates the current column, starting at position pos of its pattern
+     */
+    struct Update
+    {
+      int column;
+      int pos;
+      Update(int c, int p) : column(c), pos(p) {}
+    };
+    typedef std::vector<Update> UpdateVector;
+
+    bool _symbolicDone;
+    bool _writeDebug;
+    bool _singlePrecision;
+    int _refinementSteps;
+    bool _nestedDissection;
+    size_t _nnzL;
+    MatrixStructure _matrixStructure;
+
+    std::vector<int> _perm;                       ///< _perm[new] = old block index
+    std::vector<int> _permInv;                    ///< _permInv[old] = new block index
+    std::vector<int> _blockDim;                   ///< dimension of the permuted block columns
+    std::vector<int> _blockBase;                  ///< scalar base of the permuted block columns
+    std::vector<int> _parent;                     ///< block elimination tree
+    std::vector<std::vector<int> > _pattern;      ///< sorted row blocks of each panel, the first one is the diagonal
+    std::vector<std::vector<int> > _rowOffset;    ///< scalar row offset of each pattern entry inside the panel
+    std::vector<InputBlockVector> _inputBlocks;   ///< blocks of A which are scattered into the panels
+    std::vector<UpdateVector> _updates;           ///< descendants updating a column
+    std::vector<std::vector<int> > _subtrees;     ///< disjoint subtrees of the elimination tree, columns in ascending order
+    std::vector<std::vector<int> > _levels;       ///< remaining columns grouped by their height in the elimination tree
+    std::vector<int> _panelRows;                  ///< number of rows of each panel
+    std::vector<MatrixXD> _L;                     ///< the panels of L
+    std::vector<MatrixXF> _Lf;                    ///< the panels of L in single precision
+
+    VectorXD _y;
+    VectorXF _yf;
+    VectorXD _b;
+    VectorXD _residual;
+    VectorXD _dx;
+
+    // scalar CCS version of L for computing the marginals
+    std::vector<SparseIndex> _Lp;
+    std::vector<SparseIndex> _Li;
+    std::vector<double> _Lx;
+    std::vector<SparseIndex> _scalarPermInv;
+
+    void computeSymbolicDecomposition(const SparseBlockMatrix<MatrixType>& A)
+    {
+      double t=get_monotonic_time();
+      const int nb = static_cast<int>(A.blockCols().size());
+      assert(A.rowBlockIndices().size() == A.colBlockIndices().size() && "Matrix A is not square");
+
+      // fill-reducing ordering on the block structure
+      _perm.resize(nb);
+      _permInv.resize(nb);
+      if (_nestedDissection) {
+        A.fillBlockStructure(_matrixStructure);
+        NestedDissection nestedDissection;
+        nestedDissection.compute(_matrixStructure, _perm);
+      } else {
+        typedef Eigen::Triplet<double> Triplet;
+        std::vector<Triplet> triplets;
+        for (int c = 0; c < nb; ++c) {
+          const typename SparseBlockMatrix<MatrixType>::IntBlockMap& column = A.blockCols()[c];
+          for (typename SparseBlockMatrix<MatrixType>::IntBlockMap::const_iterator it = column.begin(); it != column.end(); ++it) {
+            if (it->first > c) // only upper triangle
+              break;
+            triplets.push_back(Triplet(it->first, c, 1.));
+          }
+        }
+        Eigen::SparseMatrix<double, Eigen::ColMajor, int> blockPattern(nb, nb);
+        blockPattern.setFromTriplets(triplets.begin(), triplets.end());
+        Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> blockP;
+        Eigen::AMDOrdering<int> ordering;
+        ordering(blockPattern, blockP);
+        for (int i = 0; i < nb; ++i)
+          _perm[i] = blockP.indices()(i);
+      }
+      for (int i = 0; i < nb; ++i)
+        _permInv[_perm[i]] = i;
+
+      _blockDim.resize(nb);
+      _blockBase.resize(nb);
+      int base = 0;
+      for (int j = 0; j < nb; ++j) {
+        _blockDim[j] = A.colsOfBlock(_perm[j]);
+        _blockBase[j] = base;
+        base += _blockDim[j];
+      }
+
+      // lower triangle of the permuted matrix, column wise
+      std::vector<std::vector<std::pair<int, InputBlock> > > lowerA(nb);
+      for (int c = 0; c < nb; ++c) {
+        const typename SparseBlockMatrix<MatrixType>::IntBlockMap& column = A.blockCols()[c];
+        for (typename SparseBlockMatrix<MatrixType>::IntBlockMap::const_iterator it = column.begin(); it != column.end(); ++it) {
+          const int& r = it->first;
+          if (r > c)
+            break;
+          int pr = _permInv[r];
+          int pc = _permInv[c];
+          if (r == c)
+            lowerA[pc].push_back(std::make_pair(pc, InputBlock(it->second, 0, InputBlock::Diagonal)));
+          else if (pr > pc)
+            lowerA[pc].push_back(std::make_pair(pr, InputBlock(it->second, 0, InputBlock::Regular)));
+          else
+            lowerA[pr].push_back(std::make_pair(pc, InputBlock(it->second, 0, InputBlock::Transposed)));
+        }
+      }
+
+      // block elimination tree and the pattern of each panel, the pattern of
+      // a column is the union of its entries in A and the patterns of its children
+      _parent.assign(nb, -1);
+      _pattern.resize(nb);
+      _rowOffset.resize(nb);
+      std::vector<std::vector<int> > children(nb);
+      std::vector<int> marker(nb, -1);
+      for (int j = 0; j < nb; ++j) {
+        std::vector<int>& pattern = _pattern[j];
+        pattern.clear();
+        pattern.push_back(j);
+        marker[j] = j;
+        for (size_t i = 0; i < lowerA[j].size(); ++i) {
+          int r = lowerA[j][i].first;
+          if (marker[r] != j) {
+            marker[r] = j;
+            pattern.push_back(r);
+          }
+        }
+        for (size_t i = 0; i < children[j].size(); ++i) {
+          const std::vector<int>& childPattern = _pattern[children[j][i]];
+          for (size_t k = 1; k < childPattern.size(); ++k) {
+            int r = childPattern[k];
+            if (marker[r] != j) {
+              marker[r] = j;
+              pattern.push_back(r);
+            }
+          }
+        }
+        std::sort(pattern.begin(), pattern.end());
+        if (pattern.size() > 1) {
+          _parent[j] = pattern[1];
+          children[pattern[1]].push_back(j);
+        }
+      }
+
+      // row offsets inside the panels, the input blocks, and the descendants updating each column
+      _inputBlocks.resize(nb);
+      _updates.resize(nb);
+      _panelRows.resize(nb);
+      _L.clear();
+      _Lf.clear();
+      _nnzL = 0;
+      for (int j = 0; j < nb; ++j) {
+        const std::vector<int>& pattern = _pattern[j];
+        std::vector<int>& rowOffset = _rowOffset[j];
+        rowOffset.resize(pattern.size());
+        int rows = 0;
+        for (size_t k = 0; k < pattern.size(); ++k) {
+          rowOffset[k] = rows;
+          marker[pattern[k]] = rows; // scatter the offsets for placing the input blocks
+          rows += _blockDim[pattern[k]];
+        }
+        _panelRows[j] = rows;
+        _nnzL += rows * _blockDim[j] - (_blockDim[j] * (_blockDim[j] - 1)) / 2;
+
+        InputBlockVector& inputBlocks = _inputBlocks[j];
+        inputBlocks.clear();
+        for (size_t i = 0; i < lowerA[j].size(); ++i) {
+          InputBlock ib = lowerA[j][i].second;
+          ib.offset = marker[lowerA[j][i].first];
+          inputBlocks.push_back(ib);
+        }
+        _updates[j].clear();
+      }
+      for (int k = 0; k < nb; ++k) {
+        const std::vector<int>& pattern = _pattern[k];
+        for (size_t p = 1; p < pattern.size(); ++p)
+          _updates[pattern[p]].push_back(Update(k, static_cast<int>(p)));
+      }
+
+      // split the elimination tree into disjoint subtrees, each one with at
+      // most a fraction of the estimated work, which are factorized
+      // concurrently. Within a subtree the columns are processed in ascending
+      // order, since all descendants of a column have a lower index.
+      std::vector<double> work(nb, 0.);
+      double totalWork = 0.;
+      for (int j = 0; j < nb; ++j) {
+        work[j] += static_cast<double>(_panelRows[j]) * _panelRows[j] * _blockDim[j];
+        if (_parent[j] >= 0)
+          work[_parent[j]] += work[j];
+        else
+          totalWork += work[j];
+      }
+      int numThreads = 1;
+#     ifdef G2O_OPENMP
+      numThreads = omp_get_max_threads();
+#     endif
+      const double maxSubtreeWork = totalWork / (4 * numThreads);
+      std::vector<int> owner(nb, -1);
+      for (int j = nb - 1; j >= 0; --j) {
+        if (work[j] > maxSubtreeWork)
+          continue;
+        const int& p = _parent[j];
+        owner[j] = (p >= 0 && owner[p] >= 0) ? owner[p] : j;
+      }
+      _subtrees.clear();
+      std::vector<int> subtreeIndex(nb, -1);
+      for (int j = 0; j < nb; ++j) {
+        if (owner[j] < 0)
+          continue;
+        if (subtreeIndex[owner[j]] < 0) {
+          subtreeIndex[owner[j]] = static_cast<int>(_subtrees.size());
+          _subtrees.push_back(std::vector<int>());
+        }
+        _subtrees[subtreeIndex[owner[j]]].push_back(j);
+      }
+
+      // group the remaining columns by their height above the subtrees, all
+      // descendants of a column have a lower height
+      std::vector<int> height(nb, 0);
+      int maxHeight = -1;
+      for (int j = 0; j < nb; ++j) {
+        if (owner[j] >= 0)
+          continue;
+        if (_parent[j] >= 0)
+          height[_parent[j]] = (std::max)(height[_parent[j]], height[j] + 1);
+        maxHeight = (std::max)(maxHeight, height[j]);
+      }
+      _levels.clear();
+      _levels.resize(maxHeight + 1);
+      for (int j = 0; j < nb; ++j)
+        if (owner[j] < 0)
+          _levels[height[j]].push_back(j);
+
+      _symbolicDone = true;
+      G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
+      if (globalStats)
+        globalStats->timeSymbolicDecomposition = get_monotonic_time() - t;
+    }
+
+    /**
+     * solve A x = b with the factorized panels by permuting b, solving
+     * L L^T y = P b, and permuting back
+     */
+    void solveFactorized(const SparseBlockMatrix<MatrixType>& A, double* x, const double* b)
+    {
+      _y.resize(A.cols());
+      for (size_t j = 0; j < _perm.size(); ++j)
+        _y.segment(_blockBase[j], _blockDim[j]) = VectorXD::ConstMapType(b + A.colBaseOfBlock(_perm[j]), _blockDim[j]);
+      if (_singlePrecision) {
+        _yf = _y.cast<float>();
+        solveForward(_Lf, _yf);
+        solveBackward(_Lf, _yf);
+        _y = _yf.cast<double>();
+      } else {
+        solveForward(_L, _y);
+        solveBackward(_L, _y);
+      }
+      for (size_t j = 0; j < _perm.size(); ++j)
+        VectorXD::MapType(x + A.colBaseOfBlock(_perm[j]), _blockDim[j]) = _y.segment(_blockBase[j], _blockDim[j]);
+    }
+
+    /**
+     * factorize all panels level by level
+     * @return false, if A is not positive definite
+     */
+    template <typename PanelType>
+    bool computeNumericDecomposition(std::vector<PanelType>& L)
+    {
+      if (L.size() != _pattern.size()) {
+        L.resize(_pattern.size());
+        for (size_t j = 0; j < L.size(); ++j)
+          L[j].resize(_panelRows[j], _blockDim[j]);
+      }
+
+      // each thread keeps its own flag, which stops its remaining subtrees early
+      bool ok = true;
+      const int numSubtrees = static_cast<int>(_subtrees.size());
+#     ifdef G2O_OPENMP
+#     pragma omp parallel for default (shared) schedule(dynamic, 1) reduction(&&:ok) if (numSubtrees > 1)
+#     endif
+      for (int i = 0; i < numSubtrees; ++i) {
+        const std::vector<int>& subtree = _subtrees[i];
+        for (size_t k = 0; k < subtree.size() && ok; ++k) {
+          if (! factorizeColumn(L, subtree[k]))
+            ok = false;
+        }
+      }
+      if (! ok)
+        return false;
+
+      for (size_t l = 0; l < _levels.size(); ++l) {
+        const std::vector<int>& level = _levels[l];
+        const int levelSize = static_cast<int>(level.size());
+#       ifdef G2O_OPENMP
+#       pragma omp parallel for default (shared) schedule(dynamic, 10) reduction(&&:ok) if (levelSize > 20)
+#       endif
+        for (int i = 0; i < levelSize; ++i) {
+          if (! factorizeColumn(L, level[i]))
+            ok = false;
+        }
+        if (! ok)
+          return false;
+      }
+      return true;
+    }
+
+    template <typename PanelType>
+    bool factorizeColumn(std::vector<PanelType>& L, int j)
+    {
+      typedef typename PanelType::Scalar Scalar;
+      typedef Eigen::Matrix<Scalar, BlockDim, BlockDim> DiagonalBlockType;
+      PanelType& panel = L[j];
+      const int dj = _blockDim[j];
+      const std::vector<int>& pattern = _pattern[j];
+      const std::vector<int>& rowOffset = _rowOffset[j];
+
+      // scatter A into the panel, only the lower triangle of the diagonal block is used
+      panel.setZero();
+      const InputBlockVector& inputBlocks = _inputBlocks[j];
+      for (size_t i = 0; i < inputBlocks.size(); ++i) {
+        const InputBlock& ib = inputBlocks[i];
+        switch (ib.type) {
+          case InputBlock::Diagonal:
+            panel.template block<BlockDim, BlockDim>(0, 0, dj, dj).template triangularView<Eigen::Lower>() = ib.block->transpose().template cast<Scalar>();
+            break;
+          case InputBlock::Regular:
+            panel.block(ib.offset, 0, ib.block->rows(), dj) = ib.block->template cast<Scalar>();
+            break;
+          case InputBlock::Transposed:
+            panel.block(ib.offset, 0, ib.block->cols(), dj) = ib.block->transpose().template cast<Scalar>();
+            break;
+        }
+      }
+
+      // left-looking update by the descendants: L(:,j) -= L(:,k) * L(j,k)^T
+      const UpdateVector& updates = _updates[j];
+      for (size_t u = 0; u < updates.size(); ++u) {
+        const int k = updates[u].column;
+        const PanelType& panelK = L[k];
+        const int dk = _blockDim[k];
+        const std::vector<int>& patternK = _pattern[k];
+        const std::vector<int>& rowOffsetK = _rowOffset[k];
+        int pos = updates[u].pos;
+        const Eigen::Block<const PanelType, BlockDim, BlockDim> Ljk = panelK.template block<BlockDim, BlockDim>(rowOffsetK[pos], 0, dj, dk);
+        size_t target = 0;
+        for (size_t p = pos; p < patternK.size(); ++p) {
+          const int r = patternK[p];
+          while (pattern[target] != r)
+            ++target;
+          const int dr = _blockDim[r];
+          panel.template block<BlockDim, BlockDim>(rowOffset[target], 0, dr, dj).noalias() -=
+            panelK.template block<BlockDim, BlockDim>(rowOffsetK[p], 0, dr, dk) * Ljk.transpose();
+        }
+      }
+
+      // factorize the diagonal block and solve for the blocks below
+      Eigen::LLT<DiagonalBlockType> llt(panel.template block<BlockDim, BlockDim>(0, 0, dj, dj));
+      if (llt.info() != Eigen::Success)
+        return false;
+      panel.template block<BlockDim, BlockDim>(0, 0, dj, dj) = llt.matrixL();
+      const int belowRows = static_cast<int>(panel.rows()) - dj;
+      if (belowRows > 0) {
+        Eigen::Block<PanelType> below = panel.bottomRows(belowRows);
+        llt.matrixU().template solveInPlace<Eigen::OnTheRight>(below);
+      }
+      return true;
+    }
+
+    //! solve L y = y in place
+    template <typename PanelType, typename VectorType>
+    void solveForward(const std::vector<PanelType>& L, VectorType& y)
+    {
+      for (size_t j = 0; j < _pattern.size(); ++j) {
+        const PanelType& panel = L[j];
+        const int dj = _blockDim[j];
+        Eigen::VectorBlock<VectorType, BlockDim> yj = y.template segment<BlockDim>(_blockBase[j], dj);
+        panel.template block<BlockDim, BlockDim>(0, 0, dj, dj).template triangularView<Eigen::Lower>().solveInPlace(yj);
+        const std::vector<int>& pattern = _pattern[j];
+        for (size_t p = 1; p < pattern.size(); ++p) {
+          const int r = pattern[p];
+          const int dr = _blockDim[r];
+          y.template segment<BlockDim>(_blockBase[r], dr).noalias() -= panel.template block<BlockDim, BlockDim>(_rowOffset[j][p], 0, dr, dj) * yj;
+        }
+      }
+    }
+
+    //! solve L^T y = y in place
+    template <typename PanelType, typename VectorType>
+    void solveBackward(const std::vector<PanelType>& L, VectorType& y)
+    {
+      for (int j = static_cast<int>(_pattern.size()) - 1; j >= 0; --j) {
+        const PanelType& panel = L[j];
+        const int dj = _blockDim[j];
+        Eigen::VectorBlock<VectorType, BlockDim> yj = y.template segment<BlockDim>(_blockBase[j], dj);
+        const std::vector<int>& pattern = _pattern[j];
+        for (size_t p = 1; p < pattern.size(); ++p) {
+          const int r = pattern[p];
+          const int dr = _blockDim[r];
+          yj.noalias() -= panel.template block<BlockDim, BlockDim>(_rowOffset[j][p], 0, dr, dj).transpose() * y.template segment<BlockDim>(_blockBase[r], dr);
+        }
+        panel.template block<BlockDim, BlockDim>(0, 0, dj, dj).template triangularView<Eigen::Lower>().transpose().solveInPlace(yj);
+      }
+    }
+
+    /**
+     * convert the panels into a scalar CCS matrix, the diagonal element is the
+     * first in each column as required by MarginalCovarianceCholesky
+     */
+    void fillScalarFactor(const SparseBlockMatrix<MatrixType>& A)
+    {
+      const int n = A.cols();
+      _Lp.resize(n + 1);
+      _Li.resize(_nnzL);
+      _Lx.resize(_nnzL);
+      _scalarPermInv.resize(n);
+      SparseIndex nz = 0;
+      for (size_t j = 0; j < _pattern.size(); ++j) {
+        const MatrixXD& panel = _L[j];
+        const int dj = _blockDim[j];
+        const int originalBase = A.colBaseOfBlock(_perm[j]);
+        const std::vector<int>& pattern = _pattern[j];
+        for (int c = 0; c < dj; ++c) {
+          const int col = _blockBase[j] + c;
+          _scalarPermInv[originalBase + c] = col;
+          _Lp[col] = nz;
+          for (int rr = c; rr < dj; ++rr) {
+            _Li[nz] = _blockBase[j] + rr;
+            _Lx[nz++] = panel(rr, c);
+          }
+          for (size_t p = 1; p < pattern.size(); ++p) {
+            const int r = pattern[p];
+            const int offset = _rowOffset[j][p];
+            for (int rr = 0; rr < _blockDim[r]; ++rr) {
+              _Li[nz] = _blockBase[r] + rr;
+              _Lx[nz++] = panel(offset + rr, c);
+            }
+          }
+        }
+      }
+      _Lp[n] = nz;
+      assert(nz == static_cast<SparseIndex>(_nnzL) && "wrong number of non-zeros in L");
+    }
+};
+
+} // end namespace
+
+#endif
@@ -0,0 +1,135 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "linear_solver_block_cholesky.h"
+
+#include "g2o/core/block_solver.h"
+#include "g2o/core/solver.h"
+#include "g2o/core/optimization_algorithm_factory.h"
+#include "g2o/core/sparse_optimizer.h"
+
+#include "g2o/core/optimization_algorithm_gauss_newton.h"
+#include "g2o/core/optimization_algorithm_levenberg.h"
+#include "g2o/core/optimization_algorithm_dogleg.h"
+
+#include "g2o/stuff/macros.h"
+
+#define DIM_TO_SOLVER(p, l) BlockSolver< BlockSolverTraits<p, l> >
+
+#define ALLOC_BLOCK_CHOLESKY(s, p, l, nestedDissection) \
+  if (1) { \
+    std::cerr << "# Using BlockCholesky poseDim " << p << " landMarkDim " << l << " nestedDissection " << nestedDissection << std::endl; \
+    LinearSolverBlockCholesky<DIM_TO_SOLVER(p, l)::PoseMatrixType>* linearSolver = new LinearSolverBlockCholesky<DIM_TO_SOLVER(p, l)::PoseMatrixType>(); \
+    linearSolver->setNestedDissection(nestedDissection); \
+    s = new DIM_TO_SOLVER(p, l)(linearSolver); \
+  } else (void)0
+
+using namespace std;
+
+namespace g2o {
+
+  /**
+   * helper function for allocating
+   */
+  static OptimizationAlgorithm* createSolver(const std::string& fullSolverName)
+  {
+    g2o::Solver* s = 0;
+
+    string methodName = fullSolverName.substr(0, 2);
+    string solverName = fullSolverName.substr(3);
+
+    if (solverName == "var_blockcholesky") {
+      ALLOC_BLOCK_CHOLESKY(s, -1, -1, false);
+    }
+    else if (solverName == "fix3_2_blockcholesky") {
+      ALLOC_BLOCK_CHOLESKY(s, 3, 2, false);
+    }
+    else if (solverName == "fix6_3_blockcholesky") {
+      ALLOC_BLOCK_CHOLESKY(s, 6, 3, false);
+    }
+    else if (solverName == "fix7_3_blockcholesky") {
+      ALLOC_BLOCK_CHOLESKY(s, 7, 3, false);
+    }
+    else if (solverName == "var_blockcholesky_nd") {
+      ALLOC_BLOCK_CHOLESKY(s, -1, -1, true);
+    }
+    else if (solverName == "fix3_2_blockcholesky_nd") {
+      ALLOC_BLOCK_CHOLESKY(s, 3, 2, true);
+    }
+    else if (solverName == "fix6_3_blockcholesky_nd") {
+      ALLOC_BLOCK_CHOLESKY(s, 6, 3, true);
+    }
+    else if (solverName == "fix7_3_blockcholesky_nd") {
+      ALLOC_BLOCK_CHOLESKY(s, 7, 3, true);
+    }
+
+    OptimizationAlgorithm* snl = 0;
+    if (methodName == "gn") {
+      snl = new OptimizationAlgorithmGaussNewton(s);
+    }
+    else if (methodName == "lm") {
+      snl = new OptimizationAlgorithmLevenberg(s);
+    }
+    else if (methodName == "dl") {
+      BlockSolverBase* blockSolver = dynamic_cast<BlockSolverBase*>(s);
+      snl = new OptimizationAlgorithmDogleg(blockSolver);
+    }
+
+    return snl;
+  }
+
+  class BlockCholeskySolverCreator : public AbstractOptimizationAlgorithmCreator
+  {
+    public:
+      BlockCholeskySolverCreator(const OptimizationAlgorithmProperty& p) : AbstractOptimizationAlgorithmCreator(p) {}
+      virtual OptimizationAlgorithm* construct()
+      {
+        return createSolver(property().name);
+      }
+  };
+
+  G2O_REGISTER_OPTIMIZATION_LIBRARY(block_cholesky);
+
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_var_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_var_blockcholesky", "Gauss-Newton: native block Cholesky solver (variable blocksize)", "BlockCholesky", false, Eigen::Dynamic, Eigen::Dynamic)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_fix3_2_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_fix3_2_blockcholesky", "Gauss-Newton: native block Cholesky solver (fixed blocksize)", "BlockCholesky", true, 3, 2)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_fix6_3_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_fix6_3_blockcholesky", "Gauss-Newton: native block Cholesky solver (fixed blocksize)", "BlockCholesky", true, 6, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_fix7_3_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_fix7_3_blockcholesky", "Gauss-Newton: native block Cholesky solver (fixed blocksize)", "BlockCholesky", true, 7, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_var_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_var_blockcholesky", "Levenberg: native block Cholesky solver (variable blocksize)", "BlockCholesky", false, Eigen::Dynamic, Eigen::Dynamic)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_fix3_2_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_fix3_2_blockcholesky", "Levenberg: native block Cholesky solver (fixed blocksize)", "BlockCholesky", true, 3, 2)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_fix6_3_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_fix6_3_blockcholesky", "Levenberg: native block Cholesky solver (fixed blocksize)", "BlockCholesky", true, 6, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_fix7_3_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_fix7_3_blockcholesky", "Levenberg: native block Cholesky solver (fixed blocksize)", "BlockCholesky", true, 7, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(dl_var_blockcholesky, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("dl_var_blockcholesky", "Dogleg: native block Cholesky solver (variable blocksize)", "BlockCholesky", false, Eigen::Dynamic, Eigen::Dynamic)));
+
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_var_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_var_blockcholesky_nd", "Gauss-Newton: native block Cholesky solver with nested dissection ordering (variable blocksize)", "BlockCholesky", false, Eigen::Dynamic, Eigen::Dynamic)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_fix3_2_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_fix3_2_blockcholesky_nd", "Gauss-Newton: native block Cholesky solver with nested dissection ordering (fixed blocksize)", "BlockCholesky", true, 3, 2)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_fix6_3_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_fix6_3_blockcholesky_nd", "Gauss-Newton: native block Cholesky solver with nested dissection ordering (fixed blocksize)", "BlockCholesky", true, 6, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(gn_fix7_3_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("gn_fix7_3_blockcholesky_nd", "Gauss-Newton: native block Cholesky solver with nested dissection ordering (fixed blocksize)", "BlockCholesky", true, 7, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_var_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_var_blockcholesky_nd", "Levenberg: native block Cholesky solver with nested dissection ordering (variable blocksize)", "BlockCholesky", false, Eigen::Dynamic, Eigen::Dynamic)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_fix3_2_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_fix3_2_blockcholesky_nd", "Levenberg: native block Cholesky solver with nested dissection ordering (fixed blocksize)", "BlockCholesky", true, 3, 2)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_fix6_3_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_fix6_3_blockcholesky_nd", "Levenberg: native block Cholesky solver with nested dissection ordering (fixed blocksize)", "BlockCholesky", true, 6, 3)));
+  G2O_REGISTER_OPTIMIZATION_ALGORITHM(lm_fix7_3_blockcholesky_nd, new BlockCholeskySolverCreator(OptimizationAlgorithmProperty("lm_fix7_3_blockcholesky_nd", "Levenberg: native block Cholesky solver with nested dissection ordering (fixed blocksize)", "BlockCholesky", true, 7, 3)));
+
+} // end namespace
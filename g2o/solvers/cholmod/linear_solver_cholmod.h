@@ -29,14 +29,27 @@
 
 #include "g2o/core/linear_solver.h"
 #include "g2o/core/marginal_covariance_cholesky.h"
+#include "g2o/core/sparse_index.h"
 #include "g2o/core/batch_stats.h"
 #include "g2o/stuff/timeutil.h"
 #include "g2o/stuff/sparse_helper.h"
 
 #include <cholmod.h>
 
+#ifdef G2O_USE_64BIT_INDEX
+#define G2O_CHOLMOD(function) cholmod_l_##function
+#define G2O_CHOLMOD_ITYPE CHOLMOD_LONG
+#else
+#define G2O_CHOLMOD(function) cholmod_##function
+#define G2O_CHOLMOD_ITYPE CHOLMOD_INT
+#endif
+
 namespace g2o {
 
+#ifdef G2O_USE_64BIT_INDEX
+static_assert(sizeof(SuiteSparse_long) == sizeof(SparseIndex), "the long interface of CHOLMOD has to agree with SparseIndex");
+#endif
+
 /**
  * \brief Our extension of the CHOLMOD matrix struct
  */
@@ -53,7 +66,7 @@ struct CholmodExt : public cholmod_sparse
     x     = 0;
     z     = 0;
     stype = 1; // upper triangular block only
-    itype = CHOLMOD_INT;
+    itype = G2O_CHOLMOD_ITYPE;
     xtype = CHOLMOD_REAL;
     dtype = CHOLMOD_DOUBLE;
     sorted = 1;
@@ -62,9 +75,9 @@ struct CholmodExt : public cholmod_sparse
   }
   ~CholmodExt()
   {
-    delete[] (int*)p; p = 0;
+    delete[] (SparseIndex*)p; p = 0;
     delete[] (double*)x; x = 0;
-    delete[] (int*)i; i = 0;
+    delete[] (SparseIndex*)i; i = 0;
   }
   size_t columnsAllocated;
 };
@@ -83,7 +96,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
       _blockOrdering = false;
       _cholmodSparse = new CholmodExt();
       _cholmodFactor = 0;
-      cholmod_start(&_cholmodCommon);
+      G2O_CHOLMOD(start)(&_cholmodCommon);
 
       // setup ordering strategy
       _cholmodCommon.nmethods = 1 ;
@@ -97,16 +110,16 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
     {
       delete _cholmodSparse;
       if (_cholmodFactor != 0) {
-        cholmod_free_factor(&_cholmodFactor, &_cholmodCommon);
+        G2O_CHOLMOD(free_factor)(&_cholmodFactor, &_cholmodCommon);
         _cholmodFactor = 0;
       }
-      cholmod_finish(&_cholmodCommon);
+      G2O_CHOLMOD(finish)(&_cholmodCommon);
     }
 
     virtual bool init()
     {
       if (_cholmodFactor != 0) {
-        cholmod_free_factor(&_cholmodFactor, &_cholmodCommon);
+        G2O_CHOLMOD(free_factor)(&_cholmodFactor, &_cholmodCommon);
         _cholmodFactor = 0;
       }
       return true;
@@ -131,7 +144,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
       bcholmod.xtype = CHOLMOD_REAL;
       bcholmod.dtype = CHOLMOD_DOUBLE;
 
-      cholmod_factorize(_cholmodSparse, _cholmodFactor, &_cholmodCommon);
+      G2O_CHOLMOD(factorize)(_cholmodSparse, _cholmodFactor, &_cholmodCommon);
       if (_cholmodCommon.status == CHOLMOD_NOT_POSDEF) {
         if (_writeDebug) {
           std::cerr << "Cholesky failure, writing debug.txt (Hessian loadable by Octave)" << std::endl;
@@ -140,9 +153,9 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
         return false;
       }
 
-      cholmod_dense* xcholmod = cholmod_solve(CHOLMOD_A, _cholmodFactor, &bcholmod, &_cholmodCommon);
+      cholmod_dense* xcholmod = G2O_CHOLMOD(solve)(CHOLMOD_A, _cholmodFactor, &bcholmod, &_cholmodCommon);
       memcpy(x, xcholmod->x, sizeof(double) * bcholmod.nrow); // copy back to our array
-      cholmod_free_dense(&xcholmod, &_cholmodCommon);
+      G2O_CHOLMOD(free_dense)(&xcholmod, &_cholmodCommon);
 
       G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
       if (globalStats){
@@ -173,26 +186,26 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
         }
       }
 
-      cholmod_factorize(_cholmodSparse, _cholmodFactor, &_cholmodCommon);
+      G2O_CHOLMOD(factorize)(_cholmodSparse, _cholmodFactor, &_cholmodCommon);
       if (_cholmodCommon.status == CHOLMOD_NOT_POSDEF)
         return false;
 
       // convert the factorization to LL, simplical, packed, monotonic
-      int change_status = cholmod_change_factor(CHOLMOD_REAL, 1, 0, 1, 1, _cholmodFactor, &_cholmodCommon);
+      int change_status = G2O_CHOLMOD(change_factor)(CHOLMOD_REAL, 1, 0, 1, 1, _cholmodFactor, &_cholmodCommon);
       if (! change_status) {
         return false;
       }
       assert(_cholmodFactor->is_ll && !_cholmodFactor->is_super && _cholmodFactor->is_monotonic && "Cholesky factor has wrong format");
 
       // invert the permutation
-      int* p = (int*)_cholmodFactor->Perm;
-      VectorXI pinv; pinv.resize(_cholmodSparse->ncol);
+      SparseIndex* p = (SparseIndex*)_cholmodFactor->Perm;
+      VectorXSparseIndex pinv; pinv.resize(_cholmodSparse->ncol);
       for (size_t i = 0; i < _cholmodSparse->ncol; ++i)
         pinv(p[i]) = i;
 
       // compute the marginal covariance
       MarginalCovarianceCholesky mcc;
-      mcc.setCholeskyFactor(_cholmodSparse->ncol, (int*)_cholmodFactor->p, (int*)_cholmodFactor->i,
+      mcc.setCholeskyFactor(_cholmodSparse->ncol, (SparseIndex*)_cholmodFactor->p, (SparseIndex*)_cholmodFactor->i,
           (double*)_cholmodFactor->x, pinv.data());
       mcc.computeCovariance(blocks, A.rowBlockIndices());
 
@@ -214,26 +227,26 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
         assert(_cholmodFactor && "Symbolic cholesky failed");
       }
 
-      cholmod_factorize(_cholmodSparse, _cholmodFactor, &_cholmodCommon);
+      G2O_CHOLMOD(factorize)(_cholmodSparse, _cholmodFactor, &_cholmodCommon);
       if (_cholmodCommon.status == CHOLMOD_NOT_POSDEF)
         return false;
 
       // convert the factorization to LL, simplical, packed, monotonic
-      int change_status = cholmod_change_factor(CHOLMOD_REAL, 1, 0, 1, 1, _cholmodFactor, &_cholmodCommon);
+      int change_status = G2O_CHOLMOD(change_factor)(CHOLMOD_REAL, 1, 0, 1, 1, _cholmodFactor, &_cholmodCommon);
       if (! change_status) {
         return false;
       }
       assert(_cholmodFactor->is_ll && !_cholmodFactor->is_super && _cholmodFactor->is_monotonic && "Cholesky factor has wrong format");
 
       // invert the permutation
-      int* p = (int*)_cholmodFactor->Perm;
-      VectorXI pinv; pinv.resize(_cholmodSparse->ncol);
+      SparseIndex* p = (SparseIndex*)_cholmodFactor->Perm;
+      VectorXSparseIndex pinv; pinv.resize(_cholmodSparse->ncol);
       for (size_t i = 0; i < _cholmodSparse->ncol; ++i)
         pinv(p[i]) = i;
 
       // compute the marginal covariance
       MarginalCovarianceCholesky mcc;
-      mcc.setCholeskyFactor(_cholmodSparse->ncol, (int*)_cholmodFactor->p, (int*)_cholmodFactor->i,
+      mcc.setCholeskyFactor(_cholmodSparse->ncol, (SparseIndex*)_cholmodFactor->p, (SparseIndex*)_cholmodFactor->i,
           (double*)_cholmodFactor->x, pinv.data());
       mcc.computeCovariance(spinv, A.rowBlockIndices(), blockIndices);
 
@@ -254,7 +267,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
     virtual void setWriteDebug(bool b) { _writeDebug = b;}
 
     virtual bool saveMatrix(const std::string& fileName) {
-      writeCCSMatrix(fileName, _cholmodSparse->nrow, _cholmodSparse->ncol, (int*)_cholmodSparse->p, (int*)_cholmodSparse->i, (double*)_cholmodSparse->x, true);
+      writeCCSMatrix(fileName, _cholmodSparse->nrow, _cholmodSparse->ncol, (SparseIndex*)_cholmodSparse->p, (SparseIndex*)_cholmodSparse->i, (double*)_cholmodSparse->x, true);
       return true;
     }
 
@@ -265,7 +278,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
     cholmod_factor* _cholmodFactor;
     bool _blockOrdering;
     MatrixStructure _matrixStructure;
-    VectorXI _scalarPermutation, _blockPermutation;
+    VectorXSparseIndex _scalarPermutation, _blockPermutation;
     bool _writeDebug;
 
     void computeSymbolicDecomposition(const SparseBlockMatrix<MatrixType>& A)
@@ -275,7 +288,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
         // setup ordering strategy
         _cholmodCommon.nmethods = 1;
         _cholmodCommon.method[0].ordering = CHOLMOD_AMD; //CHOLMOD_COLAMD
-        _cholmodFactor = cholmod_analyze(_cholmodSparse, &_cholmodCommon); // symbolic factorization
+        _cholmodFactor = G2O_CHOLMOD(analyze)(_cholmodSparse, &_cholmodCommon); // symbolic factorization
       } else {
 
         A.fillBlockStructure(_matrixStructure);
@@ -297,11 +310,11 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
         auxCholmodSparse.z = 0;
         auxCholmodSparse.stype = 1;
         auxCholmodSparse.xtype = CHOLMOD_PATTERN;
-        auxCholmodSparse.itype = CHOLMOD_INT;
+        auxCholmodSparse.itype = G2O_CHOLMOD_ITYPE;
         auxCholmodSparse.dtype = CHOLMOD_DOUBLE;
         auxCholmodSparse.sorted = 1;
         auxCholmodSparse.packed = 1;
-        int amdStatus = cholmod_amd(&auxCholmodSparse, NULL, 0, _blockPermutation.data(), &_cholmodCommon);
+        int amdStatus = G2O_CHOLMOD(amd)(&auxCholmodSparse, NULL, 0, _blockPermutation.data(), &_cholmodCommon);
         if (! amdStatus) {
           return;
         }
@@ -313,7 +326,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
           _scalarPermutation.resize(2*_cholmodSparse->ncol);
         size_t scalarIdx = 0;
         for (int i = 0; i < _matrixStructure.n; ++i) {
-          const int& p = _blockPermutation(i);
+          int p = static_cast<int>(_blockPermutation(i));
           int base  = A.colBaseOfBlock(p);
           int nCols = A.colsOfBlock(p);
           for (int j = 0; j < nCols; ++j)
@@ -324,7 +337,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
         // apply the ordering
         _cholmodCommon.nmethods = 1 ;
         _cholmodCommon.method[0].ordering = CHOLMOD_GIVEN;
-        _cholmodFactor = cholmod_analyze_p(_cholmodSparse, _scalarPermutation.data(), NULL, 0, &_cholmodCommon);
+        _cholmodFactor = G2O_CHOLMOD(analyze_p)(_cholmodSparse, _scalarPermutation.data(), NULL, 0, &_cholmodCommon);
 
       }
       G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
@@ -348,8 +361,8 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
       if (_cholmodSparse->columnsAllocated < n) {
         //std::cerr << __PRETTY_FUNCTION__ << ": reallocating columns" << std::endl;
         _cholmodSparse->columnsAllocated = _cholmodSparse->columnsAllocated == 0 ? n : 2 * n; // pre-allocate more space if re-allocating
-        delete[] (int*)_cholmodSparse->p;
-        _cholmodSparse->p = new int[_cholmodSparse->columnsAllocated+1];
+        delete[] (SparseIndex*)_cholmodSparse->p;
+        _cholmodSparse->p = new SparseIndex[_cholmodSparse->columnsAllocated+1];
       }
       if (! onlyValues) {
         size_t nzmax = A.nonZeros();
@@ -357,8 +370,8 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
           //std::cerr << __PRETTY_FUNCTION__ << ": reallocating row + values" << std::endl;
           _cholmodSparse->nzmax = _cholmodSparse->nzmax == 0 ? nzmax : 2 * nzmax; // pre-allocate more space if re-allocating
           delete[] (double*)_cholmodSparse->x;
-          delete[] (int*)_cholmodSparse->i;
-          _cholmodSparse->i = new int[_cholmodSparse->nzmax];
+          delete[] (SparseIndex*)_cholmodSparse->i;
+          _cholmodSparse->i = new SparseIndex[_cholmodSparse->nzmax];
           _cholmodSparse->x = new double[_cholmodSparse->nzmax];
         }
       }
@@ -368,7 +381,7 @@ class LinearSolverCholmod : public LinearSolverCCS<MatrixType>
       if (onlyValues)
         this->_ccsMatrix->fillCCS((double*)_cholmodSparse->x, true);
       else
-        this->_ccsMatrix->fillCCS((int*)_cholmodSparse->p, (int*)_cholmodSparse->i, (double*)_cholmodSparse->x, true);
+        this->_ccsMatrix->fillCCS((SparseIndex*)_cholmodSparse->p, (SparseIndex*)_cholmodSparse->i, (double*)_cholmodSparse->x, true);
     }
 
 };
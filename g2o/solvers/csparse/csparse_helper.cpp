@@ -53,10 +53,11 @@ namespace csparse_extension {
    * Originally from CSparse, avoid memory re-allocations by giving workspace pointers
    * CSparse: Copyright (c) 2006-2011, Timothy A. Davis.
    */
-  int cs_cholsolsymb(const cs *A, double *b, const css* S, double* x, int* work)
+  int cs_cholsolsymb(const cs *A, double *b, const css* S, double* x, csi* work)
   {
     csn *N ;
-    int n, ok ;
+    csi n ;
+    int ok ;
     if (!CS_CSC (A) || !b || ! S || !x) {
       fprintf(stderr, "%s: No valid input!\n", __PRETTY_FUNCTION__);
       assert(0); // get a backtrace in debug mode
@@ -80,66 +81,126 @@ namespace csparse_extension {
     return (ok) ;
   }
 
-  /**
-   * Originally from CSparse, avoid memory re-allocations by giving workspace pointers
-   * CSparse: Copyright (c) 2006-2011, Timothy A. Davis.
-   */
-  /* L = chol (A, [pinv parent cp]), pinv is optional */
-  csn* cs_chol_workspace (const cs *A, const css *S, int* cin, double* xin)
-  {
-    double d, lki, *Lx, *x, *Cx ;
-    int top, i, p, k, n, *Li, *Lp, *cp, *pinv, *s, *c, *parent, *Cp, *Ci ;
-    cs *L, *C, *E ;
-    csn *N ;
-    if (!CS_CSC (A) || !S || !S->cp || !S->parent) return (NULL) ;
-    n = A->n ;
-    N = (csn*) cs_calloc (1, sizeof (csn)) ;       /* allocate result */
-    c = cin ;     /* get int workspace */
-    x = xin ;    /* get double workspace */
-    cp = S->cp ; pinv = S->pinv ; parent = S->parent ;
-    C = pinv ? cs_symperm (A, pinv, 1) : ((cs *) A) ;
-    E = pinv ? C : NULL ;           /* E is alias for A, or a copy E=A(p,p) */
-    if (!N || !c || !x || !C) return (cs_ndone (N, E, NULL, NULL, 0)) ;
-    s = c + n ;
-    Cp = C->p ; Ci = C->i ; Cx = C->x ;
-    N->L = L = cs_spalloc (n, n, cp [n], 1, 0) ;    /* allocate result */
-    if (!L) return (cs_ndone (N, E, NULL, NULL, 0)) ;
-    Lp = L->p ; Li = L->i ; Lx = L->x ;
-    for (k = 0 ; k < n ; k++) Lp [k] = c [k] = cp [k] ;
-    for (k = 0 ; k < n ; k++)       /* compute L(k,:) for L*L' = C */
+  namespace {
+    //! reads the values of C from its value array
+    struct DirectValues
     {
-      /* --- Nonzero pattern of L(k,:) ------------------------------------ */
-      top = cs_ereach (C, k, parent, s, c) ;      /* find pattern of L(k,:) */
-      x [k] = 0 ;                                 /* x (0:k) is now zero */
-      for (p = Cp [k] ; p < Cp [k+1] ; p++)       /* x = full(triu(C(:,k))) */
-      {
-        if (Ci [p] <= k) x [Ci [p]] = Cx [p] ;
-      }
-      d = x [k] ;                     /* d = C(k,k) */
-      x [k] = 0 ;                     /* clear x for k+1st iteration */
-      /* --- Triangular solve --------------------------------------------- */
-      for ( ; top < n ; top++)    /* solve L(0:k-1,0:k-1) * x = C(:,k) */
+      const double* Cx;
+      DirectValues(const double* x) : Cx(x) {}
+      double operator[](csi p) const { return Cx[p];}
+    };
+
+    //! reads the values of C through an array of pointers to the values
+    struct IndirectValues
+    {
+      const double* const* Cx;
+      IndirectValues(const double* const* x) : Cx(x) {}
+      double operator[](csi p) const { return *Cx[p];}
+    };
+
+    /**
+     * Originally from CSparse, avoid memory re-allocations by giving workspace pointers
+     * CSparse: Copyright (c) 2006-2011, Timothy A. Davis.
+     * C is the already permuted matrix, E is freed on return.
+     */
+    template <typename Values>
+    csn* cs_chol_permuted(const cs* C, const Values& Cx, const css* S, csi* cin, double* xin, cs* E)
+    {
+      double d, lki, *Lx, *x ;
+      csi top, i, p, k, n, *Li, *Lp, *cp, *s, *c, *parent, *Cp, *Ci ;
+      cs *L ;
+      csn *N ;
+      n = C->n ;
+      N = (csn*) cs_calloc (1, sizeof (csn)) ;       /* allocate result */
+      c = cin ;     /* get int workspace */
+      x = xin ;    /* get double workspace */
+      cp = S->cp ; parent = S->parent ;
+      if (!N || !c || !x) return (cs_ndone (N, E, NULL, NULL, 0)) ;
+      s = c + n ;
+      Cp = C->p ; Ci = C->i ;
+      N->L = L = cs_spalloc (n, n, cp [n], 1, 0) ;    /* allocate result */
+      if (!L) return (cs_ndone (N, E, NULL, NULL, 0)) ;
+      Lp = L->p ; Li = L->i ; Lx = L->x ;
+      for (k = 0 ; k < n ; k++) Lp [k] = c [k] = cp [k] ;
+      for (k = 0 ; k < n ; k++)       /* compute L(k,:) for L*L' = C */
       {
-        i = s [top] ;               /* s [top..n-1] is pattern of L(k,:) */
-        lki = x [i] / Lx [Lp [i]] ; /* L(k,i) = x (i) / L(i,i) */
-        x [i] = 0 ;                 /* clear x for k+1st iteration */
-        for (p = Lp [i] + 1 ; p < c [i] ; p++)
+        /* --- Nonzero pattern of L(k,:) ------------------------------------ */
+        top = cs_ereach (C, k, parent, s, c) ;      /* find pattern of L(k,:) */
+        x [k] = 0 ;                                 /* x (0:k) is now zero */
+        for (p = Cp [k] ; p < Cp [k+1] ; p++)       /* x = full(triu(C(:,k))) */
         {
-          x [Li [p]] -= Lx [p] * lki ;
+          if (Ci [p] <= k) x [Ci [p]] = Cx [p] ;
         }
-        d -= lki * lki ;            /* d = d - L(k,i)*L(k,i) */
-        p = c [i]++ ;
-        Li [p] = k ;                /* store L(k,i) in column i */
-        Lx [p] = lki ;
+        d = x [k] ;                     /* d = C(k,k) */
+        x [k] = 0 ;                     /* clear x for k+1st iteration */
+        /* --- Triangular solve --------------------------------------------- */
+        for ( ; top < n ; top++)    /* solve L(0:k-1,0:k-1) * x = C(:,k) */
+        {
+          i = s [top] ;               /* s [top..n-1] is pattern of L(k,:) */
+          lki = x [i] / Lx [Lp [i]] ; /* L(k,i) = x (i) / L(i,i) */
+          x [i] = 0 ;                 /* clear x for k+1st iteration */
+          for (p = Lp [i] + 1 ; p < c [i] ; p++)
+          {
+            x [Li [p]] -= Lx [p] * lki ;
+          }
+          d -= lki * lki ;            /* d = d - L(k,i)*L(k,i) */
+          p = c [i]++ ;
+          Li [p] = k ;                /* store L(k,i) in column i */
+          Lx [p] = lki ;
+        }
+        /* --- Compute L(k,k) ----------------------------------------------- */
+        if (d <= 0) return (cs_ndone (N, E, NULL, NULL, 0)) ; /* not pos def */
+        p = c [k]++ ;
+        Li [p] = k ;                /* store L(k,k) = sqrt (d) in column k */
+        Lx [p] = sqrt (d) ;
       }
-      /* --- Compute L(k,k) ----------------------------------------------- */
-      if (d <= 0) return (cs_ndone (N, E, NULL, NULL, 0)) ; /* not pos def */
-      p = c [k]++ ;
-      Li [p] = k ;                /* store L(k,k) = sqrt (d) in column k */
-      Lx [p] = sqrt (d) ;
+      Lp [n] = cp [n] ;               /* finalize L */
+      return (cs_ndone (N, E, NULL, NULL, 1)) ; /* success: free E,s,x; return N */
+    }
+  }
+
+  /* L = chol (A, [pinv parent cp]), pinv is optional */
+  csn* cs_chol_workspace (const cs *A, const css *S, csi* cin, double* xin)
+  {
+    cs *C, *E ;
+    if (!CS_CSC (A) || !S || !S->cp || !S->parent) return (NULL) ;
+    C = S->pinv ? cs_symperm (A, S->pinv, 1) : ((cs *) A) ;
+    E = S->pinv ? C : NULL ;           /* E is alias for A, or a copy E=A(p,p) */
+    if (!C) return (NULL) ;
+    return cs_chol_permuted(C, DirectValues(C->x), S, cin, xin, E);
+  }
+
+  csn* cs_chol_pointers(const cs *C, const double* const* Cx, const css *S, csi* cin, double* xin)
+  {
+    if (!CS_CSC (C) || !Cx || !S || !S->cp || !S->parent) return (NULL) ;
+    return cs_chol_permuted(C, IndirectValues(Cx), S, cin, xin, NULL);
+  }
+
+  int cs_cholsolsymb_pointers(const cs *C, const double* const* Cx, double *b, const css* S, double* x, csi* work)
+  {
+    csn *N ;
+    csi n ;
+    int ok ;
+    if (!CS_CSC (C) || !Cx || !b || ! S || !x) {
+      fprintf(stderr, "%s: No valid input!\n", __PRETTY_FUNCTION__);
+      assert(0); // get a backtrace in debug mode
+      return (0) ;     /* check inputs */
     }
-    Lp [n] = cp [n] ;               /* finalize L */
-    return (cs_ndone (N, E, NULL, NULL, 1)) ; /* success: free E,s,x; return N */
+    n = C->n ;
+    N = cs_chol_pointers (C, Cx, S, work, x) ;               /* numeric Cholesky factorization */
+    if (!N) {
+      fprintf(stderr, "%s: cholesky failed!\n", __PRETTY_FUNCTION__);
+    }
+    ok = (N != NULL) ;
+    if (ok)
+    {
+      cs_ipvec (S->pinv, b, x, n) ;   /* x = P*b */
+      cs_lsolve (N->L, x) ;           /* x = L\x */
+      cs_ltsolve (N->L, x) ;          /* x = L'\x */
+      cs_pvec (S->pinv, x, b, n) ;    /* b = P'*x */
+    }
+    cs_nfree (N) ;
+    return (ok) ;
   }
 
   bool writeCs2Octave(const char* filename, const cs* A, bool upperTriangular)
@@ -154,13 +215,13 @@ namespace csparse_extension {
 
     vector<SparseMatrixEntry> entries;
     if (A->nz == -1) { // CCS matrix
-      const int* Ap = A->p;
-      const int* Ai = A->i;
+      const csi* Ap = A->p;
+      const csi* Ai = A->i;
       const double* Ax = A->x;
       for (int i=0; i < cols; i++) {
-        const int& rbeg = Ap[i];
-        const int& rend = Ap[i+1];
-        for (int j = rbeg; j < rend; j++) {
+        const csi& rbeg = Ap[i];
+        const csi& rend = Ap[i+1];
+        for (csi j = rbeg; j < rend; j++) {
           entries.push_back(SparseMatrixEntry(Ai[j], i, Ax[j]));
           if (upperTriangular && Ai[j] != i)
             entries.push_back(SparseMatrixEntry(i, Ai[j], Ax[j]));
@@ -168,10 +229,10 @@ namespace csparse_extension {
       }
     } else { // Triplet matrix
       entries.reserve(A->nz);
-      int *Aj = A->p;             // column indeces
-      int *Ai = A->i;             // row indices
+      csi *Aj = A->p;             // column indeces
+      csi *Ai = A->i;             // row indices
       double *Ax = A->x;          // values;
-      for (int i = 0; i < A->nz; ++i) {
+      for (csi i = 0; i < A->nz; ++i) {
         entries.push_back(SparseMatrixEntry(Ai[i], Aj[i], Ax[i]));
         if (upperTriangular && Ai[i] != Aj[i])
           entries.push_back(SparseMatrixEntry(Aj[i], Ai[i], Ax[i]));
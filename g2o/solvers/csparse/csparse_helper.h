@@ -17,6 +17,8 @@
 #ifndef G2O_CSPARSE_HELPER_H
 #define G2O_CSPARSE_HELPER_H
 
+#include "g2o/config.h"
+
 #ifndef NCOMPLEX
 #define NCOMPLEX
 #endif
@@ -34,8 +36,15 @@ namespace g2o {
 G2O_CSPARSE_EXTENSION_API bool writeCs2Octave(const char* filename, const cs* A, bool upperTriangular = true);
 
 // our extensions to csparse
-G2O_CSPARSE_EXTENSION_API csn* cs_chol_workspace (const cs *A, const css *S, int* cin, double* xin);
-G2O_CSPARSE_EXTENSION_API int cs_cholsolsymb(const cs *A, double *b, const css* S, double* workspace, int* work);
+G2O_CSPARSE_EXTENSION_API csn* cs_chol_workspace (const cs *A, const css *S, csi* cin, double* xin);
+G2O_CSPARSE_EXTENSION_API int cs_cholsolsymb(const cs *A, double *b, const css* S, double* workspace, csi* work);
+
+/**
+ * Cholesky factorization of the already permuted matrix C = A(p,p) without
+ * copying its values, the p-th value of C is read from *Cx[p].
+ */
+G2O_CSPARSE_EXTENSION_API csn* cs_chol_pointers (const cs *C, const double* const* Cx, const css *S, csi* cin, double* xin);
+G2O_CSPARSE_EXTENSION_API int cs_cholsolsymb_pointers(const cs *C, const double* const* Cx, double *b, const css* S, double* workspace, csi* work);
 
 } // end namespace
 } // end namespace
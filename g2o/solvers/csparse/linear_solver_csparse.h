@@ -32,13 +32,18 @@
 #include "g2o/core/linear_solver.h"
 #include "g2o/core/batch_stats.h"
 #include "g2o/core/marginal_covariance_cholesky.h"
+#include "g2o/core/sparse_index.h"
 #include "g2o/stuff/timeutil.h"
 #include "g2o_csparse_api.h"
 
 #include <iostream>
+#include <type_traits>
+#include <vector>
 
 namespace g2o {
 
+static_assert(std::is_same<csi, SparseIndex>::value, "the index type of CSparse has to agree with G2O_USE_64BIT_INDEX");
+
 /**
  * \brief Our C++ version of the csparse struct
  */
@@ -81,6 +86,8 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
       _ccsA = new CSparseExt;
       _blockOrdering = true;
       _writeDebug = true;
+      _zeroCopy = true;
+      _permutedPattern = 0;
     }
 
     virtual ~LinearSolverCSparse()
@@ -92,6 +99,10 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
       delete[] _csWorkspace; _csWorkspace = 0;
       delete[] _csIntWorkspace; _csIntWorkspace = 0;
       delete _ccsA;
+      if (_permutedPattern) {
+        cs_spfree(_permutedPattern);
+        _permutedPattern = 0;
+      }
     }
 
     virtual bool init()
@@ -100,33 +111,47 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
         cs_sfree(_symbolicDecomposition);
         _symbolicDecomposition = 0;
       }
+      if (_permutedPattern) {
+        cs_spfree(_permutedPattern);
+        _permutedPattern = 0;
+      }
       return true;
     }
 
     bool solve(const SparseBlockMatrix<MatrixType>& A, double* x, double* b)
     {
-      fillCSparse(A, _symbolicDecomposition != 0);
       // perform symbolic cholesky once
       if (_symbolicDecomposition == 0) {
+        fillCSparse(A, false);
         computeSymbolicDecomposition(A);
+      } else if (! _zeroCopy) {
+        fillCSparse(A, true);
       }
+      if (_zeroCopy && _permutedPattern == 0)
+        computeValuePointers();
       // re-allocate the temporary workspace for cholesky
       if (_csWorkspaceSize < _ccsA->n) {
         _csWorkspaceSize = 2 * _ccsA->n;
         delete[] _csWorkspace;
         _csWorkspace = new double[_csWorkspaceSize];
         delete[] _csIntWorkspace;
-        _csIntWorkspace = new int[2*_csWorkspaceSize];
+        _csIntWorkspace = new csi[2*_csWorkspaceSize];
       }
 
       double t=get_monotonic_time();
       // _x = _b for calling csparse
       if (x != b)
         memcpy(x, b, _ccsA->n * sizeof(double));
-      int ok = csparse_extension::cs_cholsolsymb(_ccsA, x, _symbolicDecomposition, _csWorkspace, _csIntWorkspace);
+      int ok;
+      if (_zeroCopy)
+        ok = csparse_extension::cs_cholsolsymb_pointers(_permutedPattern, &_permutedValues[0], x, _symbolicDecomposition, _csWorkspace, _csIntWorkspace);
+      else
+        ok = csparse_extension::cs_cholsolsymb(_ccsA, x, _symbolicDecomposition, _csWorkspace, _csIntWorkspace);
       if (! ok) {
         if (_writeDebug) {
           std::cerr << "Cholesky failure, writing debug.txt (Hessian loadable by Octave)" << std::endl;
+          if (_zeroCopy)
+            fillCSparse(A, true);
           csparse_extension::writeCs2Octave("debug.txt", _ccsA, true);
         }
         return false;
@@ -154,7 +179,7 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
         delete[] _csWorkspace;
         _csWorkspace = new double[_csWorkspaceSize];
         delete[] _csIntWorkspace;
-        _csIntWorkspace = new int[2*_csWorkspaceSize];
+        _csIntWorkspace = new csi[2*_csWorkspaceSize];
       }
 
       if (! blocks){
@@ -200,7 +225,7 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
         delete[] _csWorkspace;
         _csWorkspace = new double[_csWorkspaceSize];
         delete[] _csIntWorkspace;
-        _csIntWorkspace = new int[2*_csWorkspaceSize];
+        _csIntWorkspace = new csi[2*_csWorkspaceSize];
       }
 
 
@@ -232,16 +257,50 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
     virtual bool writeDebug() const { return _writeDebug;}
     virtual void setWriteDebug(bool b) { _writeDebug = b;}
 
+    /**
+     * read the values of A in place during the numeric factorization in solve()
+     * instead of copying them into the CCS matrix in each iteration
+     */
+    bool zeroCopy() const { return _zeroCopy;}
+    void setZeroCopy(bool zeroCopy) { _zeroCopy = zeroCopy;}
+
   protected:
     css* _symbolicDecomposition;
     int _csWorkspaceSize;
     double* _csWorkspace;
-    int* _csIntWorkspace;
+    csi* _csIntWorkspace;
     CSparseExt* _ccsA;
     bool _blockOrdering;
     MatrixStructure _matrixStructure;
-    VectorXI _scalarPermutation;
+    VectorXSparseIndex _scalarPermutation;
     bool _writeDebug;
+    bool _zeroCopy;
+    cs* _permutedPattern;                        ///< pattern of the permuted matrix P A P^T
+    std::vector<const double*> _permutedValues;  ///< addresses of the values of P A P^T inside the blocks of A
+
+    /**
+     * compute the pattern of the permuted matrix and where each of its values
+     * is stored in the blocks of A. Afterwards the numeric factorization reads
+     * A in place as long as the structure does not change.
+     */
+    void computeValuePointers()
+    {
+      const csi& n = _ccsA->n;
+      const csi nz = _ccsA->p[n];
+      std::vector<const double*> valuePointers(nz);
+      this->_ccsMatrix->fillValuePointers(&valuePointers[0], true);
+
+      // track where the permutation moves the values by permuting their indices
+      for (csi i = 0; i < nz; ++i)
+        _ccsA->x[i] = static_cast<double>(i);
+      _permutedPattern = cs_symperm(_ccsA, _symbolicDecomposition->pinv, 1);
+      const csi permutedNz = _permutedPattern->p[n];
+      _permutedValues.resize(permutedNz);
+      for (csi i = 0; i < permutedNz; ++i)
+        _permutedValues[i] = valuePointers[static_cast<csi>(_permutedPattern->x[i])];
+      cs_free(_permutedPattern->x);
+      _permutedPattern->x = 0;
+    }
 
     void computeSymbolicDecomposition(const SparseBlockMatrix<MatrixType>& A)
     {
@@ -261,8 +320,8 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
         auxBlock.nz = -1; // CCS format
 
         // AMD ordering on the block structure
-        const int& n = _ccsA->n;
-        int* P = cs_amd(1, &auxBlock);
+        const csi& n = _ccsA->n;
+        csi* P = cs_amd(1, &auxBlock);
 
         // blow up the permutation to the scalar matrix
         if (_scalarPermutation.size() == 0)
@@ -271,7 +330,7 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
           _scalarPermutation.resize(2*n);
         size_t scalarIdx = 0;
         for (int i = 0; i < _matrixStructure.n; ++i) {
-          const int& p = P[i];
+          int p = static_cast<int>(P[i]);
           int base  = A.colBaseOfBlock(p);
           int nCols = A.colsOfBlock(p);
           for (int j = 0; j < nCols; ++j)
@@ -285,11 +344,11 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
         _symbolicDecomposition->pinv = cs_pinv(_scalarPermutation.data(), n);
         cs* C = cs_symperm(_ccsA, _symbolicDecomposition->pinv, 0);
         _symbolicDecomposition->parent = cs_etree(C, 0);
-        int* post = cs_post(_symbolicDecomposition->parent, n);
-        int* c = cs_counts(C, _symbolicDecomposition->parent, post, 0);
+        csi* post = cs_post(_symbolicDecomposition->parent, n);
+        csi* c = cs_counts(C, _symbolicDecomposition->parent, post, 0);
         cs_free(post);
         cs_spfree(C);
-        _symbolicDecomposition->cp = (int*) cs_malloc(n+1, sizeof(int));
+        _symbolicDecomposition->cp = (csi*) cs_malloc(n+1, sizeof(csi));
         _symbolicDecomposition->unz = _symbolicDecomposition->lnz = cs_cumsum(_symbolicDecomposition->cp, c, n);
         cs_free(c);
         if (_symbolicDecomposition->lnz < 0) {
@@ -318,16 +377,16 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
       if (_ccsA->columnsAllocated < n) {
         _ccsA->columnsAllocated = _ccsA->columnsAllocated == 0 ? n : 2 * n; // pre-allocate more space if re-allocating
         delete[] _ccsA->p;
-        _ccsA->p = new int[_ccsA->columnsAllocated+1];
+        _ccsA->p = new csi[_ccsA->columnsAllocated+1];
       }
 
       if (! onlyValues) {
-        int nzmax = A.nonZeros();
+        csi nzmax = static_cast<csi>(A.nonZeros());
         if (_ccsA->nzmax < nzmax) {
           _ccsA->nzmax = _ccsA->nzmax == 0 ? nzmax : 2 * nzmax; // pre-allocate more space if re-allocating
           delete[] _ccsA->x;
           delete[] _ccsA->i;
-          _ccsA->i = new int[_ccsA->nzmax];
+          _ccsA->i = new csi[_ccsA->nzmax];
           _ccsA->x = new double[_ccsA->nzmax];
         }
       }
@@ -337,7 +396,7 @@ class LinearSolverCSparse : public LinearSolverCCS<MatrixType>
       if (onlyValues) {
         this->_ccsMatrix->fillCCS(_ccsA->x, true);
       } else {
-        int nz = this->_ccsMatrix->fillCCS(_ccsA->p, _ccsA->i, _ccsA->x, true); (void) nz;
+        SparseIndex nz = this->_ccsMatrix->fillCCS(_ccsA->p, _ccsA->i, _ccsA->x, true); (void) nz;
         assert(nz <= _ccsA->nzmax);
       }
       _ccsA->nz=-1; // tag as CCS formatted matrix
@@ -32,6 +32,7 @@
 
 #include "g2o/core/linear_solver.h"
 #include "g2o/core/batch_stats.h"
+#include "g2o/core/sparse_index.h"
 #include "g2o/stuff/timeutil.h"
 
 #include <iostream>
@@ -44,38 +45,48 @@ namespace g2o {
  *
  * Has no dependencies except Eigen. Hence, should compile almost everywhere
  * without to much issues. Performance should be similar to CSparse, I guess.
+ *
+ * Optionally the factorization is computed in single precision and the
+ * solution is refined by a few steps of iterative refinement against A in
+ * double precision.
  */
 template <typename MatrixType>
 class LinearSolverEigen: public LinearSolver<MatrixType>
 {
   public:
-    typedef Eigen::SparseMatrix<double, Eigen::ColMajor> SparseMatrix;
-    typedef Eigen::Triplet<double> Triplet;
-    typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, SparseMatrix::Index> PermutationMatrix;
+    typedef Eigen::SparseMatrix<double, Eigen::ColMajor, SparseIndex> SparseMatrix;
+    typedef Eigen::SparseMatrix<float, Eigen::ColMajor, SparseIndex> SparseMatrixF;
+    typedef Eigen::Triplet<double, SparseIndex> Triplet;
+    typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, SparseIndex> PermutationMatrix;
+    typedef Eigen::Matrix<float, Eigen::Dynamic, 1> VectorXF;
     /**
      * \brief Sub-classing Eigen's SimplicialLDLT to perform ordering with a given ordering
      */
-    class CholeskyDecomposition : public Eigen::SimplicialLDLT<SparseMatrix, Eigen::Upper>
+    template <typename SparseMatrixT>
+    class CholeskyDecompositionT : public Eigen::SimplicialLDLT<SparseMatrixT, Eigen::Upper>
     {
       public:
-        CholeskyDecomposition() : Eigen::SimplicialLDLT<SparseMatrix, Eigen::Upper>() {}
-        using Eigen::SimplicialLDLT< SparseMatrix, Eigen::Upper>::analyzePattern_preordered;
+        typedef Eigen::SimplicialLDLT<SparseMatrixT, Eigen::Upper> Base;
+        CholeskyDecompositionT() : Base() {}
+        using Base::analyzePattern_preordered;
 
-        void analyzePatternWithPermutation(SparseMatrix& a, const PermutationMatrix& permutation)
+        void analyzePatternWithPermutation(SparseMatrixT& a, const PermutationMatrix& permutation)
         {
-          m_Pinv = permutation;
-          m_P = permutation.inverse();
+          this->m_Pinv = permutation;
+          this->m_P = permutation.inverse();
           int size = a.cols();
-          SparseMatrix ap(size, size);
-          ap.selfadjointView<Eigen::Upper>() = a.selfadjointView<UpLo>().twistedBy(m_P);
+          SparseMatrixT ap(size, size);
+          ap.template selfadjointView<Eigen::Upper>() = a.template selfadjointView<Base::UpLo>().twistedBy(this->m_P);
           analyzePattern_preordered(ap, true);
         }
     };
+    typedef CholeskyDecompositionT<SparseMatrix> CholeskyDecomposition;
+    typedef CholeskyDecompositionT<SparseMatrixF> CholeskyDecompositionF;
 
   public:
     LinearSolverEigen() :
       LinearSolver<MatrixType>(),
-      _init(true), _blockOrdering(false), _writeDebug(false)
+      _init(true), _blockOrdering(false), _writeDebug(false), _singlePrecision(false), _refinementSteps(2)
     {
     }
 
@@ -94,13 +105,27 @@ class LinearSolverEigen: public LinearSolver<MatrixType>
       if (_init)
         _sparseMatrix.resize(A.rows(), A.cols());
       fillSparseMatrix(A, !_init);
+      if (_singlePrecision) {
+        if (_init)
+          _sparseMatrixF = _sparseMatrix.template cast<float>();
+        else // same pattern, only convert the values
+          Eigen::Map<VectorXF>(_sparseMatrixF.valuePtr(), _sparseMatrixF.nonZeros())
+            = Eigen::Map<const VectorXD>(_sparseMatrix.valuePtr(), _sparseMatrix.nonZeros()).template cast<float>();
+      }
       if (_init) // compute the symbolic composition once
         computeSymbolicDecomposition(A);
       _init = false;
 
       double t=get_monotonic_time();
-      _cholesky.factorize(_sparseMatrix);
-      if (_cholesky.info() != Eigen::Success) { // the matrix is not positive definite
+      bool ok;
+      if (_singlePrecision) {
+        _choleskyF.factorize(_sparseMatrixF);
+        ok = _choleskyF.info() == Eigen::Success;
+      } else {
+        _cholesky.factorize(_sparseMatrix);
+        ok = _cholesky.info() == Eigen::Success;
+      }
+      if (! ok) { // the matrix is not positive definite
         if (_writeDebug) {
           std::cerr << "Cholesky failure, writing debug.txt (Hessian loadable by Octave)" << std::endl;
           A.writeOctave("debug.txt");
@@ -111,11 +136,25 @@ class LinearSolverEigen: public LinearSolver<MatrixType>
       // Solving the system
       VectorXD::MapType xx(x, _sparseMatrix.cols());
       VectorXD::ConstMapType bb(b, _sparseMatrix.cols());
-      xx = _cholesky.solve(bb);
+      if (! _singlePrecision) {
+        xx = _cholesky.solve(bb);
+      } else {
+        // iterative refinement in double precision: x += (L D L^T)^-1 (b - A x)
+        xx = _choleskyF.solve(bb.template cast<float>()).template cast<double>();
+        for (int i = 0; i < _refinementSteps; ++i) {
+          _residual = bb - _sparseMatrix.template selfadjointView<Eigen::Upper>() * xx;
+          xx += _choleskyF.solve(_residual.template cast<float>()).template cast<double>();
+        }
+      }
       G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
       if (globalStats) {
         globalStats->timeNumericDecomposition = get_monotonic_time() - t;
-        globalStats->choleskyNNZ = _cholesky.matrixL().nestedExpression().nonZeros() + _sparseMatrix.cols(); // the elements of D
+        if (_singlePrecision) {
+          globalStats->choleskyNNZ = _choleskyF.matrixL().nestedExpression().nonZeros() + _sparseMatrix.cols(); // the elements of D
+          globalStats->iterationsRefinement = _refinementSteps;
+        } else {
+          globalStats->choleskyNNZ = _cholesky.matrixL().nestedExpression().nonZeros() + _sparseMatrix.cols(); // the elements of D
+        }
       }
 
       return true;
@@ -129,12 +168,30 @@ class LinearSolverEigen: public LinearSolver<MatrixType>
     virtual bool writeDebug() const { return _writeDebug;}
     virtual void setWriteDebug(bool b) { _writeDebug = b;}
 
+    //! factorize A in single precision and refine the solution in double precision
+    virtual bool singlePrecision() const { return _singlePrecision;}
+    virtual void setSinglePrecision(bool singlePrecision)
+    {
+      if (singlePrecision != _singlePrecision)
+        _init = true;
+      _singlePrecision = singlePrecision;
+    }
+
+    //! number of iterative refinement steps if the factorization is done in single precision
+    int refinementSteps() const { return _refinementSteps;}
+    void setRefinementSteps(int steps) { _refinementSteps = steps;}
+
   protected:
     bool _init;
     bool _blockOrdering;
     bool _writeDebug;
+    bool _singlePrecision;
+    int _refinementSteps;
     SparseMatrix _sparseMatrix;
+    SparseMatrixF _sparseMatrixF;
     CholeskyDecomposition _cholesky;
+    CholeskyDecompositionF _choleskyF;
+    VectorXD _residual;
 
     /**
      * compute the symbolic decompostion of the matrix only once.
@@ -146,12 +203,15 @@ class LinearSolverEigen: public LinearSolver<MatrixType>
     {
       double t=get_monotonic_time();
       if (! _blockOrdering) {
-        _cholesky.analyzePattern(_sparseMatrix);
+        if (_singlePrecision)
+          _choleskyF.analyzePattern(_sparseMatrixF);
+        else
+          _cholesky.analyzePattern(_sparseMatrix);
       } else {
         // block ordering with the Eigen Interface
         // This is really ugly currently, as it calls internal functions from Eigen
         // and modifies the SparseMatrix class
-        Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic> blockP;
+        PermutationMatrix blockP;
         {
           // prepare a block structure matrix for calling AMD
           std::vector<Triplet> triplets;
@@ -182,7 +242,7 @@ class LinearSolverEigen: public LinearSolver<MatrixType>
         scalarP.resize(rows);
         int scalarIdx = 0;
         for (int i = 0; i < blockP.size(); ++i) {
-          const int& p = blockP.indices()(i);
+          int p = static_cast<int>(blockP.indices()(i));
           int base  = A.colBaseOfBlock(p);
           int nCols = A.colsOfBlock(p);
           for (int j = 0; j < nCols; ++j)
@@ -190,7 +250,10 @@ class LinearSolverEigen: public LinearSolver<MatrixType>
         }
         assert(scalarIdx == rows && "did not completely fill the permutation matrix");
         // analyze with the scalar permutation
-        _cholesky.analyzePatternWithPermutation(_sparseMatrix, scalarP);
+        if (_singlePrecision)
+          _choleskyF.analyzePatternWithPermutation(_sparseMatrixF, scalarP);
+        else
+          _cholesky.analyzePatternWithPermutation(_sparseMatrix, scalarP);
 
       }
       G2OBatchStatistics* globalStats = G2OBatchStatistics::globalStats();
@@ -163,7 +163,7 @@ namespace g2o {
       VertexSE2* from = static_cast<VertexSE2*>(e->vertices()[0]);
       VertexSE2* to   = static_cast<VertexSE2*>(e->vertices()[1]);
 
-      double omega = e->information()(2,2);
+      double omega = static_cast<const EdgeSE2*>(e)->information()(2,2);
 
       double fromThetaGuess = from->hessianIndex() < 0 ? 0. : thetaGuess[from->hessianIndex()];
       double toThetaGuess   = to->hessianIndex() < 0 ? 0. : thetaGuess[to->hessianIndex()];
@@ -0,0 +1,268 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "solver_slam3d_linear.h"
+
+#include <Eigen/Core>
+#include <Eigen/SVD>
+
+#include "g2o/core/sparse_block_matrix.h"
+#include "g2o/core/sparse_optimizer.h"
+
+#include "g2o/types/slam3d/vertex_se3.h"
+
+#include "g2o/stuff/scoped_pointer.h"
+
+#include "g2o/solvers/csparse/linear_solver_csparse.h"
+
+using namespace std;
+
+namespace g2o {
+
+  namespace {
+    typedef SparseBlockMatrix<Matrix3D> PoseBlockMatrix;
+    typedef LinearSolverCSparse<Matrix3D> SystemSolver;
+
+    /**
+     * allocate the block structure of the system, one 3x3 block per active
+     * vertex and one off-diagonal block per edge between two active vertices
+     */
+    PoseBlockMatrix* allocateSystem(SparseOptimizer* optimizer, const std::vector<EdgeSE3*>& edges, int* blockIndices)
+    {
+      int numVertices = optimizer->indexMapping().size();
+      PoseBlockMatrix* H = new PoseBlockMatrix(blockIndices, blockIndices, numVertices, numVertices);
+      for (int i = 0; i < numVertices; ++i)
+        H->block(i, i, true);
+      for (size_t k = 0; k < edges.size(); ++k) {
+        int ind1 = static_cast<OptimizableGraph::Vertex*>(edges[k]->vertices()[0])->hessianIndex();
+        int ind2 = static_cast<OptimizableGraph::Vertex*>(edges[k]->vertices()[1])->hessianIndex();
+        if (ind1 < 0 || ind2 < 0)
+          continue;
+        if (ind1 > ind2) // make sure, we allocate the upper triangle block
+          std::swap(ind1, ind2);
+        H->block(ind1, ind2, true);
+      }
+      return H;
+    }
+
+    //! add the constraint x_j = Z^T x_i weighted by the matrix W to the upper triangle of H
+    void addOffDiagonal(PoseBlockMatrix& H, int i, int j, const Matrix3D& WZ)
+    {
+      if (i < j)
+        *H.block(i, j) -= WZ;
+      else
+        *H.block(j, i) -= WZ.transpose();
+    }
+
+    //! nearest rotation matrix w.r.t. the Frobenius norm
+    Matrix3D projectToRotation(const Matrix3D& M)
+    {
+      Eigen::JacobiSVD<Matrix3D> svd(M, Eigen::ComputeFullU | Eigen::ComputeFullV);
+      Matrix3D U = svd.matrixU();
+      if ((U * svd.matrixV().transpose()).determinant() < 0.)
+        U.col(2) *= -1.;
+      return U * svd.matrixV().transpose();
+    }
+  }
+
+  SolverSLAM3DLinear::SolverSLAM3DLinear(Solver* solver) :
+    OptimizationAlgorithmGaussNewton(solver)
+  {
+    _initialGuessOnly = _properties.makeProperty<Property<bool> >("initialGuessOnly", false);
+  }
+
+  SolverSLAM3DLinear::~SolverSLAM3DLinear()
+  {
+  }
+
+  OptimizationAlgorithm::SolverResult SolverSLAM3DLinear::solve(int iteration, bool online)
+  {
+    if (iteration == 0) {
+      bool status = computeInitialGuess();
+      if (! status)
+        return OptimizationAlgorithm::Fail;
+      if (_initialGuessOnly->value())
+        return OptimizationAlgorithm::Terminate;
+    }
+
+    return OptimizationAlgorithmGaussNewton::solve(iteration, online);
+  }
+
+  bool SolverSLAM3DLinear::computeInitialGuess()
+  {
+    if (! collectEdges())
+      return false;
+    if (! solveOrientation())
+      return false;
+    return solveTranslation();
+  }
+
+  bool SolverSLAM3DLinear::collectEdges()
+  {
+    _edges.clear();
+    for (size_t i = 0; i < _optimizer->indexMapping().size(); ++i) {
+      if (! dynamic_cast<VertexSE3*>(_optimizer->indexMapping()[i])) {
+        cerr << __PRETTY_FUNCTION__ << ": vertex " << _optimizer->indexMapping()[i]->id() << " is not a VertexSE3" << endl;
+        return false;
+      }
+    }
+
+    // edges of other types, e.g., priors, do not contribute to the initialization
+    bool hasFixedVertex = false;
+    for (SparseOptimizer::EdgeContainer::const_iterator it = _optimizer->activeEdges().begin(); it != _optimizer->activeEdges().end(); ++it) {
+      EdgeSE3* e = dynamic_cast<EdgeSE3*>(*it);
+      if (! e)
+        continue;
+      int ind1 = static_cast<OptimizableGraph::Vertex*>(e->vertices()[0])->hessianIndex();
+      int ind2 = static_cast<OptimizableGraph::Vertex*>(e->vertices()[1])->hessianIndex();
+      if (ind1 < 0 && ind2 < 0)
+        continue;
+      hasFixedVertex = hasFixedVertex || ind1 < 0 || ind2 < 0;
+      _edges.push_back(e);
+    }
+    if (! hasFixedVertex) {
+      cerr << __PRETTY_FUNCTION__ << ": the graph needs to be fixed by a vertex connected to an EdgeSE3" << endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool SolverSLAM3DLinear::solveOrientation()
+  {
+    // Each row r_i of a rotation R_i is a vector in R^3. For an edge the
+    // constraint R_j = R_i * Z yields r_j = Z^T r_i for all three rows. Hence,
+    // the three rows are solved independently with the same system matrix.
+    int numVertices = _optimizer->indexMapping().size();
+    ScopedArray<int> blockIndices(new int[numVertices]);
+    for (int i = 0; i < numVertices; ++i)
+      blockIndices[i] = 3 * (i + 1);
+    ScopedPointer<PoseBlockMatrix> H(allocateSystem(_optimizer, _edges, blockIndices.get()));
+    MatrixXD b = MatrixXD::Zero(3 * numVertices, 3);
+
+    for (size_t k = 0; k < _edges.size(); ++k) {
+      EdgeSE3* e = _edges[k];
+      VertexSE3* from = static_cast<VertexSE3*>(e->vertices()[0]);
+      VertexSE3* to   = static_cast<VertexSE3*>(e->vertices()[1]);
+      int ind1 = from->hessianIndex();
+      int ind2 = to->hessianIndex();
+      const Matrix3D Z = e->measurement().linear();
+      // the relaxation is isotropic, use the mean of the rotational information
+      double omega = e->information().block<3,3>(3,3).trace() / 3.;
+
+      if (ind1 >= 0) {
+        H->block(ind1, ind1)->diagonal().array() += omega;
+        if (ind2 < 0)
+          b.block<3,3>(3 * ind1, 0).noalias() += omega * Z * to->estimate().linear().transpose();
+      }
+      if (ind2 >= 0) {
+        H->block(ind2, ind2)->diagonal().array() += omega;
+        if (ind1 < 0)
+          b.block<3,3>(3 * ind2, 0).noalias() += omega * (from->estimate().linear() * Z).transpose();
+      }
+      if (ind1 >= 0 && ind2 >= 0)
+        addOffDiagonal(*H, ind1, ind2, omega * Z);
+    }
+
+    SystemSolver linearSystemSolver;
+    linearSystemSolver.setBlockOrdering(true);
+    linearSystemSolver.init();
+    MatrixXD x(3 * numVertices, 3);
+    for (int r = 0; r < 3; ++r) {
+      bool ok = linearSystemSolver.solve(*H, x.col(r).data(), b.col(r).data());
+      if (! ok) {
+        cerr << __PRETTY_FUNCTION__ << ": Failure while solving linear system" << endl;
+        return false;
+      }
+    }
+
+    // the rows of the solution are the columns of x, project them onto SO(3)
+    for (int i = 0; i < numVertices; ++i) {
+      VertexSE3* v = static_cast<VertexSE3*>(_optimizer->indexMapping()[i]);
+      Isometry3D estimate = v->estimate();
+      estimate.linear() = projectToRotation(x.block<3,3>(3 * i, 0).transpose());
+      v->setEstimate(estimate);
+    }
+    return true;
+  }
+
+  bool SolverSLAM3DLinear::solveTranslation()
+  {
+    // given the rotations, t_j = t_i + R_i * t_ij is linear in the translations,
+    // the translational information of the edge is rotated into the global frame
+    int numVertices = _optimizer->indexMapping().size();
+    ScopedArray<int> blockIndices(new int[numVertices]);
+    for (int i = 0; i < numVertices; ++i)
+      blockIndices[i] = 3 * (i + 1);
+    ScopedPointer<PoseBlockMatrix> H(allocateSystem(_optimizer, _edges, blockIndices.get()));
+    VectorXD b = VectorXD::Zero(3 * numVertices);
+
+    for (size_t k = 0; k < _edges.size(); ++k) {
+      EdgeSE3* e = _edges[k];
+      VertexSE3* from = static_cast<VertexSE3*>(e->vertices()[0]);
+      VertexSE3* to   = static_cast<VertexSE3*>(e->vertices()[1]);
+      int ind1 = from->hessianIndex();
+      int ind2 = to->hessianIndex();
+      const Matrix3D& Ri = from->estimate().linear();
+      const Matrix3D R = Ri * e->measurement().linear();
+      const Matrix3D W = R * e->information().block<3,3>(0,0) * R.transpose();
+      Vector3D c = Ri * e->measurement().translation();
+
+      if (ind1 < 0)
+        c += from->estimate().translation();
+      if (ind2 < 0)
+        c -= to->estimate().translation();
+      if (ind1 >= 0) {
+        *H->block(ind1, ind1) += W;
+        b.segment<3>(3 * ind1).noalias() -= W * c;
+      }
+      if (ind2 >= 0) {
+        *H->block(ind2, ind2) += W;
+        b.segment<3>(3 * ind2).noalias() += W * c;
+      }
+      if (ind1 >= 0 && ind2 >= 0)
+        addOffDiagonal(*H, ind1, ind2, W);
+    }
+
+    SystemSolver linearSystemSolver;
+    linearSystemSolver.setBlockOrdering(true);
+    linearSystemSolver.init();
+    VectorXD x(3 * numVertices);
+    bool ok = linearSystemSolver.solve(*H, x.data(), b.data());
+    if (! ok) {
+      cerr << __PRETTY_FUNCTION__ << ": Failure while solving linear system" << endl;
+      return false;
+    }
+
+    for (int i = 0; i < numVertices; ++i) {
+      VertexSE3* v = static_cast<VertexSE3*>(_optimizer->indexMapping()[i]);
+      Isometry3D estimate = v->estimate();
+      estimate.translation() = x.segment<3>(3 * i);
+      v->setEstimate(estimate);
+    }
+    return true;
+  }
+
+} // end namespace
@@ -0,0 +1,91 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_SOLVER_SLAM3D_LINEAR
+#define G2O_SOLVER_SLAM3D_LINEAR
+
+#include "g2o/core/optimization_algorithm_gauss_newton.h"
+#include "g2o/types/slam3d/edge_se3.h"
+#include "g2o/stuff/property.h"
+#include "g2o_slam3d_linear_api.h"
+
+#include <vector>
+
+namespace g2o {
+
+  class Solver;
+
+  /**
+   * \brief Implementation of a linear initialization for 3D pose graph SLAM
+   *
+   * Operates on graphs consisting of VertexSE3 connected by EdgeSE3, at
+   * least one vertex has to be fixed. Within the first iteration an
+   * initial guess for all the poses is computed in two linear steps:
+   * The rotations are estimated by the chordal relaxation, i.e., the
+   * constraints R_j = R_i * Z_ij are solved in the least squares sense
+   * over all 3x3 matrices and the result is projected onto SO(3).
+   * Afterwards, given the rotations, the translations are the solution of
+   * a linear least squares problem. In the subsequent iterations full
+   * non-linear GN is carried out.
+   *
+   * Setting the property initialGuessOnly terminates the optimization after
+   * the initialization, which allows to use the initialization before any
+   * other optimization algorithm.
+   *
+   * More or less the rotation initialization is the one described by
+   * Carlone et al, ICRA'15.
+   */
+  class G2O_SLAM3D_LINEAR_API SolverSLAM3DLinear : public OptimizationAlgorithmGaussNewton
+  {
+    public:
+      /**
+       * Construct a Solver for solving 3D pose graphs. Within the first iteration
+       * the poses are initialized and afterwards standard non-linear Gauss Newton
+       * is carried out.
+       */
+      explicit SolverSLAM3DLinear(Solver* solver);
+      virtual ~SolverSLAM3DLinear();
+
+      virtual OptimizationAlgorithm::SolverResult solve(int iteration, bool online = false);
+
+      /**
+       * compute the initial guess of the rotations and translations and set
+       * the estimate of the active vertices accordingly
+       */
+      bool computeInitialGuess();
+
+    protected:
+      bool collectEdges();
+      bool solveOrientation();
+      bool solveTranslation();
+
+      std::vector<EdgeSE3*> _edges;  ///< active edges used for the initialization
+      Property<bool>* _initialGuessOnly;
+  };
+
+} // end namespace
+
+#endif
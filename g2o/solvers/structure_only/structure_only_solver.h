@@ -32,6 +32,10 @@
 #include "g2o/core/base_binary_edge.h"
 #include "g2o/core/optimization_algorithm.h"
 #include "g2o/core/sparse_optimizer.h"
+#include "g2o/core/robust_kernel.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace g2o
 {
@@ -51,145 +55,41 @@ namespace g2o
  * without the need of additional setup. Call calc() with the point features you
  * want to optimize.
  *
+ * The tracks of the points, i.e., the edges observing them, are collected
+ * into flat arrays before optimizing. Each point is refined by its own small
+ * Levenberg-Marquardt loop whose PointDoF x PointDoF system is accumulated locally from the Jacobian with
+ * respect to the point. Hence, the points are processed in parallel if g2o
+ * is compiled with OpenMP. The other vertices of the tracks are held fixed
+ * meanwhile. If points are connected to each other by an edge they are
+ * processed sequentially.
+ *
  * This class is still considered as being experimentally!
  */
 template <int PointDoF>
 class StructureOnlySolver : public OptimizationAlgorithm
 {
   public:
+    typedef Eigen::Matrix<double, PointDoF, PointDoF, Eigen::ColMajor> PointMatrix;
+    typedef Eigen::Matrix<double, PointDoF, 1, Eigen::ColMajor> PointVector;
+
     StructureOnlySolver()
     {
       _verbose = true;
+      _tracksIndependent = true;
     }
 
     virtual OptimizationAlgorithm::SolverResult solve(int iteration, bool online = false)
     {
       (void) iteration;
       (void) online;
-      return calc(_points, 1);
+      optimizeTracks(1, 10);
+      return OK;
     }
 
     OptimizationAlgorithm::SolverResult calc(OptimizableGraph::VertexContainer& vertices, int num_iters, int num_max_trials=10)
     {
-      JacobianWorkspace auxWorkspace;
-      auxWorkspace.updateSize(2, 50);
-      auxWorkspace.allocate();
-
-      for (OptimizableGraph::VertexContainer::iterator it_v=vertices.begin(); it_v!=vertices.end(); ++it_v) {
-        bool stop = false;
-        g2o::OptimizableGraph::Vertex* v = dynamic_cast<OptimizableGraph::Vertex*>(*it_v);
-        assert(v->dimension() == PointDoF);
-        g2o::HyperGraph::EdgeSet& track = v->edges();
-        assert(track.size()>=2);
-        double chi2 = 0;
-        // TODO make these parameters
-        double mu = 0.01;
-        double nu = 2;
-
-        for (g2o::HyperGraph::EdgeSet::iterator it_t=track.begin(); it_t!=track.end(); ++it_t) {
-          g2o::OptimizableGraph::Edge* e = dynamic_cast<g2o::OptimizableGraph::Edge *>(*it_t);
-          e->computeError();
-          chi2 += e->chi2();
-        }
-
-        if (v->fixed() == false) {
-          Eigen::Matrix<double, PointDoF, PointDoF, Eigen::ColMajor> H_pp;
-          H_pp.resize(v->dimension(), v->dimension());
-          v->mapHessianMemory(H_pp.data());
-          for (int i_g = 0; i_g < num_iters; ++i_g) {
-            H_pp.setZero();
-            v->clearQuadraticForm();
-
-            g2o::HyperGraph::EdgeSet& track = v->edges();
-            assert(track.size()>=1);
-
-            for (g2o::HyperGraph::EdgeSet::iterator it_t=track.begin(); it_t!=track.end(); ++it_t) {
-              g2o::OptimizableGraph::Edge* e = dynamic_cast<g2o::OptimizableGraph::Edge *>(*it_t);
-
-              // fix all the other vertices and remember their fix value
-#ifdef WINDOWS
-              std::vector<bool> remember_fix_status(e->vertices().size());
-#else
-              bool remember_fix_status[e->vertices().size()];
-#endif
-              for (size_t k = 0; k < e->vertices().size(); ++k) {
-                OptimizableGraph::Vertex* otherV = static_cast<OptimizableGraph::Vertex*>(e->vertex(k));
-                if (otherV != v) {
-                  remember_fix_status[k] = otherV->fixed();
-                  otherV->setFixed(true);
-                }
-              }
-
-              // build the matrix
-              e->computeError();
-              e->linearizeOplus(auxWorkspace);
-              e->constructQuadraticForm();
-
-              // Restore frame's initial fixed() values
-              for (size_t k = 0; k < e->vertices().size(); ++k) {
-                OptimizableGraph::Vertex* otherV = static_cast<g2o::OptimizableGraph::Vertex*>(e->vertex(k));
-                if (otherV != v) {
-                  otherV->setFixed(remember_fix_status[k]);
-                }
-              }
-            }
-
-            Eigen::Map<Eigen::Matrix<double,PointDoF,1,Eigen::ColMajor> > b(v->bData(), v->dimension());
-
-            if (b.norm()<0.001) {
-              stop = true;
-              break;
-            }
-
-            int trial=0;
-            do {
-              Eigen::Matrix<double,PointDoF,PointDoF,Eigen::ColMajor> H_pp_mu = H_pp;
-              H_pp_mu.diagonal().array() += mu;
-              Eigen::LDLT<Eigen::Matrix<double,PointDoF,PointDoF,Eigen::ColMajor> > chol_H_pp(H_pp_mu);
-              bool goodStep = false;
-              if (chol_H_pp.isPositive()) {
-                Eigen::Matrix<double,PointDoF,1,Eigen::ColMajor> delta_p = chol_H_pp.solve(b);
-                v->push();
-                v->oplus(delta_p.data());
-                double new_chi2 = 0.;
-                for (g2o::HyperGraph::EdgeSet::iterator it_t=track.begin(); it_t!=track.end(); ++it_t) {
-                  g2o::OptimizableGraph::Edge* e = dynamic_cast<g2o::OptimizableGraph::Edge *>(*it_t);
-                  e->computeError();
-                  new_chi2 += e->chi2();
-                }
-                assert(g2o_isnan(new_chi2)==false && "Chi is NaN");
-                double rho = (chi2 - new_chi2);
-                if (rho > 0 && g2o_isfinite(new_chi2)) {
-                  goodStep = true;
-                  chi2 = new_chi2;
-                  v->discardTop();
-                } else {
-                  goodStep = false;
-                  v->pop();
-                }
-              }
-
-              // update the damping factor based on the result of the last increment
-              if (goodStep) {
-                mu *= 1./3.;
-                nu = 2.;
-                trial=0;
-                break;
-              } else {
-                mu *= nu;
-                nu *= 2.;
-                ++trial;
-                if (trial >= num_max_trials) {
-                  stop=true;
-                  break;
-                }
-              }
-            } while(!stop);
-            if (stop)
-              break;
-          }
-        }
-      }
+      buildTracks(vertices);
+      optimizeTracks(num_iters, num_max_trials);
       return OK;
     }
 
@@ -203,6 +103,7 @@ class StructureOnlySolver : public OptimizationAlgorithm
           _points.push_back(v);
         }
       }
+      buildTracks(_points);
       return true;
     }
 
@@ -215,8 +116,203 @@ class StructureOnlySolver : public OptimizationAlgorithm
     const OptimizableGraph::VertexContainer& points() const { return _points;}
 
   protected:
+    /**
+     * scratch memory of a thread for linearizing the edges of a track
+     */
+    struct TrackWorkspace
+    {
+      JacobianWorkspace jacobians;
+      Eigen::Matrix<double, Eigen::Dynamic, PointDoF, Eigen::ColMajor> omegaJ;
+    };
+
+    /**
+     * collect the tracks of the non-fixed vertices into the flat arrays
+     * and determine the other vertices of the tracks which need to be
+     * held fixed during the optimization.
+     */
+    void buildTracks(const OptimizableGraph::VertexContainer& vertices)
+    {
+      _trackPoints.clear();
+      _trackBegin.clear();
+      _trackEdges.clear();
+      _trackSlots.clear();
+      _neighbors.clear();
+      _tracksIndependent = true;
+      _workspace.jacobians = JacobianWorkspace();
+
+      OptimizableGraph::VertexContainer sortedPoints(vertices);
+      std::sort(sortedPoints.begin(), sortedPoints.end());
+
+      _trackBegin.push_back(0);
+      for (OptimizableGraph::VertexContainer::const_iterator it_v = vertices.begin(); it_v != vertices.end(); ++it_v) {
+        OptimizableGraph::Vertex* v = *it_v;
+        assert(v->dimension() == PointDoF);
+        if (v->fixed())
+          continue;
+        const HyperGraph::EdgeSet& track = v->edges();
+        for (HyperGraph::EdgeSet::const_iterator it_t = track.begin(); it_t != track.end(); ++it_t) {
+          OptimizableGraph::Edge* e = static_cast<OptimizableGraph::Edge*>(*it_t);
+          int slot = -1;
+          for (size_t k = 0; k < e->vertices().size(); ++k) {
+            OptimizableGraph::Vertex* other = static_cast<OptimizableGraph::Vertex*>(e->vertex(k));
+            if (other == v) {
+              slot = static_cast<int>(k);
+            } else if (! other->fixed()) {
+              // fixing the neighbor right away visits it only once
+              if (std::binary_search(sortedPoints.begin(), sortedPoints.end(), other)) {
+                _tracksIndependent = false;
+              } else {
+                other->setFixed(true);
+                _neighbors.push_back(other);
+              }
+            }
+          }
+          assert(slot >= 0 && "vertex not found in its edge");
+          _trackEdges.push_back(e);
+          _trackSlots.push_back(slot);
+          _workspace.jacobians.updateSize(e);
+        }
+        _trackPoints.push_back(v);
+        _trackBegin.push_back(static_cast<int>(_trackEdges.size()));
+      }
+      _workspace.jacobians.allocate();
+
+      for (size_t i = 0; i < _neighbors.size(); ++i)
+        _neighbors[i]->setFixed(false);
+    }
+
+    /**
+     * run the Levenberg-Marquardt loop for all points of the tracks
+     */
+    void optimizeTracks(int num_iters, int num_max_trials)
+    {
+      // fix all the other vertices and remember their fix value
+      std::vector<bool> rememberFixStatus(_neighbors.size());
+      for (size_t i = 0; i < _neighbors.size(); ++i) {
+        rememberFixStatus[i] = _neighbors[i]->fixed();
+        _neighbors[i]->setFixed(true);
+      }
+
+      TrackWorkspace workspace = _workspace;
+      const int numPoints = static_cast<int>(_trackPoints.size());
+#     ifdef G2O_OPENMP
+#     pragma omp parallel for default (shared) firstprivate(workspace) schedule(dynamic, 100) if (_tracksIndependent && numPoints > 100)
+#     endif
+      for (int i = 0; i < numPoints; ++i)
+        optimizePoint(i, workspace, num_iters, num_max_trials);
+
+      // Restore frame's initial fixed() values
+      for (size_t i = 0; i < _neighbors.size(); ++i)
+        _neighbors[i]->setFixed(rememberFixStatus[i]);
+    }
+
+    //! sum of the chi2 of the track, computes the error of all its edges
+    double computeTrackChi2(int begin, int end) const
+    {
+      double chi2 = 0.;
+      for (int k = begin; k < end; ++k) {
+        _trackEdges[k]->computeError();
+        chi2 += _trackEdges[k]->chi2();
+      }
+      return chi2;
+    }
+
+    void optimizePoint(int pointIndex, TrackWorkspace& workspace, int num_iters, int num_max_trials)
+    {
+      OptimizableGraph::Vertex* v = _trackPoints[pointIndex];
+      const int begin = _trackBegin[pointIndex];
+      const int end = _trackBegin[pointIndex + 1];
+      // TODO make these parameters
+      double mu = 0.01;
+      double nu = 2;
+      bool stop = false;
+
+      // after an accepted step the errors of the edges correspond to the
+      // current estimate, i.e., they do not need to be recomputed for linearizing
+      double chi2 = computeTrackChi2(begin, end);
+
+      for (int i_g = 0; i_g < num_iters; ++i_g) {
+        // build the system of the point
+        PointMatrix H_pp = PointMatrix::Zero();
+        PointVector b = PointVector::Zero();
+        for (int k = begin; k < end; ++k) {
+          OptimizableGraph::Edge* e = _trackEdges[k];
+          e->linearizeOplus(workspace.jacobians);
+          const int D = e->dimension();
+          Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, PointDoF, Eigen::ColMajor> > J(workspace.jacobians.workspaceForVertex(_trackSlots[k]), D, PointDoF);
+          // the const overload, the non-const one detaches a shared information matrix
+          Eigen::Map<const MatrixXD> omega(static_cast<const OptimizableGraph::Edge*>(e)->informationData(), D, D);
+          Eigen::Map<const VectorXD> error(e->errorData(), D);
+          double weight = 1.;
+          if (e->robustKernel()) {
+            Vector3D rho;
+            e->robustKernel()->robustify(e->chi2(), rho);
+            weight = rho[1];
+          }
+          workspace.omegaJ.noalias() = omega * J;
+          H_pp.noalias() += weight * J.transpose() * workspace.omegaJ;
+          b.noalias() -= weight * workspace.omegaJ.transpose() * error;
+        }
+
+        if (b.norm()<0.001) {
+          stop = true;
+          break;
+        }
+
+        int trial=0;
+        do {
+          PointMatrix H_pp_mu = H_pp;
+          H_pp_mu.diagonal().array() += mu;
+          Eigen::LDLT<PointMatrix> chol_H_pp(H_pp_mu);
+          bool goodStep = false;
+          if (chol_H_pp.isPositive()) {
+            PointVector delta_p = chol_H_pp.solve(b);
+            v->push();
+            v->oplus(delta_p.data());
+            double new_chi2 = computeTrackChi2(begin, end);
+            assert(g2o_isnan(new_chi2)==false && "Chi is NaN");
+            double rho = (chi2 - new_chi2);
+            if (rho > 0 && g2o_isfinite(new_chi2)) {
+              goodStep = true;
+              chi2 = new_chi2;
+              v->discardTop();
+            } else {
+              goodStep = false;
+              v->pop();
+            }
+          }
+
+          // update the damping factor based on the result of the last increment
+          if (goodStep) {
+            mu *= 1./3.;
+            nu = 2.;
+            trial=0;
+            break;
+          } else {
+            mu *= nu;
+            nu *= 2.;
+            ++trial;
+            if (trial >= num_max_trials) {
+              stop=true;
+              break;
+            }
+          }
+        } while(!stop);
+        if (stop)
+          break;
+      }
+    }
+
     bool _verbose;
     OptimizableGraph::VertexContainer _points;
+
+    OptimizableGraph::VertexContainer _trackPoints;   ///< non-fixed points which are optimized
+    std::vector<int> _trackBegin;                     ///< the track of the i-th point is [_trackBegin[i], _trackBegin[i+1])
+    std::vector<OptimizableGraph::Edge*> _trackEdges; ///< the edges of all tracks
+    std::vector<int> _trackSlots;                     ///< index of the point within the vertices of the edge
+    OptimizableGraph::VertexContainer _neighbors;     ///< other vertices of the tracks, fixed during the optimization
+    bool _tracksIndependent;                          ///< no edge connects two points
+    TrackWorkspace _workspace;
 };
 
 }
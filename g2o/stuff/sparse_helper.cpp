@@ -61,14 +61,15 @@ namespace g2o {
     return os.good();
   }
 
-  bool writeCCSMatrix(const string& filename, int rows, int cols, const int* Ap, const int* Ai, const double* Ax, bool upperTriangleSymmetric)
+  template <typename IndexType>
+  bool writeCCSMatrixT(const string& filename, int rows, int cols, const IndexType* Ap, const IndexType* Ai, const double* Ax, bool upperTriangleSymmetric)
   {
     vector<TripletEntry> entries;
     entries.reserve((size_t)Ap[cols]);
     for (int i=0; i < cols; i++) {
-      const int& rbeg = Ap[i];
-      const int& rend = Ap[i+1];
-      for (int j = rbeg; j < rend; j++) {
+      const IndexType& rbeg = Ap[i];
+      const IndexType& rend = Ap[i+1];
+      for (IndexType j = rbeg; j < rend; j++) {
         entries.push_back(TripletEntry(Ai[j], i, Ax[j]));
         if (upperTriangleSymmetric && Ai[j] != i)
           entries.push_back(TripletEntry(i, Ai[j], Ax[j]));
@@ -96,4 +97,14 @@ namespace g2o {
     return fout.good();
   }
 
+  bool writeCCSMatrix(const string& filename, int rows, int cols, const int* Ap, const int* Ai, const double* Ax, bool upperTriangleSymmetric)
+  {
+    return writeCCSMatrixT(filename, rows, cols, Ap, Ai, Ax, upperTriangleSymmetric);
+  }
+
+  bool writeCCSMatrix(const string& filename, int rows, int cols, const std::ptrdiff_t* Ap, const std::ptrdiff_t* Ai, const double* Ax, bool upperTriangleSymmetric)
+  {
+    return writeCCSMatrixT(filename, rows, cols, Ap, Ai, Ax, upperTriangleSymmetric);
+  }
+
 } // end namespace
@@ -29,6 +29,7 @@
 
 #include "g2o_stuff_api.h"
 
+#include <cstddef>
 #include <string>
 
 namespace g2o {
@@ -42,6 +43,8 @@ namespace g2o {
    * write a CCS matrix given by pointer to column, row, and values
    */
   G2O_STUFF_API bool writeCCSMatrix(const std::string& filename, int rows, int cols, const int* p, const int* i, const double* v, bool upperTriangleSymmetric = true);
+  //! see above, for matrices with 64 bit indices
+  G2O_STUFF_API bool writeCCSMatrix(const std::string& filename, int rows, int cols, const std::ptrdiff_t* p, const std::ptrdiff_t* i, const double* v, bool upperTriangleSymmetric = true);
 
 } // end namespace
 
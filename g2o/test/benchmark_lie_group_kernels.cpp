@@ -0,0 +1,171 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 H. Strasdat
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Measures the time of exp, log and composition of SE3Quat and Sim3 against
+ * the previous implementations, which went through 3x3 rotation matrices.
+ * The accuracy is checked by test_lie_group_kernels.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "lie_group_reference.h"
+#include "g2o/stuff/timeutil.h"
+
+using namespace std;
+using namespace g2o;
+using namespace Eigen;
+using namespace lie_group_test;
+
+template <typename T>
+static void report(const char* name, double tNew, double tOld, int n, const T& checksum)
+{
+  printf("%-24s %10.1f ns %10.1f ns %8.2fx  (%g)\n", name, 1e9 * tNew / n, 1e9 * tOld / n, tOld / tNew, checksum);
+}
+
+int main(int argc, char** argv)
+{
+  int n = argc > 1 ? atoi(argv[1]) : 100000;
+  Sampler::seedRand(0);
+
+  // tangent vectors with angles in [1e-3, 3] and scales in exp([-1, 1])
+  vector<Vector6d, aligned_allocator<Vector6d> > xi(n);
+  vector<Vector7d, aligned_allocator<Vector7d> > zeta(n);
+  for (int i = 0; i < n; ++i) {
+    double angle = std::pow(10., sampleUniform(-3., std::log10(3.)));
+    xi[i].head<3>() = sampleRotationVector(angle);
+    zeta[i].head<3>() = xi[i].head<3>();
+    for (int k = 3; k < 6; ++k)
+      xi[i][k] = zeta[i][k] = sampleUniform(-2., 2.);
+    zeta[i][6] = sampleUniform(-1., 1.);
+  }
+
+  // timing
+  vector<SE3Quat, aligned_allocator<SE3Quat> > poses(n);
+  vector<Sim3, aligned_allocator<Sim3> > sims(n);
+  for (int i = 0; i < n; ++i) {
+    poses[i] = SE3Quat::exp(xi[i]);
+    sims[i] = Sim3(zeta[i]);
+  }
+
+  printf("\n%-24s %13s %13s\n", "time per call", "current", "previous");
+  double t, tNew, tOld;
+  double sumNew = 0., sumOld = 0.;
+
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumNew += SE3Quat::exp(xi[i]).translation()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumOld += reference::exp(xi[i]).translation()(0);
+  tOld = get_monotonic_time() - t;
+  report("SE3Quat exp", tNew, tOld, n, sumNew - sumOld);
+
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumNew += poses[i].log()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumOld += reference::log(poses[i])(0);
+  tOld = get_monotonic_time() - t;
+  report("SE3Quat log", tNew, tOld, n, sumNew - sumOld);
+
+  // the update of VertexSE3Expmap and the error of EdgeSE3Expmap
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumNew += (SE3Quat::exp(xi[i]) * poses[i-1]).translation()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumOld += (reference::exp(xi[i]) * poses[i-1]).translation()(0);
+  tOld = get_monotonic_time() - t;
+  report("SE3Quat oplus", tNew, tOld, n, sumNew - sumOld);
+
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumNew += (poses[i].inverse() * poses[i-1]).log()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumOld += reference::log(poses[i].inverse() * poses[i-1])(0);
+  tOld = get_monotonic_time() - t;
+  report("SE3Quat error", tNew, tOld, n, sumNew - sumOld);
+
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumNew += Sim3(zeta[i]).translation()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumOld += reference::exp(zeta[i]).translation()(0);
+  tOld = get_monotonic_time() - t;
+  report("Sim3 exp", tNew, tOld, n, sumNew - sumOld);
+
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumNew += sims[i].log()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 0; i < n; ++i)
+    sumOld += reference::log(sims[i])(0);
+  tOld = get_monotonic_time() - t;
+  report("Sim3 log", tNew, tOld, n, sumNew - sumOld);
+
+  // the update of VertexSim3Expmap and the error of EdgeSim3
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumNew += (Sim3(zeta[i]) * sims[i-1]).translation()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumOld += (reference::exp(zeta[i]) * sims[i-1]).translation()(0);
+  tOld = get_monotonic_time() - t;
+  report("Sim3 oplus", tNew, tOld, n, sumNew - sumOld);
+
+  sumNew = sumOld = 0.;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumNew += (sims[i] * sims[i-1].inverse()).log()(0);
+  tNew = get_monotonic_time() - t;
+  t = get_monotonic_time();
+  for (int i = 1; i < n; ++i)
+    sumOld += reference::log(sims[i] * sims[i-1].inverse())(0);
+  tOld = get_monotonic_time() - t;
+  report("Sim3 error", tNew, tOld, n, sumNew - sumOld);
+
+  return 0;
+}
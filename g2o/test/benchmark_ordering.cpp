@@ -0,0 +1,151 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Compares the AMD and the nested dissection ordering of the block Cholesky
+ * solver on a sphere shaped 3D pose graph. Reports the ordering (symbolic)
+ * time, the numeric factorization time, the non-zeros of the factor and the
+ * final chi2 of both runs. Not a test, it is not registered with CTest.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "g2o/core/sparse_optimizer.h"
+#include "g2o/core/block_solver.h"
+#include "g2o/core/optimization_algorithm_gauss_newton.h"
+#include "g2o/solvers/block_cholesky/linear_solver_block_cholesky.h"
+#include "g2o/types/slam3d/vertex_se3.h"
+#include "g2o/types/slam3d/edge_se3.h"
+#include "g2o/stuff/command_args.h"
+#include "g2o/stuff/sampler.h"
+#include "g2o/stuff/timeutil.h"
+
+using namespace std;
+using namespace g2o;
+
+typedef LinearSolverBlockCholesky<BlockSolver_6_3::PoseMatrixType> BlockCholeskySolver;
+
+//! the sphere of create_sphere with perturbed initial estimates
+static void createSphere(SparseOptimizer& optimizer, int nodesPerLevel, int numLaps)
+{
+  const double radius = 100.;
+  Eigen::Matrix<double, 6, 6> information = Eigen::Matrix<double, 6, 6>::Identity();
+  information.block<3,3>(3,3) *= 1000.;
+  std::vector<Eigen::Isometry3d> poses;
+  int id = 0;
+  for (int f = 0; f < numLaps; ++f){
+    for (int n = 0; n < nodesPerLevel; ++n) {
+      ++id;
+      Eigen::AngleAxisd rotz(-M_PI + 2*n*M_PI / nodesPerLevel, Eigen::Vector3d::UnitZ());
+      Eigen::AngleAxisd roty(-0.5*M_PI + id*M_PI / (numLaps * nodesPerLevel), Eigen::Vector3d::UnitY());
+      Eigen::Isometry3d t;
+      t = (rotz * roty).toRotationMatrix();
+      t.translation() = t.linear() * Eigen::Vector3d(radius, 0, 0);
+      poses.push_back(t);
+    }
+  }
+
+  Sampler::seedRand(42);
+  for (size_t i = 0; i < poses.size(); ++i) {
+    VertexSE3* v = new VertexSE3;
+    v->setId(i);
+    Eigen::Isometry3d noise;
+    noise = Eigen::AngleAxisd(0.01 * Sampler::gaussRand(0., 1.), Eigen::Vector3d::UnitZ());
+    noise.translation() = Eigen::Vector3d(Sampler::gaussRand(0., 0.1), Sampler::gaussRand(0., 0.1), Sampler::gaussRand(0., 0.1));
+    v->setEstimate(i == 0 ? poses[i] : poses[i] * noise);
+    v->setFixed(i == 0);
+    optimizer.addVertex(v);
+  }
+
+  std::vector<std::pair<int, int> > pairs;
+  for (int i = 1; i < static_cast<int>(poses.size()); ++i)
+    pairs.push_back(std::make_pair(i - 1, i));
+  for (int f = 1; f < numLaps; ++f) {
+    for (int nn = 0; nn < nodesPerLevel; ++nn) {
+      for (int n = -1; n <= 1; ++n) {
+        if (f == numLaps-1 && n == 1)
+          continue;
+        int to = f*nodesPerLevel + nn + n;
+        if (to >= 0 && to < static_cast<int>(poses.size()))
+          pairs.push_back(std::make_pair((f-1)*nodesPerLevel + nn, to));
+      }
+    }
+  }
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    EdgeSE3* e = new EdgeSE3;
+    e->setVertex(0, optimizer.vertex(pairs[i].first));
+    e->setVertex(1, optimizer.vertex(pairs[i].second));
+    e->setMeasurement(poses[pairs[i].first].inverse() * poses[pairs[i].second]);
+    e->setInformation(information);
+    optimizer.addEdge(e);
+  }
+}
+
+static void run(bool nestedDissection, int nodesPerLevel, int numLaps, int iterations)
+{
+  SparseOptimizer optimizer;
+  BlockCholeskySolver* linearSolver = new BlockCholeskySolver();
+  linearSolver->setNestedDissection(nestedDissection);
+  optimizer.setAlgorithm(new OptimizationAlgorithmGaussNewton(new BlockSolver_6_3(linearSolver)));
+  createSphere(optimizer, nodesPerLevel, numLaps);
+  optimizer.setComputeBatchStatistics(true);
+  optimizer.initializeOptimization();
+
+  double ts = get_monotonic_time();
+  optimizer.optimize(iterations);
+  double totalTime = get_monotonic_time() - ts;
+
+  const BatchStatisticsContainer& statistics = optimizer.batchStatistics();
+  double numericTime = 0.;
+  for (size_t i = 0; i < statistics.size(); ++i)
+    numericTime += statistics[i].timeNumericDecomposition;
+  cout << (nestedDissection ? "ND " : "AMD")
+    << "\t vertices= " << optimizer.vertices().size()
+    << "\t edges= " << optimizer.edges().size()
+    << "\t ordering= " << statistics.front().timeSymbolicDecomposition
+    << "\t numeric= " << numericTime / statistics.size()
+    << "\t nnzL= " << statistics.back().choleskyNNZ
+    << "\t total= " << totalTime
+    << "\t chi2= " << FIXED(statistics.back().chi2) << endl;
+}
+
+int main(int argc, char** argv)
+{
+  int nodesPerLevel;
+  int numLaps;
+  int iterations;
+  CommandArgs arg;
+  arg.param("nodesPerLevel", nodesPerLevel, 100, "how many nodes per lap on the sphere");
+  arg.param("laps", numLaps, 100, "how many times the robot travels around the sphere");
+  arg.param("i", iterations, 3, "number of Gauss-Newton iterations per run");
+  arg.parseArgs(argc, argv);
+
+  run(false, nodesPerLevel, numLaps, iterations);
+  run(true, nodesPerLevel, numLaps, iterations);
+  return 0;
+}
@@ -0,0 +1,174 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Compares building the quadratic form from the dense information matrix
+ * and from its square root, see OptimizableGraph::Edge::setUseSqrtInformation(),
+ * on a sphere shaped pose graph of EdgeSE3 and on a bundle adjustment problem
+ * of EdgeProjectXYZ2UV. Reports the time per iteration for building the
+ * system, i.e., linearizing the edges and constructing the quadratic form,
+ * and the final chi2 of both runs.
+ * Not a test, it is not registered with CTest.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "g2o/core/sparse_optimizer.h"
+#include "g2o/core/block_solver.h"
+#include "g2o/core/optimization_algorithm_gauss_newton.h"
+#include "g2o/solvers/eigen/linear_solver_eigen.h"
+#include "g2o/types/slam3d/vertex_se3.h"
+#include "g2o/types/slam3d/edge_se3.h"
+#include "g2o/types/sba/types_six_dof_expmap.h"
+#include "g2o/stuff/command_args.h"
+#include "g2o/stuff/sampler.h"
+
+using namespace std;
+using namespace g2o;
+
+typedef LinearSolverEigen<BlockSolver_6_3::PoseMatrixType> EigenLinearSolver;
+
+//! the sphere of create_sphere with perturbed initial estimates
+static void createSphere(SparseOptimizer& optimizer, int nodesPerLevel, int numLaps)
+{
+  const double radius = 100.;
+  Eigen::Matrix<double, 6, 6> information = Eigen::Matrix<double, 6, 6>::Identity();
+  information.block<3,3>(3,3) *= 1000.;
+  std::vector<Eigen::Isometry3d> poses;
+  int id = 0;
+  for (int f = 0; f < numLaps; ++f){
+    for (int n = 0; n < nodesPerLevel; ++n) {
+      ++id;
+      Eigen::AngleAxisd rotz(-M_PI + 2*n*M_PI / nodesPerLevel, Eigen::Vector3d::UnitZ());
+      Eigen::AngleAxisd roty(-0.5*M_PI + id*M_PI / (numLaps * nodesPerLevel), Eigen::Vector3d::UnitY());
+      Eigen::Isometry3d t;
+      t = (rotz * roty).toRotationMatrix();
+      t.translation() = t.linear() * Eigen::Vector3d(radius, 0, 0);
+      poses.push_back(t);
+    }
+  }
+
+  for (size_t i = 0; i < poses.size(); ++i) {
+    VertexSE3* v = new VertexSE3;
+    v->setId(i);
+    Eigen::Isometry3d noise;
+    noise = Eigen::AngleAxisd(0.01 * Sampler::gaussRand(0., 1.), Eigen::Vector3d::UnitZ());
+    noise.translation() = Eigen::Vector3d(Sampler::gaussRand(0., 0.1), Sampler::gaussRand(0., 0.1), Sampler::gaussRand(0., 0.1));
+    v->setEstimate(i == 0 ? poses[i] : poses[i] * noise);
+    v->setFixed(i == 0);
+    optimizer.addVertex(v);
+  }
+
+  for (int i = 1; i < static_cast<int>(poses.size()); ++i) {
+    for (int j = i - 1; j >= 0 && j >= i - nodesPerLevel - 1; j -= nodesPerLevel) {
+      EdgeSE3* e = new EdgeSE3;
+      e->setVertex(0, optimizer.vertex(j));
+      e->setVertex(1, optimizer.vertex(i));
+      e->setMeasurement(poses[j].inverse() * poses[i]);
+      e->setInformation(information);
+      optimizer.addEdge(e);
+    }
+  }
+}
+
+//! cameras on a line observing random points in front of them, as in ba_demo
+static void createBundleAdjustment(SparseOptimizer& optimizer, int numPoses, int numPoints)
+{
+  CameraParameters* camera = new CameraParameters(1000., Eigen::Vector2d(320., 240.), 0.);
+  camera->setId(0);
+  optimizer.addParameter(camera);
+
+  std::vector<SE3Quat> poses;
+  for (int i = 0; i < numPoses; ++i) {
+    SE3Quat pose(Eigen::Quaterniond::Identity(), Eigen::Vector3d(i * 0.04 - 1., 0, 0));
+    VertexSE3Expmap* v = new VertexSE3Expmap;
+    v->setId(i);
+    v->setFixed(i < 2);
+    v->setEstimate(pose);
+    optimizer.addVertex(v);
+    poses.push_back(pose);
+  }
+
+  for (int j = 0; j < numPoints; ++j) {
+    Eigen::Vector3d point((Sampler::uniformRand(0., 1.) - 0.5) * 3, Sampler::uniformRand(0., 1.) - 0.5, Sampler::uniformRand(0., 1.) + 3);
+    VertexSBAPointXYZ* p = new VertexSBAPointXYZ;
+    p->setId(numPoses + j);
+    p->setMarginalized(true);
+    p->setEstimate(point + Eigen::Vector3d(Sampler::gaussRand(0., 0.1), Sampler::gaussRand(0., 0.1), Sampler::gaussRand(0., 0.1)));
+    optimizer.addVertex(p);
+    for (int i = 0; i < numPoses; ++i) {
+      Eigen::Vector2d z = camera->cam_map(poses[i].map(point)) + Eigen::Vector2d(Sampler::gaussRand(0., 1.), Sampler::gaussRand(0., 1.));
+      EdgeProjectXYZ2UV* e = new EdgeProjectXYZ2UV;
+      e->setVertex(0, p);
+      e->setVertex(1, optimizer.vertex(i));
+      e->setMeasurement(z);
+      e->setInformation(Eigen::Matrix2d::Identity());
+      e->setParameterId(0, 0);
+      optimizer.addEdge(e);
+    }
+  }
+}
+
+static void run(const char* name, bool sqrtInformation, bool bundleAdjustment, int iterations)
+{
+  Sampler::seedRand(42);
+  SparseOptimizer optimizer;
+  optimizer.setAlgorithm(new OptimizationAlgorithmGaussNewton(new BlockSolver_6_3(new EigenLinearSolver())));
+  if (bundleAdjustment)
+    createBundleAdjustment(optimizer, 15, 2000);
+  else
+    createSphere(optimizer, 50, 50);
+  for (HyperGraph::EdgeSet::const_iterator it = optimizer.edges().begin(); it != optimizer.edges().end(); ++it)
+    static_cast<OptimizableGraph::Edge*>(*it)->setUseSqrtInformation(sqrtInformation);
+  optimizer.setComputeBatchStatistics(true);
+  optimizer.initializeOptimization();
+  optimizer.optimize(iterations);
+
+  const BatchStatisticsContainer& statistics = optimizer.batchStatistics();
+  double quadraticFormTime = 0.;
+  for (size_t i = 0; i < statistics.size(); ++i)
+    quadraticFormTime += statistics[i].timeQuadraticForm;
+  cout << name << (sqrtInformation ? " sqrt " : " dense")
+    << "\t edges= " << optimizer.edges().size()
+    << "\t buildSystem= " << quadraticFormTime / statistics.size()
+    << "\t chi2= " << FIXED(statistics.back().chi2) << endl;
+}
+
+int main(int argc, char** argv)
+{
+  int iterations;
+  CommandArgs arg;
+  arg.param("i", iterations, 5, "number of Gauss-Newton iterations per run");
+  arg.parseArgs(argc, argv);
+
+  run("EdgeSE3          ", false, false, iterations);
+  run("EdgeSE3          ", true, false, iterations);
+  run("EdgeProjectXYZ2UV", false, true, iterations);
+  run("EdgeProjectXYZ2UV", true, true, iterations);
+  return 0;
+}
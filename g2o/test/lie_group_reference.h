@@ -0,0 +1,150 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 H. Strasdat
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_TEST_LIE_GROUP_REFERENCE_H
+#define G2O_TEST_LIE_GROUP_REFERENCE_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "g2o/types/sim3/sim3.h"
+#include "g2o/types/slam3d/se3quat.h"
+#include "g2o/stuff/sampler.h"
+
+/**
+ * the previous implementations of the exponential and logarithm of SE3Quat
+ * and Sim3, which went through 3x3 rotation matrices
+ */
+namespace reference {
+
+  using namespace g2o;
+  using Eigen::Quaterniond;
+
+  inline SE3Quat exp(const Vector6d& update)
+  {
+    Vector3D omega = update.head<3>();
+    Vector3D upsilon = update.tail<3>();
+    double theta = omega.norm();
+    Matrix3D Omega = skew(omega);
+    Matrix3D Omega2 = Omega*Omega;
+    Matrix3D R = (Matrix3D::Identity()
+        + sin(theta)/theta *Omega
+        + (1-cos(theta))/(theta*theta)*Omega2);
+    Matrix3D V = (Matrix3D::Identity()
+        + (1-cos(theta))/(theta*theta)*Omega
+        + (theta-sin(theta))/(pow(theta,3))*Omega2);
+    return SE3Quat(Quaterniond(R),V*upsilon);
+  }
+
+  inline Vector6d log(const SE3Quat& T)
+  {
+    Vector6d res;
+    Matrix3D R = T.rotation().toRotationMatrix();
+    double d =  0.5*(R(0,0)+R(1,1)+R(2,2)-1);
+    Vector3D omega;
+    Matrix3D V_inv;
+    if (d>0.99999) {
+      omega=0.5*deltaR(R);
+      Matrix3D Omega = skew(omega);
+      V_inv = Matrix3D::Identity()- 0.5*Omega + (1./12.)*(Omega*Omega);
+    } else {
+      double theta = acos(d);
+      omega = theta/(2*sqrt(1-d*d))*deltaR(R);
+      Matrix3D Omega = skew(omega);
+      V_inv = ( Matrix3D::Identity() - 0.5*Omega
+          + ( 1-theta/(2*tan(theta/2)))/(theta*theta)*(Omega*Omega) );
+    }
+    res.head<3>() = omega;
+    res.tail<3>() = V_inv*T.translation();
+    return res;
+  }
+
+  inline Sim3 exp(const Vector7d& update)
+  {
+    Vector3D omega = update.head<3>();
+    Vector3D upsilon = update.segment<3>(3);
+    double sigma = update[6];
+    double theta = omega.norm();
+    Matrix3D Omega = skew(omega);
+    double s = std::exp(sigma);
+    Matrix3D Omega2 = Omega*Omega;
+    Matrix3D I = Matrix3D::Identity();
+    Matrix3D R = I + sin(theta)/theta *Omega + (1-cos(theta))/(theta*theta)*Omega2;
+    double a=s*sin(theta);
+    double b=s*cos(theta);
+    double theta2= theta*theta;
+    double sigma2= sigma*sigma;
+    double c=theta2+sigma2;
+    double C=(s-1)/sigma;
+    double A = (a*sigma+ (1-b)*theta)/(theta*c);
+    double B = (C-((b-1)*sigma+a*theta)/(c))*1./(theta2);
+    Matrix3D W = A*Omega + B*Omega2 + C*I;
+    return Sim3(Quaterniond(R), W*upsilon, s);
+  }
+
+  inline Vector7d log(const Sim3& S)
+  {
+    Vector7d res;
+    double s = S.scale();
+    double sigma = std::log(s);
+    Matrix3D R = S.rotation().toRotationMatrix();
+    double d =  0.5*(R(0,0)+R(1,1)+R(2,2)-1);
+    double theta = acos(d);
+    Vector3D omega = theta/(2*sqrt(1-d*d))*deltaR(R);
+    Matrix3D Omega = skew(omega);
+    double theta2 = theta*theta;
+    double a=s*sin(theta);
+    double b=s*cos(theta);
+    double c=theta2 + sigma*sigma;
+    double C=(s-1)/sigma;
+    double A = (a*sigma+ (1-b)*theta)/(theta*c);
+    double B = (C-((b-1)*sigma+a*theta)/(c))*1./(theta2);
+    Matrix3D W = A*Omega + B*Omega*Omega + C*Matrix3D::Identity();
+    res.head<3>() = omega;
+    res.segment<3>(3) = W.lu().solve(S.translation());
+    res[6] = sigma;
+    return res;
+  }
+
+} // end namespace reference
+
+namespace lie_group_test {
+
+  inline g2o::Vector3D sampleRotationVector(double angle)
+  {
+    g2o::Vector3D axis(g2o::sampleUniform(-1., 1.), g2o::sampleUniform(-1., 1.), g2o::sampleUniform(-1., 1.));
+    return angle * axis.normalized();
+  }
+
+  //! distance of two rotations, q and -q are the same rotation
+  inline double quaternionDistance(const Eigen::Quaterniond& a, const Eigen::Quaterniond& b)
+  {
+    return std::min((a.coeffs() - b.coeffs()).norm(), (a.coeffs() + b.coeffs()).norm());
+  }
+
+} // end namespace lie_group_test
+
+#endif
@@ -0,0 +1,172 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Stores a graph with vertices, edges, parameters and user data by
+ * saveBinary(), loads it again by loadBinary() and checks that the loaded
+ * graph is written exactly as the original one by save().
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+
+#include "g2o/core/sparse_optimizer.h"
+#include "g2o/types/slam2d/vertex_se2.h"
+#include "g2o/types/slam2d/edge_se2.h"
+#include "g2o/types/slam3d/vertex_se3.h"
+#include "g2o/types/slam3d/vertex_pointxyz.h"
+#include "g2o/types/slam3d/edge_se3.h"
+#include "g2o/types/slam3d/edge_se3_pointxyz.h"
+#include "g2o/types/slam3d/parameter_se3_offset.h"
+#include "g2o/types/data/robot_laser.h"
+
+using namespace std;
+using namespace g2o;
+
+static Eigen::Isometry3d pose3d(double x, double y, double z, double yaw, double pitch)
+{
+  Eigen::Isometry3d t;
+  t = Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()) * Eigen::AngleAxisd(pitch, Eigen::Vector3d::UnitY());
+  t.translation() = Eigen::Vector3d(x, y, z);
+  return t;
+}
+
+static void createGraph(SparseOptimizer& optimizer)
+{
+  ParameterSE3Offset* offset = new ParameterSE3Offset;
+  offset->setId(7);
+  offset->setOffset(pose3d(0.1, -0.2, 0.3, 0.05, -0.02));
+  optimizer.addParameter(offset);
+
+  for (int i = 0; i < 4; ++i) {
+    VertexSE3* v = new VertexSE3;
+    v->setId(i);
+    v->setEstimate(pose3d(i * 1.1, 0.3 * i, -0.1 * i, 0.2 * i, 0.05 * i));
+    v->setFixed(i == 0);
+    optimizer.addVertex(v);
+  }
+  for (int i = 0; i < 2; ++i) {
+    VertexPointXYZ* p = new VertexPointXYZ;
+    p->setId(10 + i);
+    p->setEstimate(Eigen::Vector3d(1.5 + i, -0.25, 2. / 3.));
+    optimizer.addVertex(p);
+  }
+
+  Eigen::Matrix<double, 6, 6> information = Eigen::Matrix<double, 6, 6>::Identity() * 100.;
+  information(0, 1) = information(1, 0) = 0.5;
+  information(2, 5) = information(5, 2) = -0.25;
+  for (int i = 1; i < 4; ++i) {
+    EdgeSE3* e = new EdgeSE3;
+    e->setVertex(0, optimizer.vertex(i - 1));
+    e->setVertex(1, optimizer.vertex(i));
+    e->setMeasurement(pose3d(1.1, 0.3, -0.1, 0.2, 0.05));
+    e->setInformation(information);
+    optimizer.addEdge(e);
+  }
+  for (int i = 0; i < 2; ++i) {
+    EdgeSE3PointXYZ* e = new EdgeSE3PointXYZ;
+    e->setVertex(0, optimizer.vertex(i + 1));
+    e->setVertex(1, optimizer.vertex(10 + i));
+    e->setParameterId(0, 7);
+    e->setMeasurement(Eigen::Vector3d(0.5, 0.25 * i, 1. / 3.));
+    e->setInformation(Eigen::Matrix3d::Identity() * 4.);
+    optimizer.addEdge(e);
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    VertexSE2* v = new VertexSE2;
+    v->setId(20 + i);
+    v->setEstimate(SE2(0.7 * i, -0.1, 0.3 * i));
+    optimizer.addVertex(v);
+  }
+  EdgeSE2* e = new EdgeSE2;
+  e->setVertex(0, optimizer.vertex(20));
+  e->setVertex(1, optimizer.vertex(21));
+  e->setMeasurement(SE2(0.7, 0., 0.3));
+  e->setInformation(Eigen::Matrix3d::Identity() * 10.);
+  optimizer.addEdge(e);
+
+  RobotLaser* laser = new RobotLaser;
+  laser->setLaserParams(LaserParameters(5, -M_PI / 4, M_PI / 8, 30.));
+  std::vector<double> ranges;
+  for (int i = 0; i < 5; ++i)
+    ranges.push_back(1. + 0.25 * i);
+  laser->setRanges(ranges);
+  laser->setOdomPose(SE2(0.1, 0.2, 0.3));
+  laser->setTimestamp(12.5);
+  laser->setLoggerTimestamp(12.75);
+  laser->setHostname("localhost");
+  optimizer.vertex(20)->addUserData(laser);
+}
+
+static string textOf(const SparseOptimizer& optimizer)
+{
+  stringstream text;
+  // the estimate data of a vertex may be converted, e.g., quaternion -> matrix -> quaternion
+  text.precision(10);
+  optimizer.save(text);
+  return text.str();
+}
+
+int main()
+{
+  SparseOptimizer original;
+  createGraph(original);
+
+  stringstream binary;
+  if (! original.saveBinary(binary)) {
+    cerr << "saveBinary() failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  SparseOptimizer loaded;
+  if (! loaded.loadBinary(binary)) {
+    cerr << "loadBinary() failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  int failures = 0;
+  if (loaded.vertices().size() != original.vertices().size() || loaded.edges().size() != original.edges().size()) {
+    cerr << "loaded " << loaded.vertices().size() << " vertices and " << loaded.edges().size() << " edges, expected "
+      << original.vertices().size() << " and " << original.edges().size() << endl;
+    ++failures;
+  }
+  if (! loaded.vertex(20) || ! dynamic_cast<RobotLaser*>(loaded.vertex(20)->userData())) {
+    cerr << "user data of vertex 20 is missing" << endl;
+    ++failures;
+  }
+  string originalText = textOf(original);
+  string loadedText = textOf(loaded);
+  if (originalText != loadedText) {
+    cerr << "the loaded graph differs from the original one" << endl;
+    cerr << "original:" << endl << originalText << "loaded:" << endl << loadedText;
+    ++failures;
+  }
+
+  cerr << "binary size " << binary.str().size() << " bytes, text size " << originalText.size() << " bytes" << endl;
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,313 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Checks the Jacobians computed by linearizeOplus() of the registered edge
+ * types against central differences and measures the time for linearizing
+ * an edge of each type.
+ *
+ * For each edge type a small graph is set up: the vertices are created by
+ * Edge::createVertex(), the parameters are constructed by the factory based
+ * on the type the edge expects. The vertices are moved to a random state,
+ * the measurement is taken from the state if the edge supports it and the
+ * vertices are perturbed again to obtain a non-zero error. Edge types whose
+ * vertices or parameters cannot be created this way are skipped.
+ *
+ * The test fails if the Jacobians of a type differ by more than the
+ * tolerance, except for the types listed in knownDeviations, whose
+ * Jacobians are approximations by design.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include <Eigen/Core>
+
+#include "g2o/apps/g2o_cli/dl_wrapper.h"
+#include "g2o/apps/g2o_cli/g2o_common.h"
+
+#include "g2o/core/factory.h"
+#include "g2o/core/optimizable_graph.h"
+#include "g2o/core/jacobian_workspace.h"
+#include "g2o/core/parameter.h"
+#include "g2o/stuff/command_args.h"
+#include "g2o/stuff/sampler.h"
+#include "g2o/stuff/timeutil.h"
+
+using namespace std;
+using namespace g2o;
+
+struct CheckResult
+{
+  CheckResult() : checked(0), maxError(0.), timeAnalytic(0.), timeNumeric(0.) {}
+  int checked;
+  double maxError;      ///< maximal difference relative to the magnitude of the numeric Jacobian
+  double timeAnalytic;  ///< time of linearizeOplus() per edge
+  double timeNumeric;   ///< time of the central differences per edge
+  string skipped;       ///< reason why the type could not be checked
+};
+
+/**
+ * edge types whose analytic Jacobians are approximations, they are reported
+ * but do not fail the test
+ */
+static std::map<string, string> knownDeviations()
+{
+  std::map<string, string> deviations;
+  deviations["EDGE_LINE3D"] = "identity Jacobians";
+  deviations["EDGE_PROJECT_P2MC_INTRINSICS"] = "rotation derivatives cached by SBACam";
+  deviations["EDGE_SE3:EXPMAP"] = "adjoint approximation for a small error";
+  return deviations;
+}
+
+static void perturb(OptimizableGraph::Vertex* v, double scale)
+{
+  Eigen::VectorXd update(v->dimension());
+  for (int k = 0; k < update.size(); ++k)
+    update(k) = sampleUniform(-scale, scale);
+  v->oplus(update.data());
+}
+
+/**
+ * the Jacobians of the edge computed by central differences on the error
+ */
+static void numericJacobians(OptimizableGraph::Edge* e, double delta, vector<Eigen::MatrixXd>& jacobians)
+{
+  const int D = e->dimension();
+  Eigen::Map<Eigen::VectorXd> error(e->errorData(), D);
+  Eigen::VectorXd errorBak = error;
+  Eigen::VectorXd errorPlus(D);
+  jacobians.resize(e->vertices().size());
+  for (size_t i = 0; i < e->vertices().size(); ++i) {
+    OptimizableGraph::Vertex* v = static_cast<OptimizableGraph::Vertex*>(e->vertex(i));
+    Eigen::VectorXd update = Eigen::VectorXd::Zero(v->dimension());
+    jacobians[i].resize(D, v->dimension());
+    for (int d = 0; d < v->dimension(); ++d) {
+      v->push();
+      update(d) = delta;
+      v->oplus(update.data());
+      e->computeError();
+      errorPlus = error;
+      v->pop();
+      v->push();
+      update(d) = -delta;
+      v->oplus(update.data());
+      e->computeError();
+      v->pop();
+      update(d) = 0.;
+      jacobians[i].col(d) = (errorPlus - error) / (2. * delta);
+    }
+  }
+  error = errorBak;
+}
+
+static Parameter* createParameter(const string& typeName, const vector<string>& parameterTags)
+{
+  Factory* factory = Factory::instance();
+  for (size_t i = 0; i < parameterTags.size(); ++i) {
+    HyperGraph::HyperGraphElement* element = factory->construct(parameterTags[i]);
+    Parameter* p = dynamic_cast<Parameter*>(element);
+    if (p && typeid(*p).name() == typeName)
+      return p;
+    delete element;
+  }
+  return 0;
+}
+
+/**
+ * set up a graph holding one edge of the given type, returns the edge or 0
+ * if this is not possible and sets reason.
+ */
+static OptimizableGraph::Edge* createEdge(OptimizableGraph& graph, const string& tag, const vector<string>& parameterTags, string& reason)
+{
+  OptimizableGraph::Edge* e = dynamic_cast<OptimizableGraph::Edge*>(Factory::instance()->construct(tag));
+  if (! e) {
+    reason = "not an OptimizableGraph::Edge";
+    return 0;
+  }
+  if (e->vertices().size() == 0) {
+    reason = "variable number of vertices";
+    delete e;
+    return 0;
+  }
+
+  for (size_t i = 0; i < e->numParameters(); ++i) {
+    Parameter* p = createParameter(e->parameterType(i), parameterTags);
+    if (! p) {
+      reason = "cannot create the parameters";
+      delete e;
+      return 0;
+    }
+    p->setId(i);
+    graph.addParameter(p);
+    e->setParameterId(i, i);
+  }
+
+  for (size_t i = 0; i < e->vertices().size(); ++i) {
+    OptimizableGraph::Vertex* v = e->createVertex(i);
+    if (! v) {
+      reason = "cannot create the vertices";
+      delete e;
+      return 0;
+    }
+    v->setId(i);
+    graph.addVertex(v);
+    v->setToOrigin();
+    perturb(v, 0.5);
+    e->setVertex(i, v);
+  }
+
+  if (! graph.addEdge(e)) {
+    reason = "cannot add the edge to the graph";
+    delete e;
+    return 0;
+  }
+
+  // a measurement close to the state yields a small, but non-zero error
+  if (e->setMeasurementFromState()) {
+    for (size_t i = 0; i < e->vertices().size(); ++i)
+      perturb(static_cast<OptimizableGraph::Vertex*>(e->vertex(i)), 0.05);
+  }
+  return e;
+}
+
+static void checkType(const string& tag, const vector<string>& parameterTags, int numInstances, int numRepetitions, double delta, CheckResult& result)
+{
+  for (int instance = 0; instance < numInstances; ++instance) {
+    OptimizableGraph graph;
+    OptimizableGraph::Edge* e = createEdge(graph, tag, parameterTags, result.skipped);
+    if (! e)
+      break;
+
+    e->computeError();
+    Eigen::Map<Eigen::VectorXd> error(e->errorData(), e->dimension());
+    if (! error.allFinite()) {
+      result.skipped = "error is not finite";
+      break;
+    }
+
+    JacobianWorkspace workspace;
+    workspace.updateSize(e);
+    workspace.allocate();
+    e->linearizeOplus(workspace);
+    vector<Eigen::MatrixXd> numeric;
+    numericJacobians(e, delta, numeric);
+
+    for (size_t i = 0; i < numeric.size(); ++i) {
+      Eigen::Map<Eigen::MatrixXd> analytic(workspace.workspaceForVertex(i), numeric[i].rows(), numeric[i].cols());
+      if (! numeric[i].allFinite())
+        continue;
+      double scale = std::max(1., numeric[i].cwiseAbs().maxCoeff());
+      double diff = (analytic - numeric[i]).cwiseAbs().maxCoeff() / scale;
+      if (! (diff <= result.maxError))
+        result.maxError = diff;
+    }
+
+    double t = get_monotonic_time();
+    for (int k = 0; k < numRepetitions; ++k)
+      e->linearizeOplus(workspace);
+    result.timeAnalytic += get_monotonic_time() - t;
+
+    t = get_monotonic_time();
+    for (int k = 0; k < numRepetitions; ++k)
+      numericJacobians(e, delta, numeric);
+    result.timeNumeric += get_monotonic_time() - t;
+
+    ++result.checked;
+  }
+  // the instances checked before a skipped one still count
+  if (result.checked == 0)
+    return;
+  result.timeAnalytic /= static_cast<double>(result.checked) * numRepetitions;
+  result.timeNumeric /= static_cast<double>(result.checked) * numRepetitions;
+}
+
+int main(int argc, char** argv)
+{
+  int numInstances;
+  int numRepetitions;
+  int seed;
+  double delta;
+  double tolerance;
+  string onlyTag;
+  string dummy;
+  CommandArgs arg;
+  arg.param("n", numInstances, 10, "number of random edges checked per type");
+  arg.param("r", numRepetitions, 100, "number of repetitions for measuring the time of the linearization");
+  arg.param("seed", seed, 0, "seed for the random states");
+  arg.param("delta", delta, 1e-6, "step size of the central differences");
+  arg.param("tol", tolerance, 1e-3, "maximal difference relative to the magnitude of the Jacobian");
+  arg.param("type", onlyTag, "", "only check the edges with the given tag");
+  arg.param("typeslib", dummy, "", "specify a types library which will be loaded");
+  arg.parseArgs(argc, argv);
+
+  DlWrapper dlTypesWrapper;
+  loadStandardTypes(dlTypesWrapper, argc, argv);
+  Sampler::seedRand(seed);
+
+  Factory* factory = Factory::instance();
+  vector<string> tags;
+  factory->fillKnownTypes(tags);
+  vector<string> edgeTags, parameterTags;
+  for (size_t i = 0; i < tags.size(); ++i) {
+    int elementType;
+    if (! factory->knowsTag(tags[i], &elementType))
+      continue;
+    if (elementType == HyperGraph::HGET_EDGE && (onlyTag.empty() || onlyTag == tags[i]))
+      edgeTags.push_back(tags[i]);
+    else if (elementType == HyperGraph::HGET_PARAMETER)
+      parameterTags.push_back(tags[i]);
+  }
+
+  std::map<string, string> deviations = knownDeviations();
+  int failed = 0;
+  cout << "# " << setw(36) << left << "type" << setw(10) << "result" << setw(14) << "max error"
+    << setw(16) << "linearize [us]" << setw(16) << "numeric [us]" << endl;
+  for (size_t i = 0; i < edgeTags.size(); ++i) {
+    CheckResult result;
+    checkType(edgeTags[i], parameterTags, numInstances, numRepetitions, delta, result);
+    cout << "  " << setw(36) << left << edgeTags[i];
+    if (result.checked == 0) {
+      cout << "skipped (" << result.skipped << ")" << endl;
+      continue;
+    }
+    bool ok = result.maxError <= tolerance;
+    std::map<string, string>::const_iterator known = deviations.find(edgeTags[i]);
+    if (! ok && known == deviations.end())
+      ++failed;
+    cout << setw(10) << (ok ? "ok" : (known != deviations.end() ? "known" : "FAILED")) << setw(14) << result.maxError
+      << setw(16) << 1e6 * result.timeAnalytic << setw(16) << 1e6 * result.timeNumeric;
+    if (! ok && known != deviations.end())
+      cout << "(" << known->second << ")";
+    cout << endl;
+  }
+  return failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
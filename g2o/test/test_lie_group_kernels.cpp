@@ -0,0 +1,123 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 H. Strasdat
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/**
+ * Checks the matrix-free exponential and logarithm of quaternions, SE3Quat
+ * and Sim3: the round trip log(exp(x)) = x down to tiny angles, the rotation
+ * against Eigen::AngleAxisd, and the agreement with the previous
+ * implementations, which went through 3x3 rotation matrices.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#include "lie_group_reference.h"
+
+using namespace std;
+using namespace g2o;
+using namespace Eigen;
+using namespace lie_group_test;
+
+static int failures = 0;
+
+static void check(const char* name, double error, double tolerance)
+{
+  bool ok = error <= tolerance;
+  cerr << (ok ? "ok      " : "FAILED  ") << name << ": max error " << error << " (tolerance " << tolerance << ")" << endl;
+  if (! ok)
+    ++failures;
+}
+
+int main()
+{
+  const int n = 10000;
+  Sampler::seedRand(0);
+
+  // tangent vectors with angles in [1e-3, 3] and scales in exp([-1, 1])
+  vector<Vector6d, aligned_allocator<Vector6d> > xi(n);
+  vector<Vector7d, aligned_allocator<Vector7d> > zeta(n);
+  for (int i = 0; i < n; ++i) {
+    double angle = std::pow(10., sampleUniform(-3., std::log10(3.)));
+    xi[i].head<3>() = sampleRotationVector(angle);
+    zeta[i].head<3>() = xi[i].head<3>();
+    for (int k = 3; k < 6; ++k)
+      xi[i][k] = zeta[i][k] = sampleUniform(-2., 2.);
+    zeta[i][6] = sampleUniform(-1., 1.);
+  }
+
+  // quaternions against the angle axis representation, also close to a half turn
+  double errQuatExp = 0., errQuatLog = 0.;
+  for (int e = -12; e <= 0; ++e) {
+    for (int i = 0; i < 100; ++i) {
+      double angle = i % 2 == 0 ? std::pow(10., e) : M_PI - std::pow(10., e - 1);
+      Vector3D omega = sampleRotationVector(angle);
+      Quaterniond q = quaternionExp(omega);
+      errQuatExp = std::max(errQuatExp, quaternionDistance(q, Quaterniond(AngleAxisd(angle, omega.normalized()))));
+      errQuatLog = std::max(errQuatLog, (quaternionLog(q) - omega).norm());
+    }
+  }
+  check("quaternionExp", errQuatExp, 1e-12);
+  check("quaternionLog(quaternionExp(x))", errQuatLog, 1e-10);
+
+  double errExp = 0., errLog = 0., errSimExp = 0., errSimLog = 0.;
+  for (int i = 0; i < n; ++i) {
+    SE3Quat a = SE3Quat::exp(xi[i]);
+    SE3Quat b = reference::exp(xi[i]);
+    errExp = std::max(errExp, quaternionDistance(a.rotation(), b.rotation()) + (a.translation() - b.translation()).norm());
+    errLog = std::max(errLog, (a.log() - reference::log(b)).norm());
+    Sim3 c(zeta[i]);
+    Sim3 d = reference::exp(zeta[i]);
+    errSimExp = std::max(errSimExp, quaternionDistance(c.rotation(), d.rotation()) + (c.translation() - d.translation()).norm() + fabs(c.scale() - d.scale()));
+    errSimLog = std::max(errSimLog, (c.log() - reference::log(d)).norm());
+  }
+  // the previous logarithm of SE3Quat approximates angles below 4.5e-3 by a second order expansion
+  check("SE3Quat::exp against the previous implementation", errExp, 1e-10);
+  check("SE3Quat::log against the previous implementation", errLog, 1e-6);
+  check("Sim3 exp against the previous implementation", errSimExp, 1e-10);
+  check("Sim3::log against the previous implementation", errSimLog, 1e-10);
+
+  // round trip, in particular for small angles where the previous implementation used approximations
+  double errSmall = 0., errSimSmall = 0.;
+  for (int e = -12; e <= 0; ++e) {
+    for (int i = 0; i < 100; ++i) {
+      Vector6d x = xi[i];
+      x.head<3>() = sampleRotationVector(std::pow(10., e));
+      errSmall = std::max(errSmall, (SE3Quat::exp(x).log() - x).norm());
+      Vector7d z = zeta[i];
+      z.head<3>() = x.head<3>();
+      if (i % 3 == 1)
+        z[6] = 0.;
+      else if (i % 3 == 2)
+        z[6] *= 1e-6;
+      errSimSmall = std::max(errSimSmall, (Sim3(z).log() - z).norm());
+    }
+  }
+  check("SE3Quat log(exp(x))", errSmall, 1e-10);
+  check("Sim3 log(exp(x))", errSimSmall, 1e-10);
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
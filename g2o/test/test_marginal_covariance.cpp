@@ -0,0 +1,159 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Checks the marginal covariances recovered from a Cholesky factor against
+ * the dense inverse, on a small dense factor and on the trailing entries of
+ * a large banded factor whose dimension exceeds the range of r*n+c in int.
+ */
+
+#include <iostream>
+#include <vector>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+#include <Eigen/Cholesky>
+
+#include "g2o/core/marginal_covariance_cholesky.h"
+
+using namespace std;
+using namespace g2o;
+
+//! exposes the entries of the covariance and their hash index
+class MarginalCovarianceCholeskyTest : public MarginalCovarianceCholesky
+{
+  public:
+    using MarginalCovarianceCholesky::computeIndex;
+    using MarginalCovarianceCholesky::computeEntry;
+};
+
+//! CCS storage of the lower triangle of a factor, the diagonal first in each column
+struct CholeskyFactor
+{
+  vector<SparseIndex> Lp;
+  vector<SparseIndex> Li;
+  vector<double> Lx;
+
+  void addColumn() { Lp.push_back(static_cast<SparseIndex>(Li.size()));}
+  void addEntry(int r, double value) { Li.push_back(r); Lx.push_back(value);}
+  void finish() { Lp.push_back(static_cast<SparseIndex>(Li.size()));}
+};
+
+static bool checkSmallDense()
+{
+  const int n = 6;
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+  Eigen::MatrixXd H = A * A.transpose() + n * Eigen::MatrixXd::Identity(n, n);
+  Eigen::MatrixXd L = Eigen::LLT<Eigen::MatrixXd>(H).matrixL();
+  Eigen::MatrixXd covariance = H.inverse();
+
+  CholeskyFactor factor;
+  for (int c = 0; c < n; ++c) {
+    factor.addColumn();
+    for (int r = c; r < n; ++r)
+      factor.addEntry(r, L(r, c));
+  }
+  factor.finish();
+
+  MarginalCovarianceCholesky mcc;
+  mcc.setCholeskyFactor(n, &factor.Lp[0], &factor.Li[0], &factor.Lx[0], 0);
+  vector<int> blockIndices;
+  blockIndices.push_back(2);
+  blockIndices.push_back(n);
+  Eigen::MatrixXd block0(2, 2), block1(n - 2, n - 2);
+  double* covBlocks[] = {block0.data(), block1.data()};
+  mcc.computeCovariance(covBlocks, blockIndices);
+
+  double error = max((block0 - covariance.topLeftCorner(2, 2)).cwiseAbs().maxCoeff(),
+      (block1 - covariance.bottomRightCorner(n - 2, n - 2)).cwiseAbs().maxCoeff());
+  if (error > 1e-10) {
+    cerr << "dense factor: marginal covariance differs from the inverse by " << error << endl;
+    return false;
+  }
+  return true;
+}
+
+static bool checkLargeBanded()
+{
+  // Cholesky factor of the tridiagonal matrix with 4 on the diagonal and -1 next to it
+  const int n = 50000;
+  CholeskyFactor factor;
+  vector<double> diagonal(n), subDiagonal(n, 0.);
+  diagonal[0] = 2.;
+  for (int c = 0; c < n; ++c) {
+    if (c > 0)
+      diagonal[c] = sqrt(4. - subDiagonal[c - 1] * subDiagonal[c - 1]);
+    factor.addColumn();
+    factor.addEntry(c, diagonal[c]);
+    if (c + 1 < n) {
+      subDiagonal[c] = -1. / diagonal[c];
+      factor.addEntry(c + 1, subDiagonal[c]);
+    }
+  }
+  factor.finish();
+
+  MarginalCovarianceCholeskyTest mcc;
+  mcc.setCholeskyFactor(n, &factor.Lp[0], &factor.Li[0], &factor.Lx[0], 0);
+
+  bool ok = true;
+  long long expectedIndex = static_cast<long long>(n - 1) * n + (n - 1);
+  if (expectedIndex <= INT_MAX || mcc.computeIndex(n - 1, n - 1) != expectedIndex) {
+    cerr << "index of entry (" << n - 1 << ", " << n - 1 << ") is " << mcc.computeIndex(n - 1, n - 1)
+      << ", expected " << expectedIndex << endl;
+    ok = false;
+  }
+
+  // the trailing block of the covariance only depends on the trailing block of the factor
+  const int m = 8;
+  Eigen::MatrixXd trailing = Eigen::MatrixXd::Zero(m, m);
+  for (int i = 0; i < m; ++i) {
+    trailing(i, i) = diagonal[n - m + i];
+    if (i + 1 < m)
+      trailing(i + 1, i) = subDiagonal[n - m + i];
+  }
+  Eigen::MatrixXd covariance = (trailing * trailing.transpose()).inverse();
+  for (int r = n - 3; r < n; ++r)
+    for (int c = r; c < n; ++c) {
+      double expected = covariance(r - (n - m), c - (n - m));
+      double entry = mcc.computeEntry(r, c);
+      if (fabs(entry - expected) > 1e-10) {
+        cerr << "banded factor: covariance entry (" << r << ", " << c << ") is " << entry << ", expected " << expected << endl;
+        ok = false;
+      }
+    }
+  return ok;
+}
+
+int main()
+{
+  int failures = 0;
+  if (! checkSmallDense())
+    ++failures;
+  if (! checkLargeBanded())
+    ++failures;
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,184 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Optimizes a graph of two disconnected pose chains once as a whole and once
+ * component by component and checks that both runs arrive at the same chi2 and
+ * estimates and that the actions and statistics of the optimizer are served.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+#include "g2o/core/sparse_optimizer.h"
+#include "g2o/core/block_solver.h"
+#include "g2o/core/optimization_algorithm_gauss_newton.h"
+#include "g2o/core/hyper_graph_action.h"
+#include "g2o/solvers/eigen/linear_solver_eigen.h"
+#include "g2o/types/slam2d/vertex_se2.h"
+#include "g2o/types/slam2d/edge_se2.h"
+
+using namespace std;
+using namespace g2o;
+
+typedef BlockSolver< BlockSolverTraits<-1, -1> > SlamBlockSolver;
+typedef LinearSolverEigen<SlamBlockSolver::PoseMatrixType> SlamLinearSolver;
+
+/**
+ * \brief counts the iterations reported to the post iteration actions
+ */
+class CountIterationsAction : public HyperGraphAction {
+  public:
+    CountIterationsAction() : HyperGraphAction(), iterations(0) {}
+    virtual HyperGraphAction* operator()(const HyperGraph*, Parameters* parameters)
+    {
+      ParametersIteration* params = static_cast<ParametersIteration*>(parameters);
+      if (params && params->iteration >= 0)
+        ++iterations;
+      return this;
+    }
+    int iterations;
+};
+
+//! deterministic noise in [-1, 1]
+static double noise(unsigned int& state)
+{
+  state = state * 1103515245u + 12345u;
+  return ((state >> 8) & 0xffff) / 32767.5 - 1.;
+}
+
+/**
+ * a chain of poses on a circle with loop closures, the first pose is fixed and
+ * the others start from a distorted estimate
+ */
+static void addChain(SparseOptimizer& optimizer, int firstId, int numPoses, double radius, unsigned int seed)
+{
+  unsigned int state = seed;
+  std::vector<SE2> poses;
+  for (int i = 0; i < numPoses; ++i) {
+    double angle = 2. * M_PI * i / numPoses;
+    poses.push_back(SE2(radius * cos(angle), radius * sin(angle), angle + M_PI / 2.));
+    VertexSE2* v = new VertexSE2;
+    v->setId(firstId + i);
+    v->setEstimate(poses.back() * SE2(0.3 * noise(state), 0.3 * noise(state), 0.1 * noise(state)));
+    v->setFixed(i == 0);
+    optimizer.addVertex(v);
+  }
+  Eigen::Matrix3d information = Eigen::Vector3d(100., 100., 1000.).asDiagonal();
+  for (int i = 0; i < numPoses; ++i) {
+    for (int step = 1; step <= 3; step += 2) {
+      int j = (i + step) % numPoses;
+      EdgeSE2* e = new EdgeSE2;
+      e->setVertex(0, optimizer.vertex(firstId + i));
+      e->setVertex(1, optimizer.vertex(firstId + j));
+      e->setMeasurement(poses[i].inverse() * poses[j] * SE2(0.01 * noise(state), 0.01 * noise(state), 0.005 * noise(state)));
+      e->setInformation(information);
+      optimizer.addEdge(e);
+    }
+  }
+}
+
+static void setupOptimizer(SparseOptimizer& optimizer)
+{
+  SlamLinearSolver* linearSolver = new SlamLinearSolver();
+  linearSolver->setBlockOrdering(false);
+  SlamBlockSolver* blockSolver = new SlamBlockSolver(linearSolver);
+  optimizer.setAlgorithm(new OptimizationAlgorithmGaussNewton(blockSolver));
+  addChain(optimizer, 0, 60, 10., 1);
+  addChain(optimizer, 1000, 40, 5., 2);
+}
+
+int main()
+{
+  const int iterations = 10;
+  int failures = 0;
+
+  SparseOptimizer whole;
+  setupOptimizer(whole);
+  whole.initializeOptimization();
+  int wholeIterations = whole.optimize(iterations);
+
+  SparseOptimizer components;
+  setupOptimizer(components);
+  CountIterationsAction countAction;
+  components.addPostIterationAction(&countAction);
+  components.setComputeBatchStatistics(true);
+  components.initializeOptimization();
+  int componentIterations = components.optimizeComponents(iterations);
+  components.removePostIterationAction(&countAction);
+
+  if (components.activeComponents().size() != 2) {
+    cerr << "expected 2 components, got " << components.activeComponents().size() << endl;
+    ++failures;
+  }
+  if (wholeIterations != iterations || componentIterations != iterations) {
+    cerr << "iterations: whole " << wholeIterations << " components " << componentIterations << endl;
+    ++failures;
+  }
+  if (countAction.iterations != 2 * iterations) {
+    cerr << "post iteration actions called " << countAction.iterations << " times" << endl;
+    ++failures;
+  }
+
+  whole.computeActiveErrors();
+  components.computeActiveErrors();
+  double wholeChi2 = whole.activeChi2();
+  double componentChi2 = components.activeChi2();
+  if (fabs(wholeChi2 - componentChi2) > 1e-9 * max(1., wholeChi2)) {
+    cerr << "chi2: whole " << wholeChi2 << " components " << componentChi2 << endl;
+    ++failures;
+  }
+
+  const BatchStatisticsContainer& statistics = components.batchStatistics();
+  if (statistics.size() != static_cast<size_t>(iterations) ||
+      fabs(statistics.back().chi2 - componentChi2) > 1e-9 * max(1., componentChi2) ||
+      statistics.back().numEdges != static_cast<int>(components.activeEdges().size())) {
+    cerr << "batch statistics do not cover the whole graph" << endl;
+    ++failures;
+  }
+
+  double maxDifference = 0.;
+  for (HyperGraph::VertexIDMap::const_iterator it = whole.vertices().begin(); it != whole.vertices().end(); ++it) {
+    const VertexSE2* v = static_cast<const VertexSE2*>(it->second);
+    const VertexSE2* w = static_cast<const VertexSE2*>(components.vertex(it->first));
+    Eigen::Vector3d delta = (v->estimate().inverse() * w->estimate()).toVector();
+    maxDifference = max(maxDifference, delta.lpNorm<Eigen::Infinity>());
+  }
+  if (maxDifference > 1e-9) {
+    cerr << "estimates differ by " << maxDifference << endl;
+    ++failures;
+  }
+
+  // the whole graph is active again after optimizing the components
+  if (components.indexMapping().size() != whole.indexMapping().size()) {
+    cerr << "index mapping not restored" << endl;
+    ++failures;
+  }
+
+  cerr << "chi2 " << wholeChi2 << " / " << componentChi2 << ", max estimate difference " << maxDifference << endl;
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
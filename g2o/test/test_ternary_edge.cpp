@@ -0,0 +1,228 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * Checks the quadratic form constructed by BaseTernaryEdge against
+ * BaseMultiEdge and against the dense J^T Omega J, with analytic and
+ * numeric Jacobians, in the dense and the square root form. If the edge
+ * connects the same vertex more than once, the quadratic form has to match
+ * the total derivative with respect to the distinct vertices.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+#include "g2o/core/base_vertex.h"
+#include "g2o/core/base_ternary_edge.h"
+#include "g2o/core/base_multi_edge.h"
+#include "g2o/core/jacobian_workspace.h"
+
+using namespace std;
+using namespace g2o;
+
+class TestVertex : public BaseVertex<2, Vector2D>
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    virtual void setToOriginImpl() { _estimate.setZero();}
+    virtual void oplusImpl(const double* update) { _estimate += Eigen::Map<const Vector2D>(update);}
+    virtual bool read(std::istream&) { return false;}
+    virtual bool write(std::ostream&) const { return false;}
+};
+
+//! a non-linear error in the three vertices
+static Vector2D testError(const Vector2D& xi, const Vector2D& xj, const Vector2D& xk)
+{
+  return Vector2D(xi(0) * xj(1) + sin(xk(0)), xi(1) + xj(0) * xk(1));
+}
+
+//! partial derivatives of testError() with respect to its three arguments
+static void testJacobians(const Vector2D& xi, const Vector2D& xj, const Vector2D& xk, Matrix2D* J)
+{
+  J[0] << xj(1), 0., 0., 1.;
+  J[1] << 0., xi(0), xk(1), 0.;
+  J[2] << cos(xk(0)), 0., 0., xj(0);
+}
+
+class TestTernaryEdge : public BaseTernaryEdge<2, Vector2D, TestVertex, TestVertex, TestVertex>
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    explicit TestTernaryEdge(bool analytic) : _analytic(analytic) {}
+    virtual void computeError()
+    {
+      _error = testError(estimate(0), estimate(1), estimate(2)) - _measurement;
+    }
+    virtual void linearizeOplus()
+    {
+      if (! _analytic) {
+        BaseTernaryEdge<2, Vector2D, TestVertex, TestVertex, TestVertex>::linearizeOplus();
+        return;
+      }
+      Matrix2D J[3];
+      testJacobians(estimate(0), estimate(1), estimate(2), J);
+      _jacobianOplusXi = J[0];
+      _jacobianOplusXj = J[1];
+      _jacobianOplusXk = J[2];
+    }
+    virtual bool read(std::istream&) { return false;}
+    virtual bool write(std::ostream&) const { return false;}
+
+  protected:
+    bool _analytic;
+    const Vector2D& estimate(int i) const { return static_cast<const TestVertex*>(_vertices[i])->estimate();}
+};
+
+class TestMultiEdge : public BaseMultiEdge<2, Vector2D>
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    TestMultiEdge() { resize(3);}
+    virtual void computeError()
+    {
+      _error = testError(estimate(0), estimate(1), estimate(2)) - _measurement;
+    }
+    virtual bool read(std::istream&) { return false;}
+    virtual bool write(std::ostream&) const { return false;}
+
+  protected:
+    const Vector2D& estimate(int i) const { return static_cast<const TestVertex*>(_vertices[i])->estimate();}
+};
+
+/**
+ * connects the edge to the vertices given by slots and builds its quadratic
+ * form over the three vertices. The Hessian blocks are mapped as the block
+ * solver does, a block between two slots of the same vertex is the diagonal
+ * block of that vertex.
+ */
+static void quadraticForm(OptimizableGraph::Edge* e, TestVertex* vertices, const int* slots, bool sqrtInformation,
+    Eigen::MatrixXd& H, Eigen::VectorXd& b)
+{
+  Matrix2D blocks[3][3];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j)
+      blocks[i][j].setZero();
+    vertices[i].mapHessianMemory(blocks[i][i].data());
+    vertices[i].clearQuadraticForm();
+    e->setVertex(i, &vertices[slots[i]]);
+  }
+  for (int i = 0; i < 3; ++i)
+    for (int j = i+1; j < 3; ++j)
+      e->mapHessianMemory(blocks[min(slots[i], slots[j])][max(slots[i], slots[j])].data(), i, j, slots[i] > slots[j]);
+
+  Matrix2D information;
+  information << 3., 0.5, 0.5, 2.;
+  static_cast<BaseEdge<2, Vector2D>*>(e)->setInformation(information);
+  static_cast<BaseEdge<2, Vector2D>*>(e)->setMeasurement(Vector2D(0.1, -0.2));
+  e->setUseSqrtInformation(sqrtInformation);
+
+  JacobianWorkspace workspace;
+  workspace.updateSize(e);
+  workspace.allocate();
+  e->computeError();
+  e->linearizeOplus(workspace);
+  e->constructQuadraticForm();
+
+  H.setZero(6, 6);
+  b.setZero(6);
+  for (int i = 0; i < 3; ++i) {
+    b.segment<2>(2*i) = vertices[i].b();
+    for (int j = i; j < 3; ++j) {
+      H.block<2, 2>(2*i, 2*j) = blocks[i][j];
+      if (j > i)
+        H.block<2, 2>(2*j, 2*i) = blocks[i][j].transpose();
+    }
+  }
+}
+
+//! the quadratic form of the total derivative with respect to the vertices
+static void referenceQuadraticForm(TestVertex* vertices, const int* slots, Eigen::MatrixXd& H, Eigen::VectorXd& b)
+{
+  Matrix2D information;
+  information << 3., 0.5, 0.5, 2.;
+  const Vector2D& xi = vertices[slots[0]].estimate();
+  const Vector2D& xj = vertices[slots[1]].estimate();
+  const Vector2D& xk = vertices[slots[2]].estimate();
+  Matrix2D J[3];
+  testJacobians(xi, xj, xk, J);
+  Eigen::Matrix<double, 2, 6> jacobian = Eigen::Matrix<double, 2, 6>::Zero();
+  for (int i = 0; i < 3; ++i)
+    jacobian.block<2, 2>(0, 2 * slots[i]) += J[i];
+  Vector2D error = testError(xi, xj, xk) - Vector2D(0.1, -0.2);
+  H = jacobian.transpose() * information * jacobian;
+  b = - jacobian.transpose() * information * error;
+}
+
+static int failures = 0;
+
+static void check(const char* name, const int* slots, bool sqrtInformation, const Eigen::MatrixXd& H, const Eigen::VectorXd& b,
+    const Eigen::MatrixXd& Href, const Eigen::VectorXd& bref, double tolerance)
+{
+  double error = max((H - Href).cwiseAbs().maxCoeff(), (b - bref).cwiseAbs().maxCoeff());
+  bool ok = error <= tolerance;
+  cerr << (ok ? "ok      " : "FAILED  ") << name << " vertices " << slots[0] << " " << slots[1] << " " << slots[2]
+    << (sqrtInformation ? " sqrt " : " dense") << ": max error " << error << endl;
+  if (! ok)
+    ++failures;
+}
+
+int main()
+{
+  TestVertex vertices[3];
+  for (int i = 0; i < 3; ++i) {
+    vertices[i].setId(i);
+    vertices[i].setEstimate(Vector2D(0.3 + 0.2 * i, -0.7 + 0.5 * i));
+  }
+
+  const int slotsOfTests[][3] = {{0, 1, 2}, {2, 0, 1}, {0, 0, 1}, {0, 1, 0}, {1, 0, 0}, {0, 0, 0}};
+  for (size_t t = 0; t < sizeof(slotsOfTests) / sizeof(slotsOfTests[0]); ++t) {
+    const int* slots = slotsOfTests[t];
+    const bool distinct = slots[0] != slots[1] && slots[0] != slots[2] && slots[1] != slots[2];
+    for (int s = 0; s < 2; ++s) {
+      const bool sqrtInformation = s == 1;
+      Eigen::MatrixXd Href, H, Hmulti;
+      Eigen::VectorXd bref, b, bmulti;
+      referenceQuadraticForm(vertices, slots, Href, bref);
+
+      TestTernaryEdge analytic(true);
+      quadraticForm(&analytic, vertices, slots, sqrtInformation, H, b);
+      check("analytic ternary edge", slots, sqrtInformation, H, b, Href, bref, 1e-12);
+
+      TestTernaryEdge numeric(false);
+      quadraticForm(&numeric, vertices, slots, sqrtInformation, H, b);
+      check("numeric ternary edge ", slots, sqrtInformation, H, b, Href, bref, 1e-5);
+
+      // the numeric Jacobians of BaseMultiEdge are the total derivatives only for distinct vertices
+      if (distinct) {
+        TestMultiEdge multi;
+        quadraticForm(&multi, vertices, slots, sqrtInformation, Hmulti, bmulti);
+        check("numeric ternary edge against BaseMultiEdge", slots, sqrtInformation, H, b, Hmulti, bmulti, 1e-5);
+      }
+    }
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -28,8 +28,18 @@
 
 #include "g2o/types/data/robot_data.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace g2o {
 
+  namespace {
+    struct CompareTimestamp {
+      bool operator()(const DataQueue::BufferEntry& entry, double timestamp) const { return entry.first < timestamp;}
+      bool operator()(double timestamp, const DataQueue::BufferEntry& entry) const { return timestamp < entry.first;}
+    };
+  }
+
   DataQueue::DataQueue()
   {
   }
@@ -40,12 +50,16 @@ namespace g2o {
 
   RobotData* DataQueue::findClosestData(double timestamp) const
   {
-    if (_buffer.rbegin()->first < timestamp)
-      return _buffer.rbegin()->second;
-    if (_buffer.begin()->first > timestamp)
-      return _buffer.begin()->second;
+    if (_buffer.size() == 0)
+      return 0;
+    if (_buffer.back().first < timestamp)
+      return _buffer.back().second;
+    if (_buffer.front().first > timestamp)
+      return _buffer.front().second;
 
-    Buffer::const_iterator ub = _buffer.upper_bound(timestamp);
+    Buffer::const_iterator ub = std::upper_bound(_buffer.begin(), _buffer.end(), timestamp, CompareTimestamp());
+    if (ub == _buffer.end()) // timestamp of the last element
+      return _buffer.back().second;
     Buffer::const_iterator lb = ub;
     --lb;
     if (fabs(lb->first - timestamp) < fabs(ub->first - timestamp))
@@ -56,18 +70,18 @@ namespace g2o {
 
   RobotData* DataQueue::before(double timestamp) const
   {
-    if (_buffer.size() == 0 || _buffer.begin()->first > timestamp)
+    if (_buffer.size() == 0 || _buffer.front().first > timestamp)
       return 0;
-    Buffer::const_iterator lb = _buffer.upper_bound(timestamp);
+    Buffer::const_iterator lb = std::upper_bound(_buffer.begin(), _buffer.end(), timestamp, CompareTimestamp());
     --lb; // now it's the lower bound
     return lb->second;
   }
 
   RobotData* DataQueue::after(double timestamp) const
   {
-    if (_buffer.size() == 0 || _buffer.rbegin()->first < timestamp)
+    if (_buffer.size() == 0 || _buffer.back().first < timestamp)
       return 0;
-    Buffer::const_iterator ub = _buffer.upper_bound(timestamp);
+    Buffer::const_iterator ub = std::upper_bound(_buffer.begin(), _buffer.end(), timestamp, CompareTimestamp());
     if (ub == _buffer.end())
       return 0;
     return ub->second;
@@ -75,7 +89,16 @@ namespace g2o {
 
   void DataQueue::add(RobotData* rd)
   {
-    _buffer[rd->timestamp()] = rd;
+    double timestamp = rd->timestamp();
+    if (_buffer.size() == 0 || _buffer.back().first < timestamp) {
+      _buffer.push_back(BufferEntry(timestamp, rd));
+      return;
+    }
+    Buffer::iterator lb = std::lower_bound(_buffer.begin(), _buffer.end(), timestamp, CompareTimestamp());
+    if (lb->first == timestamp)
+      lb->second = rd;
+    else
+      _buffer.insert(lb, BufferEntry(timestamp, rd));
   }
 
 } // end namespace
@@ -27,7 +27,8 @@
 #ifndef G2O_DATA_QUEUE_H
 #define G2O_DATA_QUEUE_H
 
-#include <map>
+#include <vector>
+#include <utility>
 #include "g2o_types_data_api.h"
 
 namespace g2o {
@@ -36,16 +37,22 @@ namespace g2o {
 
   /**
    * \brief a simple queue to store data and retrieve based on a timestamp
+   *
+   * The data is kept in a vector sorted by the timestamp, the queries are
+   * binary searches. Adding the data in chronological order is amortized
+   * constant time, as it is the case for reading a logfile.
    */
   class G2O_TYPES_DATA_API DataQueue
   {
     public:
-      typedef std::map<double, RobotData*>           Buffer;
+      typedef std::pair<double, RobotData*>          BufferEntry;
+      typedef std::vector<BufferEntry>               Buffer;
 
     public:
       DataQueue();
       ~DataQueue();
 
+      //! adds the data, replaces the data already stored for the same timestamp
       void add(RobotData* rd);
 
       RobotData* findClosestData(double timestamp) const;
@@ -26,8 +26,35 @@
 
 #include "laser_parameters.h"
 
+#include "g2o/core/openmp_mutex.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 namespace g2o {
 
+  namespace {
+    bool identical(const LaserParameters& a, const LaserParameters& b)
+    {
+      return a.type == b.type && a.firstBeamAngle == b.firstBeamAngle && a.fov == b.fov && a.angularStep == b.angularStep
+        && a.accuracy == b.accuracy && a.remissionMode == b.remissionMode && a.maxRange == b.maxRange
+        && a.laserPose.toVector() == b.laserPose.toVector();
+    }
+
+    size_t hashValue(const LaserParameters& params)
+    {
+      std::hash<double> hashDouble;
+      Vector3D pose = params.laserPose.toVector();
+      double values[] = {params.firstBeamAngle, params.fov, params.angularStep, params.accuracy, params.maxRange,
+        pose(0), pose(1), pose(2)};
+      size_t seed = std::hash<int>()(params.type) ^ (std::hash<int>()(params.remissionMode) << 1);
+      for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+        seed ^= hashDouble(values[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  }
+
   LaserParameters::LaserParameters(int t, int nbeams, double _firstBeamAngle, double _angularStep, double _maxRange, double _accuracy, int _remissionMode)
   {
     type           = t;
@@ -52,4 +79,28 @@ namespace g2o {
     fov            = angularStep * nbeams;
   }
 
+  std::shared_ptr<const LaserParameters> LaserParameters::shared(const LaserParameters& params)
+  {
+    // instances with the same hash value are compared exactly, expired ones are dropped on the way
+    typedef std::vector<std::weak_ptr<const LaserParameters> > Bucket;
+    static std::unordered_map<size_t, Bucket> pool;
+    static OpenMPMutex poolMutex;
+    ScopedOpenMPMutex lock(&poolMutex);
+    Bucket& bucket = pool[hashValue(params)];
+    for (size_t i = 0; i < bucket.size();) {
+      std::shared_ptr<const LaserParameters> candidate = bucket[i].lock();
+      if (! candidate) {
+        bucket[i] = bucket.back();
+        bucket.pop_back();
+        continue;
+      }
+      if (identical(*candidate, params))
+        return candidate;
+      ++i;
+    }
+    std::shared_ptr<const LaserParameters> result(new LaserParameters(params));
+    bucket.push_back(result);
+    return result;
+  }
+
 } // end namespace
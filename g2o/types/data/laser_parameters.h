@@ -30,6 +30,8 @@
 #include "g2o/types/slam2d/se2.h"
 #include "g2o_types_data_api.h"
 
+#include <memory>
+
 namespace g2o {
 
   /**
@@ -40,6 +42,14 @@ namespace g2o {
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
     LaserParameters(int type, int beams, double firstBeamAngle, double angularStep, double maxRange, double accuracy, int remissionMode);
     LaserParameters(int beams, double firstBeamAngle, double angularStep, double maxRange);
+
+    /**
+     * returns an immutable instance holding identical values. The instances
+     * are pooled, i.e., the scans of the same sensor share one instance
+     * instead of storing a copy each.
+     */
+    static std::shared_ptr<const LaserParameters> shared(const LaserParameters& params);
+
     SE2 laserPose;
     int type;
     double firstBeamAngle;
@@ -26,15 +26,27 @@
 
 #include "raw_laser.h"
 
+#include "g2o/stuff/macros.h"
+#include "g2o/core/binary_io.h"
+
 #include <iostream>
+#include <iomanip>
 
 using namespace std;
 
 namespace g2o {
 
+  namespace {
+    std::shared_ptr<const LaserParameters> defaultLaserParams()
+    {
+      static std::shared_ptr<const LaserParameters> params = LaserParameters::shared(LaserParameters(0, 180, -M_PI/2, M_PI/180., 50.,0.1, 0));
+      return params;
+    }
+  }
+
   RawLaser::RawLaser() :
     RobotData(),
-    _laserParams(0, 180, -M_PI/2, M_PI/180., 50.,0.1, 0)
+    _laserParams(defaultLaserParams())
   {
   }
 
@@ -42,14 +54,28 @@ namespace g2o {
   {
   }
 
-  bool RawLaser::write(std::ostream& /*os*/) const
+  bool RawLaser::write(std::ostream& os) const
   {
-    // TODO
-    cerr << "RawLaser::write() not implemented yet." << endl;
-    return false;
+    writeParamsAndBeams(os);
+    os << FIXED(" " << timestamp() << " " << hostname() << " " << loggerTimestamp());
+    return os.good();
   }
 
   bool RawLaser::read(std::istream& is)
+  {
+    LaserParameters params = laserParams();
+    if (! readParamsAndBeams(is, params))
+      return false;
+    _laserParams = LaserParameters::shared(params);
+
+    // timestamp + host
+    is >> _timestamp;
+    is >> _hostname;
+    is >> _loggerTimestamp;
+    return true;
+  }
+
+  bool RawLaser::readParamsAndBeams(std::istream& is, LaserParameters& params)
   {
     int type;
     double angle, fov, res, maxrange, acc;
@@ -58,45 +84,104 @@ namespace g2o {
 
     int beams;
     is >> beams;
-    _laserParams = LaserParameters(type, beams, angle, res, maxrange, acc, remission_mode);      
+    if (! is || beams < 0)
+      return false;
+    params = LaserParameters(type, beams, angle, res, maxrange, acc, remission_mode);
     _ranges.resize(beams);
     for (int i=0; i<beams; i++)
       is >> _ranges[i];
 
     is >> beams;
+    if (! is || beams < 0)
+      return false;
     _remissions.resize(beams);
     for (int i=0; i < beams; i++)
       is >> _remissions[i];
-
-    // timestamp + host
-    is >> _timestamp;
-    is >> _hostname;
-    is >> _loggerTimestamp;
     return true;
   }
 
-  void RawLaser::setRanges(const vector<double>& ranges)
+  void RawLaser::writeParamsAndBeams(std::ostream& os) const
+  {
+    const LaserParameters& params = laserParams();
+    os << params.type << " " << params.firstBeamAngle << " " << params.fov << " "
+      << params.angularStep << " " << params.maxRange << " " << params.accuracy << " "
+      << params.remissionMode << " ";
+    os << _ranges.size();
+    for (size_t i = 0; i < _ranges.size(); ++i)
+      os << " " << _ranges[i];
+    os << " " << _remissions.size();
+    for (size_t i = 0; i < _remissions.size(); ++i)
+      os << " " << _remissions[i];
+  }
+
+  bool RawLaser::writeBinary(std::ostream& os) const
+  {
+    const LaserParameters& params = laserParams();
+    writeBinaryValue(os, params.type);
+    writeBinaryValue(os, params.remissionMode);
+    const double values[] = {params.firstBeamAngle, params.fov, params.angularStep, params.accuracy, params.maxRange,
+      params.laserPose.translation().x(), params.laserPose.translation().y(), params.laserPose.rotation().angle(),
+      _timestamp, _loggerTimestamp};
+    os.write(reinterpret_cast<const char*>(values), sizeof(values));
+    writeBinaryString(os, _hostname);
+    writeBinaryArray(os, _ranges);
+    writeBinaryArray(os, _remissions);
+    return os.good();
+  }
+
+  bool RawLaser::readBinary(std::istream& is)
+  {
+    LaserParameters params = laserParams();
+    double values[10];
+    if (! readBinaryValue(is, params.type) || ! readBinaryValue(is, params.remissionMode)
+        || ! is.read(reinterpret_cast<char*>(values), sizeof(values)))
+      return false;
+    params.firstBeamAngle = values[0];
+    params.fov            = values[1];
+    params.angularStep    = values[2];
+    params.accuracy       = values[3];
+    params.maxRange       = values[4];
+    params.laserPose      = SE2(values[5], values[6], values[7]);
+    _laserParams = LaserParameters::shared(params);
+    _timestamp = values[8];
+    _loggerTimestamp = values[9];
+    return readBinaryString(is, _hostname) && readBinaryArray(is, _ranges) && readBinaryArray(is, _remissions);
+  }
+
+  void RawLaser::setRanges(const BeamVector& ranges)
   {
     _ranges = ranges;
   }
 
-  void RawLaser::setRemissions(const std::vector<double>& remissions)
+  void RawLaser::setRanges(const vector<double>& ranges)
+  {
+    _ranges.assign(ranges.begin(), ranges.end());
+  }
+
+  void RawLaser::setRemissions(const BeamVector& remissions)
   {
     _remissions = remissions;
   }
 
+  void RawLaser::setRemissions(const std::vector<double>& remissions)
+  {
+    _remissions.assign(remissions.begin(), remissions.end());
+  }
+
   void RawLaser::setLaserParams(const LaserParameters& laserParams)
   {
-    _laserParams = laserParams;
+    _laserParams = LaserParameters::shared(laserParams);
   }
 
   RawLaser::Point2DVector RawLaser::cartesian() const
   {
+    const LaserParameters& params = laserParams();
     Point2DVector points;
+    points.reserve(_ranges.size());
     for (size_t i = 0; i < _ranges.size(); ++i) {
-      const double& r = _ranges[i];
-      if (r < _laserParams.maxRange) {
-        double alpha = _laserParams.firstBeamAngle + i * _laserParams.angularStep;
+      const double r = _ranges[i];
+      if (r < params.maxRange) {
+        double alpha = params.firstBeamAngle + i * params.angularStep;
         points.push_back(Vector2D(cos(alpha) * r, sin(alpha) * r));
       }
     }
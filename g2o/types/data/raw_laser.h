@@ -42,10 +42,13 @@ namespace g2o {
    * \brief Raw laser measuerement
    *
    * A raw laser measuerement. The read/write function correspond to the format of CARMEN.
+   * The beams are stored in single precision and the parameters of the laser are
+   * shared among the measurements of the same sensor, see LaserParameters::shared().
    */
   class G2O_TYPES_DATA_API RawLaser : public RobotData {
     public:
       typedef std::vector<Vector2D, Eigen::aligned_allocator<Vector2D> >      Point2DVector;
+      typedef std::vector<float>                                              BeamVector;
 
     public:
       RawLaser();
@@ -53,6 +56,8 @@ namespace g2o {
 
       virtual bool write(std::ostream& os) const;
       virtual bool read(std::istream& is);
+      virtual bool writeBinary(std::ostream& os) const;
+      virtual bool readBinary(std::istream& is);
 
       /**
        * computes a cartesian view of the beams (x,y).
@@ -61,21 +66,28 @@ namespace g2o {
       Point2DVector cartesian() const;
 
       //! the range measurements by the laser
-      const std::vector<double>& ranges() const { return _ranges;}
+      const BeamVector& ranges() const { return _ranges;}
+      void setRanges(const BeamVector& ranges);
       void setRanges(const std::vector<double>& ranges);
 
       //! the remission measurements by the laser
-      const std::vector<double>& remissions() const { return _remissions;}
+      const BeamVector& remissions() const { return _remissions;}
+      void setRemissions(const BeamVector& remissions);
       void setRemissions(const std::vector<double>& remissions);
 
       //! the parameters of the laser
-      const LaserParameters& laserParams() const { return _laserParams;}
+      const LaserParameters& laserParams() const { return *_laserParams;}
       void setLaserParams(const LaserParameters& laserParams);
 
     protected:
-      std::vector<double> _ranges;
-      std::vector<double> _remissions;
-      LaserParameters _laserParams;
+      //! reads the parameters of the laser as written by CARMEN followed by the beams
+      bool readParamsAndBeams(std::istream& is, LaserParameters& params);
+      //! writes the parameters of the laser and the beams in the format of CARMEN
+      void writeParamsAndBeams(std::ostream& os) const;
+
+      BeamVector _ranges;
+      BeamVector _remissions;
+      std::shared_ptr<const LaserParameters> _laserParams;
   };
 
 } // end namespace
@@ -49,22 +49,9 @@ namespace g2o {
 
   bool RobotLaser::read(std::istream& is)
   {
-    int type;
-    double angle, fov, res, maxrange, acc;
-    int remission_mode;
-    is >> type >> angle >> fov >> res >> maxrange >> acc >> remission_mode;
-
-    int beams;
-    is >> beams;
-    _laserParams = LaserParameters(type, beams, angle, res, maxrange, acc, remission_mode);      
-    _ranges.resize(beams);
-    for (int i=0; i<beams; i++)
-      is >> _ranges[i];
-
-    is >> beams;
-    _remissions.resize(beams);
-    for (int i = 0; i < beams; i++)
-      is >> _remissions[i];
+    LaserParameters params = laserParams();
+    if (! readParamsAndBeams(is, params))
+      return false;
 
     // special robot laser stuff
     double x,y,theta;
@@ -74,7 +61,8 @@ namespace g2o {
     is >> x >> y >> theta;
     //cerr << "x: " << x << " y:" << y << " th:" << theta;
     _odomPose = SE2(x,y,theta);
-    _laserParams.laserPose = _odomPose.inverse()*lp;
+    params.laserPose = _odomPose.inverse()*lp;
+    _laserParams = LaserParameters::shared(params);
     is >> _laserTv >>  _laserRv >>  _forwardSafetyDist >> _sideSaftyDist >> _turnAxis;
 
     // timestamp + host
@@ -86,18 +74,10 @@ namespace g2o {
 
   bool RobotLaser::write(std::ostream& os) const
   {
-    os << _laserParams.type << " " << _laserParams.firstBeamAngle << " " << _laserParams.fov << " "
-      << _laserParams.angularStep << " " << _laserParams.maxRange << " " << _laserParams.accuracy << " "
-      << _laserParams.remissionMode << " ";
-    os << ranges().size();
-    for (size_t i = 0; i < ranges().size(); ++i)
-      os << " " << ranges()[i];
-    os << " " << _remissions.size();
-    for (size_t i = 0; i < _remissions.size(); ++i)
-      os << " " << _remissions[i];
+    writeParamsAndBeams(os);
 
     // odometry pose
-    Vector3D p = (_odomPose * _laserParams.laserPose).toVector();
+    Vector3D p = laserPose().toVector();
     os << " " << p.x() << " " << p.y() << " " << p.z();
     p = _odomPose.toVector();
     os << " " << p.x() << " " << p.y() << " " << p.z();
@@ -110,6 +90,31 @@ namespace g2o {
     return os.good();
   }
 
+  bool RobotLaser::writeBinary(std::ostream& os) const
+  {
+    if (! RawLaser::writeBinary(os))
+      return false;
+    // the laser pose is part of the parameters, which are written by RawLaser
+    const double values[] = {_odomPose.translation().x(), _odomPose.translation().y(), _odomPose.rotation().angle(),
+      _laserTv, _laserRv, _forwardSafetyDist, _sideSaftyDist, _turnAxis};
+    os.write(reinterpret_cast<const char*>(values), sizeof(values));
+    return os.good();
+  }
+
+  bool RobotLaser::readBinary(std::istream& is)
+  {
+    double values[8];
+    if (! RawLaser::readBinary(is) || ! is.read(reinterpret_cast<char*>(values), sizeof(values)))
+      return false;
+    _odomPose = SE2(values[0], values[1], values[2]);
+    _laserTv = values[3];
+    _laserRv = values[4];
+    _forwardSafetyDist = values[5];
+    _sideSaftyDist = values[6];
+    _turnAxis = values[7];
+    return true;
+  }
+
   void RobotLaser::setOdomPose(const SE2& odomPose)
   {
     _odomPose = odomPose;
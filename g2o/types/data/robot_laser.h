@@ -48,8 +48,10 @@ namespace g2o {
 
       virtual bool write(std::ostream& os) const;
       virtual bool read(std::istream& is);
+      virtual bool writeBinary(std::ostream& os) const;
+      virtual bool readBinary(std::istream& is);
 
-      SE2 laserPose() const { return _odomPose * _laserParams.laserPose;} 
+      SE2 laserPose() const { return _odomPose * _laserParams->laserPose;}
       const SE2& odomPose() const { return _odomPose;}
       void setOdomPose(const SE2& odomPose);
 
@@ -127,10 +127,10 @@ namespace deprecated {
     VertexSE3 *v = static_cast<VertexSE3*>(_vertices[0]);
 
     SE3Quat newEstimate = _offsetParam->offset().inverse() * measurement();
-    if (_information.block<3,3>(0,0).squaredNorm()==0){ // do not set translation
+    if (currentInformation().block<3,3>(0,0).squaredNorm()==0){ // do not set translation
       newEstimate.setTranslation(v->estimate().translation());
     }
-    if (_information.block<3,3>(3,3).squaredNorm()==0){ // do not set rotation
+    if (currentInformation().block<3,3>(3,3).squaredNorm()==0){ // do not set rotation
       newEstimate.setRotation(v->estimate().rotation());
     }
     v->setEstimate(newEstimate);
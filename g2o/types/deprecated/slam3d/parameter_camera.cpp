@@ -87,7 +87,7 @@ namespace deprecated {
 
   void CacheCamera::updateImpl(){
     CacheSE3Offset::updateImpl();
-    _w2i.matrix().topLeftCorner<3,4>() = params->Kcam() * w2nMatrix().matrix().topLeftCorner<3,4>();
+    _w2i.matrix().topLeftCorner<3,4>() = params->Kcam() * _w2n.matrix().topLeftCorner<3,4>();
   }
 
 #ifdef G2O_HAVE_OPENGL
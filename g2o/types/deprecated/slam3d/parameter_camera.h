@@ -64,7 +64,7 @@ namespace deprecated {
     //! parameters of the camera
     const ParameterCamera* camParams() const {return params;}
     //! return the world to image transform
-    const Eigen::Affine3d& w2i() const {return _w2i;}
+    const Eigen::Affine3d& w2i() const { ensureUpdated(); return _w2i;}
   protected:
     virtual void updateImpl();
     virtual bool resolveDependancies();
@@ -87,12 +87,12 @@ namespace deprecated {
       const ParameterSE3Offset* offsetParam() const { return _offsetParam;}
       void setOffsetParam(ParameterSE3Offset* offsetParam);
 
-      const SE3Quat& w2n() const {return _se3_w2n;}
-      const SE3Quat& n2w() const {return _se3_n2w;}
+      const SE3Quat& w2n() const { ensureUpdated(); return _se3_w2n;}
+      const SE3Quat& n2w() const { ensureUpdated(); return _se3_n2w;}
 
-      const Eigen::Isometry3d& w2nMatrix() const { return _w2n;}
-      const Eigen::Isometry3d& n2wMatrix() const { return _n2w;}
-      const Eigen::Isometry3d& w2lMatrix() const { return _w2l;}
+      const Eigen::Isometry3d& w2nMatrix() const { ensureUpdated(); return _w2n;}
+      const Eigen::Isometry3d& n2wMatrix() const { ensureUpdated(); return _n2w;}
+      const Eigen::Isometry3d& w2lMatrix() const { ensureUpdated(); return _w2l;}
 
     protected:
       ParameterSE3Offset* _offsetParam; ///< the parameter connected to the cache
@@ -0,0 +1,323 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gicp_correspondence_search.h"
+
+#include "g2o/core/sparse_optimizer.h"
+#include "g2o/config.h"
+
+#include <Eigen/Eigenvalues>
+#include <cassert>
+#include <algorithm>
+
+namespace g2o {
+
+  namespace {
+    struct ComparePointsAlongAxis {
+      ComparePointsAlongAxis(const PointCloud3D& cloud, int axis) : _cloud(cloud), _axis(axis) {}
+      bool operator()(int a, int b) const { return _cloud[a](_axis) < _cloud[b](_axis);}
+      const PointCloud3D& _cloud;
+      int _axis;
+    };
+  }
+
+  PointKDTree::PointKDTree() :
+    _cloud(0), _leafSize(8)
+  {
+  }
+
+  void PointKDTree::build(const PointCloud3D* cloud, int leafSize)
+  {
+    clear();
+    _cloud = cloud;
+    _leafSize = std::max(1, leafSize);
+    _indices.resize(cloud->size());
+    for (size_t i = 0; i < _indices.size(); ++i)
+      _indices[i] = static_cast<int>(i);
+    _nodes.reserve(2 * _indices.size() / _leafSize + 1);
+    build(0, static_cast<int>(_indices.size()));
+  }
+
+  void PointKDTree::clear()
+  {
+    _indices.clear();
+    _nodes.clear();
+    _cloud = 0;
+  }
+
+  int PointKDTree::build(int begin, int end)
+  {
+    int nodeIndex = static_cast<int>(_nodes.size());
+    _nodes.push_back(Node());
+    Node node;
+    node.begin = begin;
+    node.end = end;
+    node.left = node.right = -1;
+    node.axis = 0;
+    node.split = 0.;
+    if (end - begin > _leafSize) {
+      // split along the axis of the largest extent at the median
+      Vector3D minCorner = (*_cloud)[_indices[begin]];
+      Vector3D maxCorner = minCorner;
+      for (int i = begin + 1; i < end; ++i) {
+        minCorner = minCorner.cwiseMin((*_cloud)[_indices[i]]);
+        maxCorner = maxCorner.cwiseMax((*_cloud)[_indices[i]]);
+      }
+      (maxCorner - minCorner).maxCoeff(&node.axis);
+      int mid = begin + (end - begin) / 2;
+      std::nth_element(_indices.begin() + begin, _indices.begin() + mid, _indices.begin() + end,
+          ComparePointsAlongAxis(*_cloud, node.axis));
+      node.split = (*_cloud)[_indices[mid]](node.axis);
+      node.left = build(begin, mid);
+      node.right = build(mid, end);
+    }
+    _nodes[nodeIndex] = node;
+    return nodeIndex;
+  }
+
+  int PointKDTree::nearest(const Vector3D& p, double maxDistance, double* squaredDistance, int hint) const
+  {
+    int best = -1;
+    double bestDistance = maxDistance * maxDistance;
+    if (hint >= 0) {
+      double d = ((*_cloud)[hint] - p).squaredNorm();
+      if (d <= bestDistance) {
+        bestDistance = d;
+        best = hint;
+      }
+    }
+    if (_nodes.size())
+      nearest(0, p, best, bestDistance);
+    if (squaredDistance)
+      *squaredDistance = bestDistance;
+    return best;
+  }
+
+  void PointKDTree::nearest(int nodeIndex, const Vector3D& p, int& best, double& bestDistance) const
+  {
+    const Node& node = _nodes[nodeIndex];
+    if (node.left < 0) {
+      for (int i = node.begin; i < node.end; ++i) {
+        double d = ((*_cloud)[_indices[i]] - p).squaredNorm();
+        if (d <= bestDistance) {
+          bestDistance = d;
+          best = _indices[i];
+        }
+      }
+      return;
+    }
+    double diff = p(node.axis) - node.split;
+    int nearChild = diff < 0. ? node.left : node.right;
+    int farChild = diff < 0. ? node.right : node.left;
+    nearest(nearChild, p, best, bestDistance);
+    if (diff * diff <= bestDistance)
+      nearest(farChild, p, best, bestDistance);
+  }
+
+  void PointKDTree::radiusSearch(const Vector3D& p, double radius, std::vector<int>& indices) const
+  {
+    indices.clear();
+    if (_nodes.size())
+      radiusSearch(0, p, radius * radius, indices);
+  }
+
+  void PointKDTree::radiusSearch(int nodeIndex, const Vector3D& p, double r2, std::vector<int>& indices) const
+  {
+    const Node& node = _nodes[nodeIndex];
+    if (node.left < 0) {
+      for (int i = node.begin; i < node.end; ++i) {
+        if (((*_cloud)[_indices[i]] - p).squaredNorm() <= r2)
+          indices.push_back(_indices[i]);
+      }
+      return;
+    }
+    double diff = p(node.axis) - node.split;
+    if (diff < 0. || diff * diff <= r2)
+      radiusSearch(node.left, p, r2, indices);
+    if (diff >= 0. || diff * diff <= r2)
+      radiusSearch(node.right, p, r2, indices);
+  }
+
+  GICPCorrespondenceSearch::GICPCorrespondenceSearch() :
+    HyperGraphAction(),
+    _v0(0), _v1(0),
+    _maxDistance(0.5), _normalRadius(0.1), _associationInterval(1),
+    _epsilon(0.01), _planeToPlane(false)
+  {
+  }
+
+  void GICPCorrespondenceSearch::setVertices(VertexSE3* v0, VertexSE3* v1)
+  {
+    _v0 = v0;
+    _v1 = v1;
+  }
+
+  void GICPCorrespondenceSearch::setTargetCloud(const PointCloud3D& cloud)
+  {
+    _target = cloud;
+    _targetNormals.clear();
+    _targetTree.build(&_target);
+  }
+
+  void GICPCorrespondenceSearch::setSourceCloud(const PointCloud3D& cloud)
+  {
+    _source = cloud;
+    _sourceNormals.clear();
+  }
+
+  void GICPCorrespondenceSearch::computeNormals()
+  {
+    computeNormals(_target, _targetTree, _targetNormals);
+    PointKDTree sourceTree;
+    sourceTree.build(&_source);
+    computeNormals(_source, sourceTree, _sourceNormals);
+  }
+
+  void GICPCorrespondenceSearch::computeNormals(const PointCloud3D& cloud, const PointKDTree& tree, PointCloud3D& normals) const
+  {
+    normals.resize(cloud.size());
+    std::vector<int> neighbors;
+#   ifdef G2O_OPENMP
+#   pragma omp parallel for default (shared) firstprivate(neighbors) schedule(dynamic, 1000)
+#   endif
+    for (int i = 0; i < static_cast<int>(cloud.size()); ++i) {
+      tree.radiusSearch(cloud[i], _normalRadius, neighbors);
+      if (neighbors.size() < 3) {
+        normals[i] = Vector3D(0., 0., 1.);
+        continue;
+      }
+      Vector3D mean = Vector3D::Zero();
+      Matrix3D cov = Matrix3D::Zero();
+      for (size_t k = 0; k < neighbors.size(); ++k) {
+        const Vector3D& p = cloud[neighbors[k]];
+        mean += p;
+        cov.noalias() += p * p.transpose();
+      }
+      const double n = static_cast<double>(neighbors.size());
+      mean /= n;
+      cov = cov / n - mean * mean.transpose();
+      // the eigenvalues are sorted in increasing order
+      Eigen::SelfAdjointEigenSolver<Matrix3D> eigenSolver;
+      eigenSolver.computeDirect(cov);
+      normals[i] = eigenSolver.eigenvectors().col(0).normalized();
+    }
+  }
+
+  int GICPCorrespondenceSearch::createEdges(SparseOptimizer* optimizer)
+  {
+    assert(_v0 && _v1 && "vertices not set");
+    _edges.resize(_source.size());
+    _associations.assign(_source.size(), -1);
+    for (size_t i = 0; i < _source.size(); ++i) {
+      Edge_V_V_GICP* e = new Edge_V_V_GICP();
+      e->setVertex(0, _v0);
+      e->setVertex(1, _v1);
+      EdgeGICP meas;
+      meas.pos0 = meas.pos1 = _source[i];
+      e->setMeasurement(meas);
+      e->information().setZero();
+      optimizer->addEdge(e);
+      _edges[i] = e;
+    }
+    associate();
+    return static_cast<int>(_edges.size());
+  }
+
+  void GICPCorrespondenceSearch::updateEdge(int sourceIndex, int targetIndex)
+  {
+    Edge_V_V_GICP* e = _edges[sourceIndex];
+    _associations[sourceIndex] = targetIndex;
+    if (targetIndex < 0) {
+      // no correspondence, the edge does not contribute to the system
+      e->pl_pl = false;
+      e->information().setZero();
+      return;
+    }
+
+    EdgeGICP meas = e->measurement();
+    meas.pos0 = _target[targetIndex];
+    meas.pos1 = _source[sourceIndex];
+    bool haveNormals = _targetNormals.size() == _target.size() && _sourceNormals.size() == _source.size();
+    if (! haveNormals) {
+      e->setMeasurement(meas);
+      e->pl_pl = false;
+      e->information().setIdentity();
+      return;
+    }
+
+    meas.normal0 = _targetNormals[targetIndex];
+    meas.normal1 = _sourceNormals[sourceIndex];
+    e->setMeasurement(meas);
+    if (_planeToPlane) {
+      e->setPlaneToPlane(_epsilon);
+    } else {
+      e->pl_pl = false;
+      e->information() = meas.prec0(_epsilon);
+    }
+  }
+
+  int GICPCorrespondenceSearch::associate()
+  {
+    assert(_v0 && _v1 && "vertices not set");
+    assert(_edges.size() == _source.size() && "call createEdges() first");
+    // transformation from the frame of the source to the one of the target cloud
+    const Isometry3D T = _v0->estimate().inverse() * _v1->estimate();
+    int changed = 0;
+#   ifdef G2O_OPENMP
+#   pragma omp parallel for default (shared) reduction(+:changed) schedule(dynamic, 1000)
+#   endif
+    for (int i = 0; i < static_cast<int>(_source.size()); ++i) {
+      int j = _targetTree.nearest(T * _source[i], _maxDistance, 0, _associations[i]);
+      if (j != _associations[i]) {
+        updateEdge(i, j);
+        ++changed;
+      }
+    }
+    return changed;
+  }
+
+  int GICPCorrespondenceSearch::numAssociated() const
+  {
+    int count = 0;
+    for (size_t i = 0; i < _associations.size(); ++i)
+      if (_associations[i] >= 0)
+        ++count;
+    return count;
+  }
+
+  HyperGraphAction* GICPCorrespondenceSearch::operator()(const HyperGraph* graph, Parameters* parameters)
+  {
+    (void) graph;
+    assert(dynamic_cast<HyperGraphAction::ParametersIteration*>(parameters) && "error casting parameters");
+    HyperGraphAction::ParametersIteration* params = static_cast<HyperGraphAction::ParametersIteration*>(parameters);
+    if (params->iteration < 0 || _associationInterval <= 0 || _edges.empty())
+      return this;
+    if (params->iteration % _associationInterval == 0)
+      associate();
+    return this;
+  }
+
+} // end namespace
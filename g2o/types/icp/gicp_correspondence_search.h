@@ -0,0 +1,189 @@
+// g2o - General Graph Optimization
+// Copyright (C) 2011 R. Kuemmerle, G. Grisetti, W. Burgard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef G2O_GICP_CORRESPONDENCE_SEARCH_H
+#define G2O_GICP_CORRESPONDENCE_SEARCH_H
+
+#include "types_icp.h"
+#include "g2o/core/hyper_graph_action.h"
+#include "g2o_types_icp_api.h"
+
+#include <vector>
+
+namespace g2o {
+
+  class SparseOptimizer;
+
+  typedef std::vector<Vector3D> PointCloud3D;
+
+  /**
+   * \brief k-d tree over a point cloud for nearest neighbor and fixed radius queries
+   */
+  class G2O_TYPES_ICP_API PointKDTree
+  {
+    public:
+      PointKDTree();
+
+      /**
+       * build the tree, the cloud has to stay valid while the tree is in use
+       */
+      void build(const PointCloud3D* cloud, int leafSize = 8);
+      void clear();
+
+      /**
+       * index of the nearest point within maxDistance of p, -1 if there is none.
+       * If squaredDistance is given it is set to the squared distance of the point.
+       * A hint, e.g., the result of a previous query for a nearby point, speeds up the search.
+       */
+      int nearest(const Vector3D& p, double maxDistance, double* squaredDistance = 0, int hint = -1) const;
+
+      /**
+       * indices of all points within radius of p
+       */
+      void radiusSearch(const Vector3D& p, double radius, std::vector<int>& indices) const;
+
+      const PointCloud3D* cloud() const { return _cloud;}
+
+    protected:
+      struct Node {
+        int begin, end;   ///< range of the points in _indices, only valid for leaves
+        int left, right;  ///< children, -1 for a leaf
+        int axis;
+        double split;
+      };
+
+      int build(int begin, int end);
+      void nearest(int node, const Vector3D& p, int& best, double& bestDistance) const;
+      void radiusSearch(int node, const Vector3D& p, double r2, std::vector<int>& indices) const;
+
+      const PointCloud3D* _cloud;
+      int _leafSize;
+      std::vector<int> _indices;
+      std::vector<Node> _nodes;
+  };
+
+  /**
+   * \brief correspondence search for GICP registration of two point clouds
+   *
+   * The target cloud is expressed in the frame of the first vertex, the
+   * source cloud in the frame of the second one. createEdges() adds one
+   * Edge_V_V_GICP per source point to the optimizer. Added as a
+   * preIteration action, the nearest neighbor of each source point is
+   * re-associated every associationInterval() iterations. Only the
+   * measurements of edges whose association changed are rewritten, the
+   * structure of the graph stays the same. Hence, the optimizer does not
+   * need to be re-initialized. Source points without a neighbor within
+   * maxDistance() get a zero information matrix.
+   */
+  class G2O_TYPES_ICP_API GICPCorrespondenceSearch : public HyperGraphAction
+  {
+    public:
+      GICPCorrespondenceSearch();
+
+      void setVertices(VertexSE3* v0, VertexSE3* v1);
+      VertexSE3* vertex0() const { return _v0;}
+      VertexSE3* vertex1() const { return _v1;}
+
+      //! set the target cloud, builds the k-d tree of the cloud
+      void setTargetCloud(const PointCloud3D& cloud);
+      //! set the source cloud
+      void setSourceCloud(const PointCloud3D& cloud);
+      const PointCloud3D& targetCloud() const { return _target;}
+      const PointCloud3D& sourceCloud() const { return _source;}
+      const PointCloud3D& targetNormals() const { return _targetNormals;}
+      const PointCloud3D& sourceNormals() const { return _sourceNormals;}
+
+      /**
+       * estimate the normals of both clouds from the covariance of the
+       * points within normalRadius() of each point.
+       */
+      void computeNormals();
+
+      /**
+       * add one edge per source point to the optimizer and associate them.
+       * Returns the number of edges created.
+       */
+      int createEdges(SparseOptimizer* optimizer);
+
+      /**
+       * search the nearest target point for each source point given the
+       * current estimate of the vertices. Returns the number of edges
+       * whose association changed.
+       */
+      int associate();
+
+      virtual HyperGraphAction* operator()(const HyperGraph* graph, Parameters* parameters = 0);
+
+      //! maximal distance between associated points
+      double maxDistance() const { return _maxDistance;}
+      void setMaxDistance(double maxDistance) { _maxDistance = maxDistance;}
+
+      //! radius of the neighborhood for estimating the normals
+      double normalRadius() const { return _normalRadius;}
+      void setNormalRadius(double normalRadius) { _normalRadius = normalRadius;}
+
+      //! re-associate every n-th iteration
+      int associationInterval() const { return _associationInterval;}
+      void setAssociationInterval(int interval) { _associationInterval = interval;}
+
+      //! uncertainty along the surface, see EdgeGICP::prec0()
+      double epsilon() const { return _epsilon;}
+      void setEpsilon(double epsilon) { _epsilon = epsilon;}
+
+      //! use the plane-to-plane instead of the point-to-plane metric
+      bool planeToPlane() const { return _planeToPlane;}
+      void setPlaneToPlane(bool planeToPlane) { _planeToPlane = planeToPlane;}
+
+      const std::vector<Edge_V_V_GICP*>& edges() const { return _edges;}
+      //! index of the target point associated to each source point, -1 if none
+      const std::vector<int>& associations() const { return _associations;}
+      //! number of source points with an associated target point
+      int numAssociated() const;
+
+    protected:
+      void computeNormals(const PointCloud3D& cloud, const PointKDTree& tree, PointCloud3D& normals) const;
+      void updateEdge(int sourceIndex, int targetIndex);
+
+      VertexSE3* _v0;
+      VertexSE3* _v1;
+      PointCloud3D _target;
+      PointCloud3D _source;
+      PointCloud3D _targetNormals;
+      PointCloud3D _sourceNormals;
+      PointKDTree _targetTree;
+      std::vector<Edge_V_V_GICP*> _edges;
+      std::vector<int> _associations;
+
+      double _maxDistance;
+      double _normalRadius;
+      int _associationInterval;
+      double _epsilon;
+      bool _planeToPlane;
+  };
+
+} // end namespace
+
+#endif
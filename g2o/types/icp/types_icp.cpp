@@ -144,14 +144,8 @@ namespace g2o {
 
     // GICP info matrices
 
-    // point-plane only
-    Matrix3D prec;
-    double v = .01;
-    prec << v, 0, 0,
-            0, v, 0,
-            0, 0, 1;
-    const Matrix3D &R = measurement().R0; // plane of the point in vp0
-    information() = R.transpose()*prec*R;
+    // point-plane only, plane of the point in vp0
+    information() = _measurement.prec0(.01);
 
     //    information().setIdentity();
 
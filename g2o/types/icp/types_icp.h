@@ -90,7 +90,9 @@ namespace g2o {
       y << 0, 1, 0;
       R0.row(2) = normal0;
       y = y - normal0(1)*normal0;
-      y.normalize();            // need to check if y is close to 0
+      if (y.squaredNorm() < 1e-12) // normal is parallel to the y axis
+        y = Vector3D(1, 0, 0) - normal0(0)*normal0;
+      y.normalize();
       R0.row(1) = y;
       R0.row(0) = normal0.cross(R0.row(1));
       //      cout << normal.transpose() << endl;
@@ -105,53 +107,47 @@ namespace g2o {
       y << 0, 1, 0;
       R1.row(2) = normal1;
       y = y - normal1(1)*normal1;
-      y.normalize();            // need to check if y is close to 0
+      if (y.squaredNorm() < 1e-12) // normal is parallel to the y axis
+        y = Vector3D(1, 0, 0) - normal1(0)*normal1;
+      y.normalize();
       R1.row(1) = y;
       R1.row(0) = normal1.cross(R1.row(1));
     }
 
+    // The matrices below are R'*diag(.)*R with R from makeRot0() / makeRot1().
+    // Since the last row of R is the unit normal n, they are computed in closed
+    // form as a*I + (b-a)*n*n' without setting up R.
+
     // returns a precision matrix for point-plane
-    Matrix3D prec0(double e)
+    Matrix3D prec0(double e) const
     {
-      makeRot0();
-      Matrix3D prec;
-      prec << e, 0, 0,
-              0, e, 0,
-              0, 0, 1;
-      return R0.transpose()*prec*R0;
+      return rotatedDiagonal(normal0, e, 1.);
     }
     
     // returns a precision matrix for point-plane
-    Matrix3D prec1(double e)
+    Matrix3D prec1(double e) const
     {
-      makeRot1();
-      Matrix3D prec;
-      prec << e, 0, 0,
-              0, e, 0,
-              0, 0, 1;
-      return R1.transpose()*prec*R1;
+      return rotatedDiagonal(normal1, e, 1.);
     }
     
     // return a covariance matrix for plane-plane
-    Matrix3D cov0(double e)
+    Matrix3D cov0(double e) const
     {
-      makeRot0();
-      Matrix3D cov;
-      cov  << 1, 0, 0,
-              0, 1, 0,
-              0, 0, e;
-      return R0.transpose()*cov*R0;
+      return rotatedDiagonal(normal0, 1., e);
     }
     
     // return a covariance matrix for plane-plane
-    Matrix3D cov1(double e)
+    Matrix3D cov1(double e) const
     {
-      makeRot1();
-      Matrix3D cov;
-      cov  << 1, 0, 0,
-              0, 1, 0,
-              0, 0, e;
-      return R1.transpose()*cov*R1;
+      return rotatedDiagonal(normal1, 1., e);
+    }
+
+    // R'*diag(a,a,b)*R for the rotation R whose last row is the unit normal n
+    static Matrix3D rotatedDiagonal(const Vector3D& n, double a, double b)
+    {
+      Matrix3D m = (b - a) * n * n.transpose();
+      m.diagonal().array() += a;
+      return m;
     }
 
   };
@@ -172,6 +168,18 @@ namespace g2o {
     bool pl_pl;
     Matrix3D cov0, cov1;
 
+    /**
+     * switch to plane-plane and set up cov0 and cov1 from the normals of the
+     * measurement. The covariances are kept until this is called again, e.g.,
+     * because the normals or the uncertainty e changed.
+     */
+    void setPlaneToPlane(double e)
+    {
+      pl_pl = true;
+      cov0 = _measurement.cov0(e);
+      cov1 = _measurement.cov1(e);
+    }
+
     // I/O functions
     virtual bool read(std::istream& is);
     virtual bool write(std::ostream& os) const;
@@ -183,50 +191,22 @@ namespace g2o {
       const VertexSE3 *vp0 = static_cast<const VertexSE3*>(_vertices[0]);
       const VertexSE3 *vp1 = static_cast<const VertexSE3*>(_vertices[1]);
 
-      // get vp1 point into vp0 frame
-      // could be more efficient if we computed this transform just once
-      Vector3D p1;
-
-#if 0
-      if (_cnum >= 0 && 0)      // using global cache
-        {
-          if (_tainted[_cnum])  // set up transform
-            {
-              _transforms[_cnum] = vp0->estimate().inverse() * vp1->estimate();
-              _tainted[_cnum] = 0;
-              cout << _transforms[_cnum] << endl;
-            }
-          p1 = _transforms[_cnum].map(measurement().pos1); // do the transform
-        }
-      else
-#endif
-        {
-          p1 = vp1->estimate() * measurement().pos1;
-          p1 = vp0->estimate().inverse() * p1;
-        }
-
-      //      cout << endl << "Error computation; points are: " << endl;
-      //      cout << p0.transpose() << endl;
-      //      cout << p1.transpose() << endl;
-
-      // get their difference
-      // this is simple Euclidean distance, for now
-      _error = p1 - measurement().pos0;
-
-#if 0
-      cout << "vp0" << endl << vp0->estimate() << endl;
-      cout << "vp1" << endl << vp1->estimate() << endl;
-      cout << "e Jac Xj" << endl <<  _jacobianOplusXj << endl << endl;
-      cout << "e Jac Xi" << endl << _jacobianOplusXi << endl << endl;
-#endif
-
-      if (!pl_pl) return;
+      if (!pl_pl) {
+        // get vp1 point into vp0 frame
+        // this is simple Euclidean distance, for now
+        const Isometry3D& T0 = vp0->estimate();
+        Vector3D p1 = vp1->estimate() * measurement().pos1;
+        _error = T0.linear().transpose() * (p1 - T0.translation()) - measurement().pos0;
+        return;
+      }
 
-      // re-define the information matrix
-      // topLeftCorner<3,3>() is the rotation()
-      const Matrix3D transform = ( vp0->estimate().inverse() *  vp1->estimate() ).matrix().topLeftCorner<3,3>();
-      information() = ( cov0 + transform * cov1 * transform.transpose() ).inverse();
+      // the relative transform is needed for the point and for rotating cov1
+      const Isometry3D T01 = vp0->estimate().inverse() * vp1->estimate();
+      _error = T01 * measurement().pos1 - measurement().pos0;
 
+      // re-define the information matrix from the cached covariances
+      const Matrix3D R = T01.linear();
+      information() = ( cov0 + R * cov1 * R.transpose() ).inverse();
     }
 
     // try analytic jacobians
@@ -407,10 +407,9 @@ namespace g2o {
 
   // point to camera projection, monocular
   EdgeProjectP2MC_Intrinsics::EdgeProjectP2MC_Intrinsics() :
-    BaseMultiEdge<2, Vector2D>()
+    BaseTernaryEdge<2, Vector2D, VertexSBAPointXYZ, VertexCam, VertexIntrinsics>()
   {
     information().setIdentity();
-    resize(3);
   }
 
 /**
@@ -418,9 +417,6 @@ namespace g2o {
  */
   void EdgeProjectP2MC_Intrinsics::linearizeOplus()
   {
-    _jacobianOplus[0].resize(2,3);
-    _jacobianOplus[1].resize(2,6);
-    _jacobianOplus[2].resize(2,4);
     VertexCam *vc = static_cast<VertexCam *>(_vertices[1]);
     const SBACam &cam = vc->estimate();
 
@@ -458,46 +454,46 @@ namespace g2o {
 
     // dx
     Eigen::Matrix<double,3,1,Eigen::ColMajor> dp = cam.dRdx * pwt; // dR'/dq * [pw - t]
-    _jacobianOplus[1](0,3) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[1](1,3) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXj(0,3) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXj(1,3) = (pz*dp(1) - py*dp(2))*ipz2fy;
     // dy
     dp = cam.dRdy * pwt; // dR'/dq * [pw - t]
-    _jacobianOplus[1](0,4) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[1](1,4) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXj(0,4) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXj(1,4) = (pz*dp(1) - py*dp(2))*ipz2fy;
     // dz
     dp = cam.dRdz * pwt; // dR'/dq * [pw - t]
-    _jacobianOplus[1](0,5) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[1](1,5) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXj(0,5) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXj(1,5) = (pz*dp(1) - py*dp(2))*ipz2fy;
 
     // set d(t) values [ pz*dpx/dx - px*dpz/dx ] / pz^2
     dp = -cam.w2n.col(0);        // dpc / dx
-    _jacobianOplus[1](0,0) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[1](1,0) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXj(0,0) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXj(1,0) = (pz*dp(1) - py*dp(2))*ipz2fy;
     dp = -cam.w2n.col(1);        // dpc / dy
-    _jacobianOplus[1](0,1) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[1](1,1) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXj(0,1) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXj(1,1) = (pz*dp(1) - py*dp(2))*ipz2fy;
     dp = -cam.w2n.col(2);        // dpc / dz
-    _jacobianOplus[1](0,2) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[1](1,2) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXj(0,2) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXj(1,2) = (pz*dp(1) - py*dp(2))*ipz2fy;
 
     // Jacobians wrt point parameters
     // set d(t) values [ pz*dpx/dx - px*dpz/dx ] / pz^2
     dp = cam.w2n.col(0); // dpc / dx
-    _jacobianOplus[0](0,0) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[0](1,0) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXi(0,0) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXi(1,0) = (pz*dp(1) - py*dp(2))*ipz2fy;
     dp = cam.w2n.col(1); // dpc / dy
-    _jacobianOplus[0](0,1) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[0](1,1) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXi(0,1) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXi(1,1) = (pz*dp(1) - py*dp(2))*ipz2fy;
     dp = cam.w2n.col(2); // dpc / dz
-    _jacobianOplus[0](0,2) = (pz*dp(0) - px*dp(2))*ipz2fx;
-    _jacobianOplus[0](1,2) = (pz*dp(1) - py*dp(2))*ipz2fy;
+    _jacobianOplusXi(0,2) = (pz*dp(0) - px*dp(2))*ipz2fx;
+    _jacobianOplusXi(1,2) = (pz*dp(1) - py*dp(2))*ipz2fy;
 
     // Jacobians w.r.t the intrinsics
-    _jacobianOplus[2].setZero();
-    _jacobianOplus[2](0,0) = px/pz; // dx/dfx
-    _jacobianOplus[2](1,1) = py/pz; // dy/dfy
-    _jacobianOplus[2](0,2) = 1.;    // dx/dcx
-    _jacobianOplus[2](1,3) = 1.;    // dy/dcy
+    _jacobianOplusXk.setZero();
+    _jacobianOplusXk(0,0) = px/pz; // dx/dfx
+    _jacobianOplusXk(1,1) = py/pz; // dy/dfy
+    _jacobianOplusXk(0,2) = 1.;    // dx/dcx
+    _jacobianOplusXk(1,3) = 1.;    // dy/dcy
   }
 
   bool EdgeProjectP2MC_Intrinsics::read(std::istream& is)
@@ -29,7 +29,7 @@
 
 #include "g2o/core/base_vertex.h"
 #include "g2o/core/base_binary_edge.h"
-#include "g2o/core/base_multi_edge.h"
+#include "g2o/core/base_ternary_edge.h"
 #include "sbacam.h"
 #include <Eigen/Geometry>
 #include <iostream>
@@ -251,7 +251,7 @@ class G2O_TYPES_SBA_API VertexIntrinsics : public BaseVertex<4, Eigen::Matrix<do
 
 // monocular projection with parameter calibration
 // first two args are the measurement type, second two the connection classes
- class G2O_TYPES_SBA_API EdgeProjectP2MC_Intrinsics : public  BaseMultiEdge<2, Vector2D> 
+ class G2O_TYPES_SBA_API EdgeProjectP2MC_Intrinsics : public  BaseTernaryEdge<2, Vector2D, VertexSBAPointXYZ, VertexCam, VertexIntrinsics>
 {
   public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
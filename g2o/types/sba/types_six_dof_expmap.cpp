@@ -227,15 +227,18 @@ void EdgeProjectPSI2UV::linearizeOplus(){
   Vector3D y = T_ca*x_a;
   Matrix<double,2,3,Eigen::ColMajor> Jcam
       = d_proj_d_y(cam->focal_length, y);
-  _jacobianOplus[0] = -Jcam*d_Tinvpsi_d_psi(T_ca, psi_a);
-  _jacobianOplus[1] = -Jcam*d_expy_d_y(y);
-  _jacobianOplus[2] = Jcam*T_ca.rotation().toRotationMatrix()*d_expy_d_y(x_a);
+  _jacobianOplusXi = -Jcam*d_Tinvpsi_d_psi(T_ca, psi_a);
+  _jacobianOplusXj = -Jcam*d_expy_d_y(y);
+  _jacobianOplusXk = Jcam*T_ca.rotation().toRotationMatrix()*d_expy_d_y(x_a);
 }
 
 
 
 EdgeProjectXYZ2UVU::EdgeProjectXYZ2UVU() : BaseBinaryEdge<3, Vector3D, VertexSBAPointXYZ, VertexSE3Expmap>()
 {
+  _cam = 0;
+  resizeParameters(1);
+  installParameter(_cam, 0);
 }
 
 bool EdgeProjectXYZ2UV::read(std::istream& is){
@@ -325,7 +328,48 @@ void EdgeProjectXYZ2UV::linearizeOplus() {
   _jacobianOplusXj(1,5) = y/z_2 *cam->focal_length;
 }
 
+void EdgeProjectXYZ2UVU::linearizeOplus() {
+  VertexSE3Expmap * vj = static_cast<VertexSE3Expmap *>(_vertices[1]);
+  SE3Quat T(vj->estimate());
+  VertexSBAPointXYZ* vi = static_cast<VertexSBAPointXYZ*>(_vertices[0]);
+  Vector3D xyz = vi->estimate();
+  Vector3D xyz_trans = T.map(xyz);
+
+  const CameraParameters * cam = static_cast<const CameraParameters *>(parameter(0));
+
+  double x = xyz_trans[0];
+  double y = xyz_trans[1];
+  double z = xyz_trans[2];
+  double z_2 = z*z;
+
+  // derivative of (u_left, v_left, u_right) wrt the point in the camera frame
+  Matrix<double,3,3,Eigen::ColMajor> tmp;
+  tmp(0,0) = cam->focal_length/z;
+  tmp(0,1) = 0;
+  tmp(0,2) = -x/z_2*cam->focal_length;
+
+  tmp(1,0) = 0;
+  tmp(1,1) = cam->focal_length/z;
+  tmp(1,2) = -y/z_2*cam->focal_length;
+
+  tmp(2,0) = cam->focal_length/z;
+  tmp(2,1) = 0;
+  tmp(2,2) = -(x-cam->baseline)/z_2*cam->focal_length;
+
+  _jacobianOplusXi = -tmp * T.rotation().toRotationMatrix();
+
+  // exp(update) * T moves the transformed point by omega x p + upsilon
+  Matrix<double,3,6,Eigen::ColMajor> dp;
+  dp.block<3,3>(0,0) = -skew(xyz_trans);
+  dp.block<3,3>(0,3).setIdentity();
+  _jacobianOplusXj = -tmp * dp;
+}
+
 bool EdgeProjectXYZ2UVU::read(std::istream& is){
+  int paramId;
+  is >> paramId;
+  setParameterId(0, paramId);
+
   for (int i=0; i<3; i++){
     is  >> _measurement[i];
   }
@@ -339,6 +383,7 @@ bool EdgeProjectXYZ2UVU::read(std::istream& is){
 }
 
 bool EdgeProjectXYZ2UVU::write(std::ostream& os) const {
+  os << _cam->id() << " ";
   for (int i=0; i<3; i++){
     os  << measurement()[i] << " ";
   }
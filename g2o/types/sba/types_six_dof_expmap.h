@@ -29,6 +29,7 @@
 
 #include "g2o/core/base_vertex.h"
 #include "g2o/core/base_binary_edge.h"
+#include "g2o/core/base_ternary_edge.h"
 #include "g2o/types/slam3d/se3_ops.h"
 #include "types_sba.h"
 #include <Eigen/Geometry>
@@ -153,7 +154,7 @@ class G2O_TYPES_SBA_API EdgeProjectXYZ2UV : public  BaseBinaryEdge<2, Vector2D,
 };
 
 
-class G2O_TYPES_SBA_API EdgeProjectPSI2UV : public  g2o::BaseMultiEdge<2, Vector2D>
+class G2O_TYPES_SBA_API EdgeProjectPSI2UV : public  g2o::BaseTernaryEdge<2, Vector2D, VertexSBAPointXYZ, VertexSE3Expmap, VertexSE3Expmap>
 {
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -194,7 +195,10 @@ class G2O_TYPES_SBA_API EdgeProjectXYZ2UVU : public  BaseBinaryEdge<3, Vector3D,
       Vector3D obs(_measurement);
       _error = obs-cam->stereocam_uvu_map(v1->estimate().map(v2->estimate()));
     }
-    //  virtual void linearizeOplus();
+
+    virtual void linearizeOplus();
+
+    CameraParameters * _cam;
 };
 
 } // end namespace
@@ -38,6 +38,82 @@ namespace g2o {
     resize(3);
   }
 
+  OptimizableGraph::Vertex* EdgeSE2OdomDifferentialCalib::createVertex(int i)
+  {
+    switch (i) {
+      case 0: return new VertexSE2();
+      case 1: return new VertexSE2();
+      case 2: return new VertexOdomDifferentialParams();
+      default: return 0;
+    }
+  }
+
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+  void EdgeSE2OdomDifferentialCalib::linearizeOplus()
+  {
+    const VertexSE2* v1                        = static_cast<const VertexSE2*>(_vertices[0]);
+    const VertexSE2* v2                        = static_cast<const VertexSE2*>(_vertices[1]);
+    const VertexOdomDifferentialParams* params = static_cast<const VertexOdomDifferentialParams*>(_vertices[2]);
+    const SE2& x1                              = v1->estimate();
+    const SE2& x2                              = v2->estimate();
+    const Vector3D& p                          = params->estimate();
+
+    const double vl = measurement().vl() * p(0);
+    const double vr = measurement().vr() * p(1);
+    const double dt = measurement().dt();
+    const double b  = p(2);
+    VelocityMeasurement calibratedVelocityMeasurment(vl, vr, dt);
+    MotionMeasurement mm = OdomConvert::convertToMotion(calibratedVelocityMeasurment, b);
+    SE2 Ku_ij;
+    Ku_ij.fromVector(mm.measurement());
+
+    // derivative of the motion (x, y, theta) w.r.t. (vl, vr, b), see OdomConvert::convertToMotion()
+    Matrix3D dMotion;
+    if (fabs(vr - vl) > 1e-7) {
+      double s = vl + vr;
+      double d = vr - vl;
+      double R = 0.5 * b * s / d;
+      double theta = d * dt / b;
+      double st = sin(theta);
+      double ct = cos(theta);
+      Vector3D dR(b * vr / (d * d), -b * vl / (d * d), 0.5 * s / d);
+      Vector3D dTheta(-dt / b, dt / b, -d * dt / (b * b));
+      dMotion.row(0) = st * dR.transpose() + R * ct * dTheta.transpose();
+      dMotion.row(1) = (1. - ct) * dR.transpose() + R * st * dTheta.transpose();
+      dMotion.row(2) = dTheta.transpose();
+    } else {
+      // limit of the above for a straight motion
+      double s = vl + vr;
+      dMotion <<
+        0.5 * dt,                0.5 * dt,               0.,
+        -0.25 * s * dt * dt / b, 0.25 * s * dt * dt / b, 0.,
+        -dt / b,                 dt / b,                 0.;
+    }
+    dMotion.col(0) *= measurement().vl();
+    dMotion.col(1) *= measurement().vr();
+
+    const Matrix2D RkT = Ku_ij.rotation().toRotationMatrix().transpose();
+    const Matrix2D R1T = x1.rotation().toRotationMatrix().transpose();
+    const Vector2D t12 = x2.translation() - x1.translation();
+    const Vector2D tk = R1T * t12 - Ku_ij.translation();
+
+    // the derivative of R(theta)^T * v w.r.t. theta is R(theta)^T * [v_y, -v_x]
+    _jacobianOplus[0].block<2,2>(0,0) = -RkT * R1T;
+    _jacobianOplus[0].block<2,1>(0,2) = RkT * R1T * Vector2D(t12.y(), -t12.x());
+    _jacobianOplus[0].row(2) << 0., 0., -1.;
+
+    _jacobianOplus[1].block<2,2>(0,0) = RkT * R1T;
+    _jacobianOplus[1].block<2,1>(0,2).setZero();
+    _jacobianOplus[1].row(2) << 0., 0., 1.;
+
+    Matrix3D dErrorMotion;
+    dErrorMotion.block<2,2>(0,0) = -RkT;
+    dErrorMotion.block<2,1>(0,2) = RkT * Vector2D(tk.y(), -tk.x());
+    dErrorMotion.row(2) << 0., 0., -1.;
+    _jacobianOplus[2] = dErrorMotion * dMotion;
+  }
+#endif
+
   bool EdgeSE2OdomDifferentialCalib::read(std::istream& is)
   {
     double vl, vr, dt;
@@ -62,6 +62,11 @@ namespace g2o {
         _error = delta.toVector();
       }
 
+      virtual OptimizableGraph::Vertex* createVertex(int i);
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+      virtual void linearizeOplus();
+#endif
+
       virtual bool read(std::istream& is);
       virtual bool write(std::ostream& os) const;
   };
@@ -51,6 +51,48 @@ namespace g2o {
     }
   }
 
+  OptimizableGraph::Vertex* EdgeSE2SensorCalib::createVertex(int i)
+  {
+    if (i < 0 || i > 2)
+      return 0;
+    return new VertexSE2();
+  }
+
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+  void EdgeSE2SensorCalib::linearizeOplus()
+  {
+    const VertexSE2* v1          = static_cast<const VertexSE2*>(_vertices[0]);
+    const VertexSE2* v2          = static_cast<const VertexSE2*>(_vertices[1]);
+    const VertexSE2* laserOffset = static_cast<const VertexSE2*>(_vertices[2]);
+    const SE2& x1 = v1->estimate();
+    const SE2& x2 = v2->estimate();
+    const SE2& l  = laserOffset->estimate();
+    const SE2 p1 = x1 * l;
+    const SE2 p2 = x2 * l;
+    const Matrix2D R1 = x1.rotation().toRotationMatrix();
+    const Matrix2D R2 = x2.rotation().toRotationMatrix();
+    // rotation of the inverse measurement times the inverse rotation of the first laser pose
+    const Matrix2D A = _inverseMeasurement.rotation().toRotationMatrix() * p1.rotation().toRotationMatrix().transpose();
+    const Vector2D d = p2.translation() - p1.translation();
+
+    // the derivative of R(theta)^T * v w.r.t. theta is R(theta)^T * [v_y, -v_x]
+    const Vector2D w1 = d + R1 * l.translation();
+    const Vector2D w2 = R2 * l.translation();
+
+    _jacobianOplus[0].block<2,2>(0,0) = -A;
+    _jacobianOplus[0].block<2,1>(0,2) = A * Vector2D(w1.y(), -w1.x());
+    _jacobianOplus[0].row(2) << 0., 0., -1.;
+
+    _jacobianOplus[1].block<2,2>(0,0) = A;
+    _jacobianOplus[1].block<2,1>(0,2) = A * Vector2D(-w2.y(), w2.x());
+    _jacobianOplus[1].row(2) << 0., 0., 1.;
+
+    _jacobianOplus[2].block<2,2>(0,0) = A * (R2 - R1);
+    _jacobianOplus[2].block<2,1>(0,2) = A * Vector2D(d.y(), -d.x());
+    _jacobianOplus[2].row(2).setZero();
+  }
+#endif
+
   bool EdgeSE2SensorCalib::read(std::istream& is)
   {
     Vector3D p;
@@ -29,6 +29,7 @@
 
 #include "g2o/types/slam3d/se3_ops.h"
 #include <Eigen/Geometry>
+#include <cmath>
 
 namespace g2o
 {
@@ -65,158 +66,55 @@ namespace g2o
       }
 
 
+      /**
+       * exponential of the tangent vector (omega, upsilon, sigma). The rotation
+       * is built as quaternion, the translation W * upsilon by cross products.
+       */
       Sim3(const Vector7d & update)
       {
-
-        Eigen::Vector3d omega;
-        for (int i=0; i<3; i++)
-          omega[i]=update[i];
-
-        Eigen::Vector3d upsilon;
-        for (int i=0; i<3; i++)
-          upsilon[i]=update[i+3];
-
+        Eigen::Vector3d omega = update.head<3>();
+        Eigen::Vector3d upsilon = update.segment<3>(3);
         double sigma = update[6];
         double theta = omega.norm();
-        Eigen::Matrix3d Omega = skew(omega);
         s = std::exp(sigma);
-        Eigen::Matrix3d Omega2 = Omega*Omega;
-        Eigen::Matrix3d I;
-        I.setIdentity();
-        Eigen::Matrix3d R;
+        r = quaternionExp(omega);
 
-        double eps = 0.00001;
         double A,B,C;
-        if (fabs(sigma)<eps)
-        {
-          C = 1;
-          if (theta<eps)
-          {
-            A = 1./2.;
-            B = 1./6.;
-            R = (I + Omega + Omega*Omega);
-          }
-          else
-          {
-            double theta2= theta*theta;
-            A = (1-cos(theta))/(theta2);
-            B = (theta-sin(theta))/(theta2*theta);
-            R = I + sin(theta)/theta *Omega + (1-cos(theta))/(theta*theta)*Omega2;
-          }
-        }
-        else
-        {
-          C=(s-1)/sigma;
-          if (theta<eps)
-          {
-            double sigma2= sigma*sigma;
-            A = ((sigma-1)*s+1)/sigma2;
-            B= ((0.5*sigma2-sigma+1)*s)/(sigma2*sigma);
-            R = (I + Omega + Omega2);
-          }
-          else
-          {
-            R = I + sin(theta)/theta *Omega + (1-cos(theta))/(theta*theta)*Omega2;
-            double a=s*sin(theta);
-            double b=s*cos(theta);
-            double theta2= theta*theta;
-            double sigma2= sigma*sigma;
-            double c=theta2+sigma2;
-            A = (a*sigma+ (1-b)*theta)/(theta*c);
-            B = (C-((b-1)*sigma+a*theta)/(c))*1./(theta2);
-
-          }
-        }
-        r = Eigen::Quaterniond(R);
-
-
-
-        Eigen::Matrix3d W = A*Omega + B*Omega2 + C*I;
-        t = W*upsilon;
+        coefficients(theta, sigma, s, A, B, C);
+        Eigen::Vector3d omegaU = omega.cross(upsilon);
+        t = C*upsilon + A*omegaU + B*omega.cross(omegaU);
       }
 
       Eigen::Vector3d map (const Eigen::Vector3d& xyz) const {
         return s*(r*xyz) + t;
       }
 
+      /**
+       * logarithm (omega, upsilon, sigma) of the transformation. upsilon is
+       * obtained by the closed-form inverse W^-1 = x I + y Omega + z Omega^2.
+       */
       Vector7d log() const
       {
         Vector7d res;
         double sigma = std::log(s);
-
-        Eigen::Vector3d omega;
-        Eigen::Vector3d upsilon;
-
-        Eigen::Matrix3d R = r.toRotationMatrix();
-        double d =  0.5*(R(0,0)+R(1,1)+R(2,2)-1);
-
-        Eigen::Matrix3d Omega;
-
-        double eps = 0.00001;
-        Eigen::Matrix3d I = Eigen::Matrix3d::Identity();
+        Eigen::Vector3d omega = quaternionLog(r);
+        double theta2 = omega.squaredNorm();
 
         double A,B,C;
-        if (fabs(sigma)<eps)
-        {
-          C = 1;
-          if (d>1-eps)
-          {
-            omega=0.5*deltaR(R);
-            Omega = skew(omega);
-            A = 1./2.;
-            B = 1./6.;
-          }
-          else
-          {
-            double theta = acos(d);
-            double theta2 = theta*theta;
-            omega = theta/(2*sqrt(1-d*d))*deltaR(R);
-            Omega = skew(omega);
-            A = (1-cos(theta))/(theta2);
-            B = (theta-sin(theta))/(theta2*theta);
-          }
-        }
-        else
-        {
-          C=(s-1)/sigma;
-          if (d>1-eps)
-          {
-            double sigma2 = sigma*sigma;
-            omega=0.5*deltaR(R);
-            Omega = skew(omega);
-            A = ((sigma-1)*s+1)/(sigma2);
-            B = ((0.5*sigma2-sigma+1)*s)/(sigma2*sigma);
-          }
-          else
-          {
-            double theta = acos(d);
-            omega = theta/(2*sqrt(1-d*d))*deltaR(R);
-            Omega = skew(omega);
-            double theta2 = theta*theta;
-            double a=s*sin(theta);
-            double b=s*cos(theta);
-            double c=theta2 + sigma*sigma;
-            A = (a*sigma+ (1-b)*theta)/(theta*c);
-            B = (C-((b-1)*sigma+a*theta)/(c))*1./(theta2);
-          }
-        }
-
-        Eigen::Matrix3d W = A*Omega + B*Omega*Omega + C*I;
-
-        upsilon = W.lu().solve(t);
-
-        for (int i=0; i<3; i++)
-          res[i] = omega[i];
-
-        for (int i=0; i<3; i++)
-          res[i+3] = upsilon[i];
-
+        coefficients(std::sqrt(theta2), sigma, s, A, B, C);
+        double k = C - theta2*B;
+        double det = k*k + theta2*A*A;
+        double x = 1./C;
+        double y = -A/det;
+        double z = (A*A - B*k)/(C*det);
+
+        Eigen::Vector3d omegaT = omega.cross(t);
+        res.head<3>() = omega;
+        res.segment<3>(3) = x*t + y*omegaT + z*omega.cross(omegaT);
         res[6] = sigma;
-
         return res;
       }
 
-
       Sim3 inverse() const
       {
         return Sim3(r.conjugate(), r.conjugate()*((-1./s)*t), 1./s);
@@ -249,6 +147,23 @@ namespace g2o
         return s;
       }
 
+      /**
+       * adjoint of the transformation, i.e., log(S*exp(x)*S^-1) = adj()*x
+       * for the tangent vector x = (omega, upsilon, sigma).
+       */
+      Matrix7d adj() const
+      {
+        Eigen::Matrix3d R = r.toRotationMatrix();
+        Matrix7d res;
+        res.setZero();
+        res.block<3,3>(0,0) = R;
+        res.block<3,3>(3,0) = skew(t)*R;
+        res.block<3,3>(3,3) = s*R;
+        res.block<3,1>(3,6) = -t;
+        res(6,6) = 1.;
+        return res;
+      }
+
       Sim3 operator *(const Sim3& other) const {
         Sim3 ret;
         ret.r = r*other.r;
@@ -280,6 +195,41 @@ namespace g2o
 
       inline double& scale() {return s;}
 
+    protected:
+      /**
+       * coefficients of W = A Omega + B Omega^2 + C I which maps upsilon to
+       * the translation, theta = |omega|, s = exp(sigma)
+       */
+      static void coefficients(double theta, double sigma, double s, double& A, double& B, double& C)
+      {
+        double eps = 0.00001;
+        double theta2 = theta*theta;
+        double sigma2 = sigma*sigma;
+        double sm1 = std::expm1(sigma); // s-1 without cancellation
+        C = (sigma == 0.) ? 1. : sm1/sigma;
+        if (theta<eps)
+        {
+          if (fabs(sigma)<1e-3)
+          {
+            A = 1./2. + sigma/3. + sigma2/8.;
+            B = 1./6. + sigma/8. + sigma2/20.;
+          }
+          else
+          {
+            A = ((sigma-1)*s+1)/sigma2;
+            B = ((0.5*sigma2-sigma+1)*s-1)/(sigma2*sigma);
+          }
+        }
+        else
+        {
+          double a = s*sin(theta);
+          double sinHalf = sin(theta/2);
+          double b = 2*s*sinHalf*sinHalf - sm1; // 1-s*cos(theta)
+          double c = theta2+sigma2;
+          A = (a*sigma + b*theta)/(theta*c);
+          B = (C - (a*theta - b*sigma)/c)/theta2;
+        }
+      }
   };
 
   inline std::ostream& operator <<(std::ostream& out_str,
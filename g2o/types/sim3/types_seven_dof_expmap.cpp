@@ -29,6 +29,8 @@
 #include "g2o/core/factory.h"
 #include "g2o/stuff/macros.h"
 
+#include <complex>
+
 namespace g2o {
 
   G2O_USE_TYPE_GROUP(sba);
@@ -135,6 +137,145 @@ namespace g2o {
     return os.good();
   }
 
+  /**
+   * integrals I_n = \int_0^1 t^n exp(sigma t) dt for n = 0..10, i.e., the n-th
+   * derivatives of f(sigma) = (exp(sigma) - 1) / sigma
+   */
+  static void expMoments(double sigma, double* moments)
+  {
+    if (std::abs(sigma) < 2.) { // the recursion below loses precision for small sigma
+      for (int n = 0; n <= 10; ++n) {
+        double term = 1.; // sigma^k / k!
+        double sum = 0.;
+        for (int k = 0; k < 30; ++k) {
+          sum += term / (n + k + 1);
+          term *= sigma / (k + 1);
+        }
+        moments[n] = sum;
+      }
+    } else {
+      double s = std::exp(sigma);
+      moments[0] = std::expm1(sigma) / sigma;
+      for (int n = 1; n <= 10; ++n)
+        moments[n] = (s - n * moments[n-1]) / sigma;
+    }
+  }
+
+  /**
+   * inverse of the left Jacobian of Sim3, i.e., log(exp(d)*exp(x)) = x + J^-1(x) d
+   * for small d. The left Jacobian is block triangular, its translation rows
+   * follow from differentiating t = V(omega, sigma) * upsilon with
+   * V = C I + A Omega + B Omega^2, the coefficients of Sim3::Sim3(const Vector7d&).
+   * Writing f(z) = (exp(z) - 1) / z, the eigenvalues of V are f(sigma) and
+   * f(sigma +- i theta), which yields A, B, and their derivatives in closed form,
+   * or by a series in theta for small rotations.
+   */
+  static Matrix7d invLeftJacobian(const Vector7d& x)
+  {
+    const Vector3D omega = x.head<3>();
+    const Vector3D upsilon = x.segment<3>(3);
+    const double sigma = x[6];
+    const double theta2 = omega.squaredNorm();
+    const double theta = std::sqrt(theta2);
+
+    double moments[11];
+    expMoments(sigma, moments);
+    const double C = moments[0];
+    const double dC_dsigma = moments[1];
+    double A, B, dA_dsigma, dB_dsigma, dA_dtheta_theta, dB_dtheta_theta; // d/dtheta divided by theta
+    double invJso3; // coefficient of Omega^2 in the inverse left Jacobian of SO3
+    if (theta < 1e-2) {
+      // f(sigma + i theta) = sum_n (i theta)^n I_n / n!, the series avoids the cancellation
+      // in the closed form, four terms suffice for this theta
+      A = B = dA_dsigma = dB_dsigma = dA_dtheta_theta = dB_dtheta_theta = 0.;
+      double power = 1.; // (-theta^2)^m
+      double factorial = 1.; // (2m+1)!
+      for (int m = 0; m < 4; ++m) {
+        A += power * moments[2*m+1] / factorial;
+        dA_dsigma += power * moments[2*m+2] / factorial;
+        B += power * moments[2*m+2] / (factorial * (2*m+2));
+        dB_dsigma += power * moments[2*m+3] / (factorial * (2*m+2));
+        dA_dtheta_theta -= power * (2*m+2) * moments[2*m+3] / (factorial * (2*m+2) * (2*m+3));
+        dB_dtheta_theta -= power * (2*m+2) * moments[2*m+4] / (factorial * (2*m+2) * (2*m+3) * (2*m+4));
+        power *= - theta2;
+        factorial *= (2*m+2) * (2*m+3);
+      }
+      invJso3 = 1. / 12. + theta2 * (1. / 720. + theta2 / 30240.);
+    } else {
+      typedef std::complex<double> Complex;
+      const Complex z(sigma, theta);
+      Complex f, df; // f(z) and f'(z)
+      if (std::abs(z) < 1.) {
+        f = df = 0.;
+        Complex zk = 1.; // z^k
+        double factorial = 1.; // (k+1)!
+        for (int k = 0; k < 20; ++k) {
+          f += zk / factorial;
+          df += (k + 1.) * zk / (factorial * (k + 2));
+          zk *= z;
+          factorial *= k + 2;
+        }
+      } else {
+        const double s = std::exp(sigma);
+        const double sinHalf = std::sin(0.5 * theta);
+        const Complex expm1z(std::expm1(sigma) - 2. * s * sinHalf * sinHalf, s * std::sin(theta));
+        f = expm1z / z;
+        df = (expm1z + 1. - f) / z;
+      }
+      A = f.imag() / theta;
+      B = (C - f.real()) / theta2;
+      dA_dsigma = df.imag() / theta;
+      dB_dsigma = (dC_dsigma - df.real()) / theta2;
+      dA_dtheta_theta = (theta * df.real() - f.imag()) / (theta2 * theta);
+      dB_dtheta_theta = (theta * df.imag() - 2. * (C - f.real())) / (theta2 * theta2);
+      invJso3 = (1. - 0.5 * theta * std::sin(theta) / (1. - std::cos(theta))) / theta2;
+    }
+
+    const Vector3D omegaU = omega.cross(upsilon);
+    const Vector3D omega2U = omega.cross(omegaU);
+    const Vector3D t = C * upsilon + A * omegaU + B * omega2U;
+    // derivatives of t w.r.t. omega and sigma
+    Matrix3D dt_domega = (dA_dtheta_theta * omegaU + dB_dtheta_theta * omega2U) * omega.transpose() - A * skew(upsilon);
+    dt_domega += B * (omega.dot(upsilon) * Matrix3D::Identity() + omega * upsilon.transpose() - 2. * upsilon * omega.transpose());
+    const Vector3D dt_dsigma = dC_dsigma * upsilon + dA_dsigma * omegaU + dB_dsigma * omega2U;
+
+    // V^-1 = x I + y Omega + z Omega^2, see Sim3::log()
+    const double k = C - theta2 * B;
+    const double det = k * k + theta2 * A * A;
+    const Matrix3D Omega = skew(omega);
+    const Matrix3D Omega2 = Omega * Omega;
+    const Matrix3D invV = (1. / C) * Matrix3D::Identity() - (A / det) * Omega + ((A * A - B * k) / (C * det)) * Omega2;
+    const Matrix3D invJso3Matrix = Matrix3D::Identity() - 0.5 * Omega + invJso3 * Omega2;
+
+    Matrix7d result;
+    result.setZero();
+    result.block<3,3>(0,0) = invJso3Matrix;
+    result.block<3,3>(3,0) = - invV * (dt_domega * invJso3Matrix + skew(t));
+    result.block<3,3>(3,3) = invV;
+    result.block<3,1>(3,6) = upsilon - invV * dt_dsigma;
+    result(6,6) = 1.;
+    return result;
+  }
+
+  void EdgeSim3::linearizeOplus()
+  {
+    const VertexSim3Expmap* v1 = static_cast<const VertexSim3Expmap*>(_vertices[0]);
+    const VertexSim3Expmap* v2 = static_cast<const VertexSim3Expmap*>(_vertices[1]);
+
+    // error = log(C * T1 * T2^-1), updating T1 yields exp(adj(C) d) * error,
+    // updating T2 yields error * exp(-d) = exp(-adj(error) d) * error.
+    // _error holds the log of the error from computeError().
+    Sim3 E = _measurement * v1->estimate() * v2->estimate().inverse();
+    Matrix7d invJl = invLeftJacobian(_error);
+
+    _jacobianOplusXi.noalias() = invJl * _measurement.adj();
+    _jacobianOplusXj.noalias() = - invJl * E.adj();
+    if (v1->_fix_scale)
+      _jacobianOplusXi.col(6).setZero();
+    if (v2->_fix_scale)
+      _jacobianOplusXj.col(6).setZero();
+  }
+
   /**Sim3ProjectXYZ*/
 
   EdgeSim3ProjectXYZ::EdgeSim3ProjectXYZ() :
@@ -171,47 +312,38 @@ namespace g2o {
     return os.good();
   }
 
-//  void EdgeSim3ProjectXYZ::linearizeOplus()
-//  {
-//    VertexSim3Expmap * vj = static_cast<VertexSim3Expmap *>(_vertices[1]);
-//    Sim3 T = vj->estimate();
-
-//    VertexPointXYZ* vi = static_cast<VertexPointXYZ*>(_vertices[0]);
-//    Vector3D xyz = vi->estimate();
-//    Vector3D xyz_trans = T.map(xyz);
-
-//    double x = xyz_trans[0];
-//    double y = xyz_trans[1];
-//    double z = xyz_trans[2];
-//    double z_2 = z*z;
-
-//    Matrix<double,2,3,Eigen::ColMajor> tmp;
-//    tmp(0,0) = _focal_length(0);
-//    tmp(0,1) = 0;
-//    tmp(0,2) = -x/z*_focal_length(0);
-
-//    tmp(1,0) = 0;
-//    tmp(1,1) = _focal_length(1);
-//    tmp(1,2) = -y/z*_focal_length(1);
-
-//    _jacobianOplusXi =  -1./z * tmp * T.rotation().toRotationMatrix();
-
-//    _jacobianOplusXj(0,0) =  x*y/z_2 * _focal_length(0);
-//    _jacobianOplusXj(0,1) = -(1+(x*x/z_2)) *_focal_length(0);
-//    _jacobianOplusXj(0,2) = y/z *_focal_length(0);
-//    _jacobianOplusXj(0,3) = -1./z *_focal_length(0);
-//    _jacobianOplusXj(0,4) = 0;
-//    _jacobianOplusXj(0,5) = x/z_2 *_focal_length(0);
-//    _jacobianOplusXj(0,6) = 0; // scale is ignored
-
-
-//    _jacobianOplusXj(1,0) = (1+y*y/z_2) *_focal_length(1);
-//    _jacobianOplusXj(1,1) = -x*y/z_2 *_focal_length(1);
-//    _jacobianOplusXj(1,2) = -x/z *_focal_length(1);
-//    _jacobianOplusXj(1,3) = 0;
-//    _jacobianOplusXj(1,4) = -1./z *_focal_length(1);
-//    _jacobianOplusXj(1,5) = y/z_2 *_focal_length(1);
-//    _jacobianOplusXj(1,6) = 0; // scale is ignored
-//  }
+  void EdgeSim3ProjectXYZ::linearizeOplus()
+  {
+    VertexSBAPointXYZ* vi = static_cast<VertexSBAPointXYZ*>(_vertices[0]);
+    VertexSim3Expmap* vj = static_cast<VertexSim3Expmap*>(_vertices[1]);
+    const Sim3& T = vj->estimate();
+    Vector3D xyz_trans = T.map(vi->estimate());
+
+    double x = xyz_trans[0];
+    double y = xyz_trans[1];
+    double z = xyz_trans[2];
+    double z_2 = z*z;
+
+    // derivative of the projection wrt the point in the camera frame
+    Eigen::Matrix<double,2,3,Eigen::ColMajor> tmp;
+    tmp(0,0) = vj->_focal_length(0) / z;
+    tmp(0,1) = 0;
+    tmp(0,2) = -x/z_2 * vj->_focal_length(0);
+
+    tmp(1,0) = 0;
+    tmp(1,1) = vj->_focal_length(1) / z;
+    tmp(1,2) = -y/z_2 * vj->_focal_length(1);
+
+    _jacobianOplusXi = -tmp * (T.scale() * T.rotation().toRotationMatrix());
+
+    // exp(update) * T moves the transformed point by omega x p + upsilon + sigma * p
+    Eigen::Matrix<double,3,7,Eigen::ColMajor> dp;
+    dp.block<3,3>(0,0) = -skew(xyz_trans);
+    dp.block<3,3>(0,3).setIdentity();
+    dp.col(6) = xyz_trans;
+    _jacobianOplusXj = -tmp * dp;
+    if (vj->_fix_scale)
+      _jacobianOplusXj.col(6).setZero();
+  }
 
 } // end namespace
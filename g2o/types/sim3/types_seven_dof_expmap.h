@@ -100,6 +100,8 @@ namespace g2o {
       _error = error_.log();
     }
 
+    virtual void linearizeOplus();
+
     virtual double initialEstimatePossible(const OptimizableGraph::VertexSet& , OptimizableGraph::Vertex* ) { return 1.;}
     virtual void initialEstimate(const OptimizableGraph::VertexSet& from, OptimizableGraph::Vertex* /*to*/)
     {
@@ -131,7 +133,7 @@ class EdgeSim3ProjectXYZ : public  BaseBinaryEdge<2, Vector2D,  VertexSBAPointXY
       _error = obs-v1->cam_map(project(v1->estimate().map(v2->estimate())));
     }
 
-   // virtual void linearizeOplus();
+    virtual void linearizeOplus();
 
 };
 
@@ -36,7 +36,7 @@ namespace g2o {
   EdgePointXY::EdgePointXY() :
     BaseBinaryEdge<2, Vector2D, VertexPointXY, VertexPointXY>()
   {
-    _information.setIdentity();
+    information().setIdentity();
     _error.setZero();
   }
 
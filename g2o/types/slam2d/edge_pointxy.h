@@ -37,7 +37,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API EdgePointXY : public BaseBinaryEdge<2, Vector2D, VertexPointXY, VertexPointXY>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
         EdgePointXY();
 
       void computeError()
@@ -40,7 +40,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API EdgeSE2 : public BaseBinaryEdge<3, SE2, VertexSE2, VertexSE2>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
         EdgeSE2();
 
       void computeError()
@@ -74,6 +74,8 @@ namespace g2o {
 
       virtual int measurementDimension() const {return 3;}
 
+      virtual bool binaryMeasurementData() const { return true;}
+
       virtual bool setMeasurementFromState() {
         const VertexSE2* v1 = static_cast<const VertexSE2*>(_vertices[0]);
         const VertexSE2* v2 = static_cast<const VertexSE2*>(_vertices[1]);
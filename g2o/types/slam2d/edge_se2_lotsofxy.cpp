@@ -7,20 +7,17 @@
 
 namespace g2o{
 
-  EdgeSE2LotsOfXY::EdgeSE2LotsOfXY() : BaseMultiEdge<-1,VectorXD>(){
+  EdgeSE2LotsOfXY::EdgeSE2LotsOfXY() : BaseMultiPointEdge<2, 3, 2, VectorXD>(), _observedPoints(0){
     resize(0);
   }
 
   void EdgeSE2LotsOfXY::computeError(){
     VertexSE2 * pose = static_cast<VertexSE2 *> (_vertices[0]);
+    const SE2 poseinv = pose->estimate().inverse();
 
     for(unsigned int i=0; i<_observedPoints; i++){
       VertexPointXY * xy = static_cast<VertexPointXY *> (_vertices[1+i]);
-      Vector2D m = pose->estimate().inverse() * xy->estimate();
-
-      unsigned int index = 2*i;
-      _error[index] = m[0] - _measurement[index];
-      _error[index+1] = m[1] - _measurement[index+1];
+      _error.segment<2>(2*i) = poseinv * xy->estimate() - _measurement.segment<2>(2*i);
     }
   }
 
@@ -81,40 +78,23 @@ namespace g2o{
     double ct = cos(th1) ;
     double st = sin(th1) ;
 
-    MatrixXD Ji;
-    unsigned int rows = 2*(_vertices.size()-1);
-    Ji.resize(rows, 3);
-    Ji.fill(0);
-
     Matrix2D poseRot;	// inverse of the rotation matrix associated to the pose
     poseRot <<   ct , st ,
             -st , ct ;
 
-    Matrix2D minusPoseRot = -poseRot;
-
-
-    for(unsigned int i=1; i<_vertices.size(); i++){
-      g2o::VertexPointXY * point = (g2o::VertexPointXY *) (_vertices[i]);
+    for(unsigned int i=0; i<_observedPoints; i++){
+      const VertexPointXY* point = static_cast<const VertexPointXY*>(_vertices[1+i]);
 
       const double& x2        = point->estimate()[0];
       const double& y2        = point->estimate()[1];
 
-      unsigned int index = 2*(i-1);
-
-      Ji.block<2,2>(index,0) = minusPoseRot;
-
-      Ji(index,2) = ct * (y2-y1) + st * (x1 - x2);
-      Ji(index+1,2) = st * (y1-y2) + ct * (x1 - x2);
-
-
-      MatrixXD Jj;
-      Jj.resize(rows, 2);
-      Jj.fill(0);
-      Jj.block<2,2>(index, 0) = poseRot;
+      Eigen::Matrix<double, 2, 3>& Ji = _poseJacobians[i];
+      Ji.block<2,2>(0,0) = -poseRot;
+      Ji(0,2) = ct * (y2-y1) + st * (x1 - x2);
+      Ji(1,2) = st * (y1-y2) + ct * (x1 - x2);
 
-      _jacobianOplus[i] = Jj;
+      _pointJacobians[i] = poseRot;
     }
-    _jacobianOplus[0] = Ji;
   }
 
 
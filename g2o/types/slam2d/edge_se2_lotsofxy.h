@@ -3,25 +3,30 @@
 
 #include "g2o/config.h"
 #include "g2o_types_slam2d_api.h"
-#include "g2o/core/base_multi_edge.h"
+#include "g2o/core/base_multi_point_edge.h"
 #include "vertex_se2.h"
 #include "vertex_point_xy.h"
 
 namespace g2o {
 
-  class G2O_TYPES_SLAM2D_API EdgeSE2LotsOfXY : public BaseMultiEdge<-1,VectorXD>
+  /**
+   * \brief observations of several 2D points from one pose
+   *
+   * The Jacobians are kept as fixed-size blocks per point, see BaseMultiPointEdge.
+   */
+  class G2O_TYPES_SLAM2D_API EdgeSE2LotsOfXY : public BaseMultiPointEdge<2, 3, 2, VectorXD>
   {
     protected:
       unsigned int _observedPoints;
 
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       EdgeSE2LotsOfXY();
 
       void setDimension(int dimension_)
       {
         _dimension = dimension_;
-        _information.resize(dimension_, dimension_);
+        information().resize(dimension_, dimension_);
         _error.resize(dimension_, 1);
         _measurement.resize(dimension_, 1);
       }
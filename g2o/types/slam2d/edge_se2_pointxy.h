@@ -38,7 +38,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API EdgeSE2PointXY : public BaseBinaryEdge<2, Vector2D, VertexSE2, VertexPointXY>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
       EdgeSE2PointXY();
 
       void computeError()
@@ -62,6 +62,8 @@ namespace g2o {
       
       virtual int measurementDimension() const {return 2;}
 
+      virtual bool binaryMeasurementData() const { return true;}
+
       virtual bool setMeasurementFromState(){
         const VertexSE2* v1 = static_cast<const VertexSE2*>(_vertices[0]);
         const VertexPointXY* l2 = static_cast<const VertexPointXY*>(_vertices[1]);
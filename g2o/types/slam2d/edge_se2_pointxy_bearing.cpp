@@ -48,12 +48,44 @@ namespace g2o {
     const VertexSE2* v1 = static_cast<const VertexSE2*>(_vertices[0]);
     VertexPointXY* l2 = static_cast<VertexPointXY*>(_vertices[1]);
     SE2 t=v1->estimate();
-    t.setRotation(t.rotation().angle()+_measurement);
+    t.setRotation(Eigen::Rotation2Dd(t.rotation().angle()+_measurement));
     Vector2D vr;
     vr[0]=r; vr[1]=0;
     l2->setEstimate(t*vr);
   }
 
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+  void EdgeSE2PointXYBearing::linearizeOplus()
+  {
+    const VertexSE2* vi     = static_cast<const VertexSE2*>(_vertices[0]);
+    const VertexPointXY* vj = static_cast<const VertexPointXY*>(_vertices[1]);
+    const double& x1        = vi->estimate().translation()[0];
+    const double& y1        = vi->estimate().translation()[1];
+    const double& th1       = vi->estimate().rotation().angle();
+    const double& x2        = vj->estimate()[0];
+    const double& y2        = vj->estimate()[1];
+
+    double c = cos(th1);
+    double s = sin(th1);
+    // landmark in the frame of the robot
+    double dx =  c * (x2 - x1) + s * (y2 - y1);
+    double dy = -s * (x2 - x1) + c * (y2 - y1);
+    double ir2 = 1. / (dx * dx + dy * dy);
+
+    // derivative of the bearing w.r.t. the landmark in world coordinates,
+    // the error is the negative bearing
+    double bx = -(dx * s + dy * c) * ir2;
+    double by =  (dx * c - dy * s) * ir2;
+
+    _jacobianOplusXi(0, 0) = bx;
+    _jacobianOplusXi(0, 1) = by;
+    _jacobianOplusXi(0, 2) = 1.;
+
+    _jacobianOplusXj(0, 0) = -bx;
+    _jacobianOplusXj(0, 1) = -by;
+  }
+#endif
+
   bool EdgeSE2PointXYBearing::read(std::istream& is)
   {
     is >> _measurement >> information()(0,0);
@@ -45,6 +45,38 @@ namespace g2o {
     vj->setEstimate(vi->estimate() * _measurement);
   }
 
+  OptimizableGraph::Vertex* EdgeSE2PointXYCalib::createVertex(int i)
+  {
+    switch (i) {
+      case 0: return new VertexSE2();
+      case 1: return new VertexPointXY();
+      case 2: return new VertexSE2();
+      default: return 0;
+    }
+  }
+
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+  void EdgeSE2PointXYCalib::linearizeOplus()
+  {
+    const VertexSE2* v1     = static_cast<const VertexSE2*>(_vertices[0]);
+    const VertexPointXY* l2 = static_cast<const VertexPointXY*>(_vertices[1]);
+    const VertexSE2* calib  = static_cast<const VertexSE2*>(_vertices[2]);
+    const SE2 sensor = v1->estimate() * calib->estimate();
+    const Matrix2D sensorRotT = sensor.rotation().toRotationMatrix().transpose();
+    const Vector2D fromRobot = l2->estimate() - v1->estimate().translation();
+    const Vector2D fromSensor = l2->estimate() - sensor.translation();
+
+    // the derivative of R(theta)^T * v w.r.t. theta is R(theta)^T * [v_y, -v_x]
+    _jacobianOplus[0].block<2,2>(0,0) = -sensorRotT;
+    _jacobianOplus[0].col(2) = sensorRotT * Vector2D(fromRobot.y(), -fromRobot.x());
+
+    _jacobianOplus[1] = sensorRotT;
+
+    _jacobianOplus[2].block<2,2>(0,0) = -calib->estimate().rotation().toRotationMatrix().transpose();
+    _jacobianOplus[2].col(2) = sensorRotT * Vector2D(fromSensor.y(), -fromSensor.x());
+  }
+#endif
+
   bool EdgeSE2PointXYCalib::read(std::istream& is)
   {
     is >> _measurement[0] >> _measurement[1];
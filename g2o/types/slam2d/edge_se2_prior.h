@@ -39,7 +39,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API EdgeSE2Prior : public BaseUnaryEdge<3, SE2, VertexSE2>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       EdgeSE2Prior();
 
       void computeError()
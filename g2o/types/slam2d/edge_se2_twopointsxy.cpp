@@ -27,6 +27,38 @@ namespace g2o{
     _error[3] = m2[1] - _measurement[3];
   }
 
+  OptimizableGraph::Vertex* EdgeSE2TwoPointsXY::createVertex(int i){
+    switch (i) {
+      case 0: return new VertexSE2();
+      case 1: return new VertexPointXY();
+      case 2: return new VertexPointXY();
+      default: return 0;
+    }
+  }
+
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+  void EdgeSE2TwoPointsXY::linearizeOplus(){
+    VertexSE2 * pose = static_cast<VertexSE2 *> (_vertices[0]);
+    VertexPointXY * xy1 = static_cast<VertexPointXY *> (_vertices[1]);
+    VertexPointXY * xy2 = static_cast<VertexPointXY *> (_vertices[2]);
+
+    const Matrix2D poseRotT = pose->estimate().rotation().toRotationMatrix().transpose();
+    const Vector2D d1 = xy1->estimate() - pose->estimate().translation();
+    const Vector2D d2 = xy2->estimate() - pose->estimate().translation();
+
+    _jacobianOplus[0].block<2,2>(0,0) = -poseRotT;
+    _jacobianOplus[0].block<2,1>(0,2) = poseRotT * Vector2D(d1.y(), -d1.x());
+    _jacobianOplus[0].block<2,2>(2,0) = -poseRotT;
+    _jacobianOplus[0].block<2,1>(2,2) = poseRotT * Vector2D(d2.y(), -d2.x());
+
+    _jacobianOplus[1].block<2,2>(0,0) = poseRotT;
+    _jacobianOplus[1].block<2,2>(2,0).setZero();
+
+    _jacobianOplus[2].block<2,2>(0,0).setZero();
+    _jacobianOplus[2].block<2,2>(2,0) = poseRotT;
+  }
+#endif
+
   bool EdgeSE2TwoPointsXY::read(std::istream& is){
     is >> _measurement[0] >> _measurement[1] >> _measurement[2] >> _measurement[3];
     is >> information()(0,0) >> information()(0,1) >> information()(0,2) >> information()(0,3) >> information()(1,1) >> information()(1,2) >> information()(1,3) >> information()(2,2) >> information()(2,3) >> information()(3,3);
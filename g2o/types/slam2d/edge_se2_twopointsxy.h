@@ -12,7 +12,7 @@ namespace g2o{
   class G2O_TYPES_SLAM2D_API EdgeSE2TwoPointsXY : public BaseMultiEdge<4, Vector4D>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       EdgeSE2TwoPointsXY();
 
       virtual void computeError();
@@ -24,6 +24,11 @@ namespace g2o{
 
       virtual void initialEstimate(const OptimizableGraph::VertexSet&, OptimizableGraph::Vertex*);
       virtual double initialEstimatePossible(const OptimizableGraph::VertexSet&, OptimizableGraph::Vertex*);
+
+      virtual OptimizableGraph::Vertex* createVertex(int i);
+#ifndef NUMERIC_JACOBIAN_TWO_D_TYPES
+      virtual void linearizeOplus();
+#endif
   };
 }
 #endif	// G2O_EDGE_SE2_TWOPOINTS_XY_H
@@ -46,7 +46,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API ParameterSE2Offset: public Parameter
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       ParameterSE2Offset();
 
       virtual bool read(std::istream& is);
@@ -77,22 +77,22 @@ namespace g2o {
    */
   class G2O_TYPES_SLAM2D_API CacheSE2Offset: public Cache {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       CacheSE2Offset();
       virtual void updateImpl();
 
       const ParameterSE2Offset* offsetParam() const { return _offsetParam;}
       void setOffsetParam(ParameterSE2Offset* offsetParam);
 
-      const SE2& w2n() const {return _se2_w2n;}
-      const SE2& n2w() const {return _se2_n2w;}
+      const SE2& w2n() const { ensureUpdated(); return _se2_w2n;}
+      const SE2& n2w() const { ensureUpdated(); return _se2_n2w;}
 
-      const Isometry2D& w2nMatrix() const { return _w2n;}
-      const Isometry2D& n2wMatrix() const { return _n2w;}
-      const Isometry2D& w2lMatrix() const { return _w2l;}
+      const Isometry2D& w2nMatrix() const { ensureUpdated(); return _w2n;}
+      const Isometry2D& n2wMatrix() const { ensureUpdated(); return _n2w;}
+      const Isometry2D& w2lMatrix() const { ensureUpdated(); return _w2l;}
 
-      const Matrix2D RpInverseRInverseMatrix() const { return _RpInverse_RInverse; }
-      const Matrix2D RpInverseRInversePrimeMatrix() const { return _RpInverse_RInversePrime; }
+      const Matrix2D RpInverseRInverseMatrix() const { ensureUpdated(); return _RpInverse_RInverse;}
+      const Matrix2D RpInverseRInversePrimeMatrix() const { ensureUpdated(); return _RpInverse_RInversePrime;}
 
     protected:
       ParameterSE2Offset* _offsetParam; ///< the parameter connected to the cache
@@ -39,7 +39,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API VertexPointXY : public BaseVertex<2, Vector2D>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       VertexPointXY();
 
       virtual void setToOriginImpl() {
@@ -62,6 +62,8 @@ namespace g2o {
         return 2;
       }
 
+      virtual bool binaryEstimateData() const { return true;}
+
       virtual bool setMinimalEstimateDataImpl(const double* est){
         return setEstimateData(est);
       }
@@ -41,7 +41,7 @@ namespace g2o {
   class G2O_TYPES_SLAM2D_API VertexSE2 : public BaseVertex<3, SE2>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
       VertexSE2();
 
       virtual void setToOriginImpl() {
@@ -70,6 +70,8 @@ namespace g2o {
       
       virtual int estimateDimension() const { return 3; }
 
+      virtual bool binaryEstimateData() const { return true;}
+
       virtual bool setMinimalEstimateDataImpl(const double* est){
         return setEstimateData(est);
       }
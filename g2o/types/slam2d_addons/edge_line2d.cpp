@@ -37,7 +37,7 @@
   EdgeLine2D::EdgeLine2D() :
     BaseBinaryEdge<2, Line2D, VertexLine2D, VertexLine2D>()
   {
-    _information.setIdentity();
+    information().setIdentity();
     _error.setZero();
   }
 
@@ -51,8 +51,8 @@ namespace g2o {
       is >> _measurement[i];
     for (size_t i = 0; i < 4 ; i++)
       for (size_t j = i; j < 4 ; j++) {
-        is >> _information (i,j);
-        _information (j,i) = _information (i,j);
+        is >> information() (i,j);
+        information() (j,i) = information() (i,j);
       }
     return true;
   }
@@ -63,7 +63,7 @@ namespace g2o {
       os << _measurement[i] << " ";
     for (size_t i = 0; i < 4 ; i++)
       for (size_t j = i; j < 4 ; j++) {
-        os << _information (i,j) << " ";
+        os << information() (i,j) << " ";
       }
     return os.good();
   }
@@ -33,8 +33,8 @@ namespace g2o {
       is >> _measurement[i];
     for (size_t i = 0; i < 3 ; i++)
       for (size_t j = i; j < 3 ; j++) {
-        is >> _information (i,j);
-        _information (j,i) = _information (i,j);
+        is >> information() (i,j);
+        information() (j,i) = information() (i,j);
       }
     return true;
   }
@@ -46,7 +46,7 @@ namespace g2o {
       os << _measurement[i] << " ";
     for (size_t i = 0; i < 3 ; i++)
       for (size_t j = i; j < 3 ; j++) {
-        os << _information (i,j) << " ";
+        os << information() (i,j) << " ";
       }
     return os.good();
   }
@@ -36,7 +36,7 @@ namespace g2o {
   EdgePointXYZ::EdgePointXYZ() :
     BaseBinaryEdge<3, Vector3D, VertexPointXYZ, VertexPointXYZ>()
   {
-    _information.setIdentity();
+    information().setIdentity();
     _error.setZero();
   }
 
@@ -37,7 +37,7 @@ namespace g2o {
   class G2O_TYPES_SLAM3D_API EdgePointXYZ : public BaseBinaryEdge<3, Vector3D, VertexPointXYZ, VertexPointXYZ>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      G2O_MAKE_POOLED_OPERATOR_NEW
         EdgePointXYZ();
 
       void computeError()
@@ -17,7 +17,7 @@ namespace g2o {
    */
   class G2O_TYPES_SLAM3D_API EdgeSE3 : public BaseBinaryEdge<6, Isometry3D, VertexSE3, VertexSE3> {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       EdgeSE3();
       virtual bool read(std::istream& is);
       virtual bool write(std::ostream& os) const;
@@ -45,6 +45,8 @@ namespace g2o {
 
       virtual int measurementDimension() const {return 7;}
 
+      virtual bool binaryMeasurementData() const { return true;}
+
       virtual bool setMeasurementFromState() ;
 
       virtual double initialEstimatePossible(const OptimizableGraph::VertexSet& /*from*/, 
@@ -40,7 +40,7 @@ namespace g2o {
    */
   class G2O_TYPES_SLAM3D_API EdgeSE3LinearAcceleration : public BaseUnaryEdge<3, Vector3D, VertexSE3> {
   public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    G2O_MAKE_POOLED_OPERATOR_NEW
     EdgeSE3LinearAcceleration();
     virtual bool read(std::istream& is);
     virtual bool write(std::ostream& os) const;
@@ -1,8 +1,9 @@
 #include "edge_se3_lotsofxyz.h"
+#include "se3_ops.h"
 
 namespace g2o{
 
-  EdgeSE3LotsOfXYZ::EdgeSE3LotsOfXYZ(){
+  EdgeSE3LotsOfXYZ::EdgeSE3LotsOfXYZ() : BaseMultiPointEdge<3, 6, 3, VectorXD>(), _observedPoints(0){
     resize(0);
   }
 
@@ -26,60 +27,31 @@ namespace g2o{
 
   void EdgeSE3LotsOfXYZ::computeError(){
     VertexSE3 * pose = static_cast<VertexSE3 *> (_vertices[0]);
+    const Isometry3D poseinv = pose->estimate().inverse();
 
     for(unsigned int i=0; i<_observedPoints; i++){
       VertexPointXYZ * xyz = static_cast<VertexPointXYZ *> (_vertices[1+i]);
-      Vector3D m = pose->estimate().inverse() * xyz->estimate();
-
-      unsigned int index = 3*i;
-      _error[index] = m[0] - _measurement[index];
-      _error[index+1] = m[1] - _measurement[index+1];
-      _error[index+2] = m[2] - _measurement[index+2];
+      _error.segment<3>(3*i) = poseinv * xyz->estimate() - _measurement.segment<3>(3*i);
     }
   }
 
   void EdgeSE3LotsOfXYZ::linearizeOplus(){
-    g2o::VertexSE3 * pose = (g2o::VertexSE3 *) (_vertices[0]);
-
-    // initialize Ji matrix
-    MatrixXD Ji;
-    unsigned int rows = 3*(_vertices.size()-1);
-    Ji.resize(rows, 6);
-    Ji.fill(0);
-
-    Matrix3D poseRot = pose->estimate().inverse().rotation();
-
-    for(unsigned int i=1; i<_vertices.size(); i++){
-      g2o::VertexPointXYZ * point = (g2o::VertexPointXYZ *) (_vertices[i]);
-      Vector3D Zcam = pose->estimate().inverse() * point->estimate();
-
-      unsigned int index=3*(i-1);
-
-      // Ji.block<3,3>(index,0) = -poseRot;
-      Ji.block<3,3>(index,0) = -Matrix3D::Identity();
-
-      Ji(index, 3) = -0.0;
-      Ji(index, 4) = -2*Zcam(2);
-      Ji(index, 5) = 2*Zcam(1);
+    VertexSE3 * pose = static_cast<VertexSE3 *> (_vertices[0]);
+    const Isometry3D poseinv = pose->estimate().inverse();
 
-      Ji(index+1, 3) = 2*Zcam(2);
-      Ji(index+1, 4) = -0.0;
-      Ji(index+1, 5) = -2*Zcam(0);
+    // the Jacobian w.r.t. the point is the same for all points
+    const Matrix3D poseRot = poseinv.rotation();
 
-      Ji(index+2, 3) = -2*Zcam(1);
-      Ji(index+2, 4) = 2*Zcam(0);
-      Ji(index+2, 5) = -0.0;
+    for(unsigned int i=0; i<_observedPoints; i++){
+      VertexPointXYZ * point = static_cast<VertexPointXYZ *> (_vertices[1+i]);
+      Vector3D Zcam = poseinv * point->estimate();
 
-      MatrixXD Jj;
-      Jj.resize(rows, 3);
-      Jj.fill(0);
-      Jj.block<3,3>(index,0) = poseRot;
+      Eigen::Matrix<double, 3, 6>& Ji = _poseJacobians[i];
+      Ji.block<3,3>(0,0) = -Matrix3D::Identity();
+      Ji.block<3,3>(0,3) = 2*skew(Zcam);
 
-      _jacobianOplus[i] = Jj;
+      _pointJacobians[i] = poseRot;
     }
-
-    _jacobianOplus[0] = Ji;
-
   }
 
   bool EdgeSE3LotsOfXYZ::read(std::istream& is){
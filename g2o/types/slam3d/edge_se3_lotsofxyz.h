@@ -3,24 +3,29 @@
 
 #include "g2o/config.h"
 #include "g2o_types_slam3d_api.h"
-#include "g2o/core/base_multi_edge.h"
+#include "g2o/core/base_multi_point_edge.h"
 #include "vertex_se3.h"
 #include "vertex_pointxyz.h"
 
 namespace g2o{
 
-  class G2O_TYPES_SLAM3D_API EdgeSE3LotsOfXYZ : public BaseMultiEdge<-1, VectorXD>{
+  /**
+   * \brief observations of several 3D points from one pose
+   *
+   * The Jacobians are kept as fixed-size blocks per point, see BaseMultiPointEdge.
+   */
+  class G2O_TYPES_SLAM3D_API EdgeSE3LotsOfXYZ : public BaseMultiPointEdge<3, 6, 3, VectorXD>{
 
     protected:
       unsigned int _observedPoints;
 
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       EdgeSE3LotsOfXYZ();
 
       void setDimension(int dimension_){
         _dimension = dimension_;
-        _information.resize(dimension_, dimension_);
+        information().resize(dimension_, dimension_);
         _error.resize(dimension_, 1);
         _measurement.resize(dimension_, 1);
       }
@@ -42,7 +42,7 @@ namespace g2o {
   // first two args are the measurement type, second two the connection classes
   class G2O_TYPES_SLAM3D_API EdgeSE3PointXYZ : public BaseBinaryEdge<3, Vector3D, VertexSE3, VertexPointXYZ> {
   public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    G2O_MAKE_POOLED_OPERATOR_NEW
     EdgeSE3PointXYZ();
     virtual bool read(std::istream& is);
     virtual bool write(std::ostream& os) const;
@@ -71,6 +71,8 @@ namespace g2o {
     
     virtual int measurementDimension() const {return 3;}
 
+    virtual bool binaryMeasurementData() const { return true;}
+
     virtual bool setMeasurementFromState() ;
 
     virtual double initialEstimatePossible(const OptimizableGraph::VertexSet& from, 
@@ -44,7 +44,7 @@ namespace g2o {
   // first two args are the measurement type, second two the connection classes
   class G2O_TYPES_SLAM3D_API EdgeSE3PointXYZDisparity : public BaseBinaryEdge<3, Vector3D, VertexSE3, VertexPointXYZ> {
   public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    G2O_MAKE_POOLED_OPERATOR_NEW;
     EdgeSE3PointXYZDisparity();
     virtual bool read(std::istream& is);
     virtual bool write(std::ostream& os) const;
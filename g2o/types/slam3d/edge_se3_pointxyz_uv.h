@@ -41,7 +41,7 @@ namespace g2o {
    */
   class G2O_TYPES_SLAM3D_API EdgeSE3PointXYZUV : public BaseBinaryEdge<2, Vector2D, VertexSE3, VertexPointXYZ> {
   public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    G2O_MAKE_POOLED_OPERATOR_NEW
     EdgeSE3PointXYZUV();
     virtual bool read(std::istream& is);
     virtual bool write(std::ostream& os) const;
@@ -118,10 +118,10 @@ namespace g2o {
     assert(v && "Vertex for the Prior edge is not set");
 
     Isometry3D newEstimate = _offsetParam->offset().inverse() * measurement();
-    if (_information.block<3,3>(0,0).array().abs().sum() == 0){ // do not set translation, as that part of the information is all zero
+    if (currentInformation().block<3,3>(0,0).array().abs().sum() == 0){ // do not set translation, as that part of the information is all zero
       newEstimate.translation()=v->estimate().translation();
     }
-    if (_information.block<3,3>(3,3).array().abs().sum() == 0){ // do not set rotation, as that part of the information is all zero
+    if (currentInformation().block<3,3>(3,3).array().abs().sum() == 0){ // do not set rotation, as that part of the information is all zero
       newEstimate.matrix().block<3,3>(0,0) = internal::extractRotation(v->estimate());
     }
     v->setEstimate(newEstimate);
@@ -37,7 +37,7 @@ namespace g2o {
    */
   class G2O_TYPES_SLAM3D_API ParameterCamera: public ParameterSE3Offset {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       ParameterCamera();
       void setKcam(double fx, double fy, double cx, double cy);
       void setOffset(const Isometry3D& offset_ = Isometry3D::Identity());
@@ -57,11 +57,11 @@ namespace g2o {
 
   class G2O_TYPES_SLAM3D_API CacheCamera: public CacheSE3Offset {
   public:
-    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    G2O_MAKE_POOLED_OPERATOR_NEW;
     //! parameters of the camera
     const ParameterCamera* camParams() const {return params;}
     //! return the world to image transform
-    const Affine3D& w2i() const {return _w2i;}
+    const Affine3D& w2i() const { ensureUpdated(); return _w2i;}
 
   protected:
     virtual void updateImpl();
@@ -45,7 +45,7 @@ namespace g2o {
   class G2O_TYPES_SLAM3D_API ParameterSE3Offset: public Parameter
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       ParameterSE3Offset();
 
       virtual bool read(std::istream& is);
@@ -73,16 +73,16 @@ namespace g2o {
    */
   class G2O_TYPES_SLAM3D_API CacheSE3Offset: public Cache {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       CacheSE3Offset();
       virtual void updateImpl();
 
       const ParameterSE3Offset* offsetParam() const { return _offsetParam;}
       void setOffsetParam(ParameterSE3Offset* offsetParam);
 
-      const Isometry3D& w2n() const { return _w2n;}
-      const Isometry3D& n2w() const { return _n2w;}
-      const Isometry3D& w2l() const { return _w2l;}
+      const Isometry3D& w2n() const { ensureUpdated(); return _w2n;}
+      const Isometry3D& n2w() const { ensureUpdated(); return _n2w;}
+      const Isometry3D& w2l() const { ensureUpdated(); return _w2l;}
 
     protected:
       ParameterSE3Offset* _offsetParam; ///< the parameter connected to the cache
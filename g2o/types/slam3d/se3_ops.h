@@ -36,6 +36,8 @@ namespace g2o {
 
   inline G2O_TYPES_SLAM3D_API Matrix3D skew(const Vector3D&v);
   inline G2O_TYPES_SLAM3D_API Vector3D deltaR(const Matrix3D& R);
+  inline G2O_TYPES_SLAM3D_API Eigen::Quaterniond quaternionExp(const Vector3D& omega);
+  inline G2O_TYPES_SLAM3D_API Vector3D quaternionLog(const Eigen::Quaterniond& q);
   inline G2O_TYPES_SLAM3D_API Vector2D project(const Vector3D&);
   inline G2O_TYPES_SLAM3D_API Vector3D project(const Vector4D&);
   inline G2O_TYPES_SLAM3D_API Vector3D unproject(const Vector2D&);
@@ -46,6 +46,41 @@
     return v;
   }
 
+  /**
+   * unit quaternion of the rotation vector omega, i.e., the rotation by
+   * |omega| around omega. Uses the Taylor expansion for small angles.
+   */
+  Eigen::Quaterniond quaternionExp(const Vector3D& omega)
+  {
+    double theta2 = omega.squaredNorm();
+    double w, k;
+    if (theta2 < 1e-8) {
+      w = 1. - theta2 / 8.;
+      k = 0.5 - theta2 / 48.;
+    } else {
+      double theta = sqrt(theta2);
+      w = cos(0.5 * theta);
+      k = sin(0.5 * theta) / theta;
+    }
+    return Eigen::Quaterniond(w, k * omega(0), k * omega(1), k * omega(2));
+  }
+
+  /**
+   * rotation vector of the unit quaternion q, inverse of quaternionExp().
+   * The angle is in [0, pi] as q and -q represent the same rotation.
+   */
+  Vector3D quaternionLog(const Eigen::Quaterniond& q)
+  {
+    double n = q.vec().norm();
+    double w = q.w();
+    double k;
+    if (n < 1e-4 * fabs(w))
+      k = 2. / w * (1. - n * n / (3. * w * w));
+    else
+      k = 2. * atan2(n, fabs(w)) / (w < 0. ? -n : n);
+    return k * q.vec();
+  }
+
   Vector2D project(const Vector3D& v)
   {
     Vector2D res;
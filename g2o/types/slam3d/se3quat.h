@@ -172,43 +172,25 @@ namespace g2o {
 
 
 
+      /**
+       * logarithm (omega, upsilon) of the transformation. upsilon = V^-1 * t is
+       * evaluated by cross products with V^-1 = I - 1/2 Omega + C Omega^2.
+       */
       Vector6d log() const {
         Vector6d res;
-        Matrix3D _R = _r.toRotationMatrix();
-        double d =  0.5*(_R(0,0)+_R(1,1)+_R(2,2)-1);
-        Vector3D omega;
-        Vector3D upsilon;
-
-
-        Vector3D dR = deltaR(_R);
-        Matrix3D V_inv;
-
-        if (d>0.99999)
-        {
-
-          omega=0.5*dR;
-          Matrix3D Omega = skew(omega);
-          V_inv = Matrix3D::Identity()- 0.5*Omega + (1./12.)*(Omega*Omega);
-        }
-        else
-        {
-          double theta = acos(d);
-          omega = theta/(2*sqrt(1-d*d))*dR;
-          Matrix3D Omega = skew(omega);
-          V_inv = ( Matrix3D::Identity() - 0.5*Omega
-              + ( 1-theta/(2*tan(theta/2)))/(theta*theta)*(Omega*Omega) );
-        }
-
-        upsilon = V_inv*_t;
-        for (int i=0; i<3;i++){
-          res[i]=omega[i];
-        }
-        for (int i=0; i<3;i++){
-          res[i+3]=upsilon[i];
+        Vector3D omega = quaternionLog(_r);
+        double theta2 = omega.squaredNorm();
+        double C;
+        if (theta2 < 1e-8) {
+          C = 1./12. + theta2/720.;
+        } else {
+          double theta = sqrt(theta2);
+          C = (1 - theta/(2*tan(theta/2)))/theta2;
         }
-
+        Vector3D omegaT = omega.cross(_t);
+        res.head<3>() = omega;
+        res.tail<3>() = _t - 0.5*omegaT + C*omega.cross(omegaT);
         return res;
-
       }
 
       Vector3D map(const Vector3D & xyz) const
@@ -217,40 +199,28 @@ namespace g2o {
       }
 
 
+      /**
+       * exponential of the tangent vector (omega, upsilon). The rotation is
+       * built as quaternion, the translation V * upsilon by cross products
+       * with V = I + A Omega + B Omega^2.
+       */
       static SE3Quat exp(const Vector6d & update)
       {
-        Vector3D omega;
-        for (int i=0; i<3; i++)
-          omega[i]=update[i];
-        Vector3D upsilon;
-        for (int i=0; i<3; i++)
-          upsilon[i]=update[i+3];
-
-        double theta = omega.norm();
-        Matrix3D Omega = skew(omega);
-
-        Matrix3D R;
-        Matrix3D V;
-        if (theta<0.00001)
-        {
-          //TODO: CHECK WHETHER THIS IS CORRECT!!!
-          R = (Matrix3D::Identity() + Omega + Omega*Omega);
-
-          V = R;
-        }
-        else
-        {
-          Matrix3D Omega2 = Omega*Omega;
-
-          R = (Matrix3D::Identity()
-              + sin(theta)/theta *Omega
-              + (1-cos(theta))/(theta*theta)*Omega2);
-
-          V = (Matrix3D::Identity()
-              + (1-cos(theta))/(theta*theta)*Omega
-              + (theta-sin(theta))/(pow(theta,3))*Omega2);
+        Vector3D omega = update.head<3>();
+        Vector3D upsilon = update.tail<3>();
+        double theta2 = omega.squaredNorm();
+        double A, B;
+        if (theta2 < 1e-8) {
+          A = 0.5 - theta2/24.;
+          B = 1./6. - theta2/120.;
+        } else {
+          double theta = sqrt(theta2);
+          double sinHalf = sin(theta/2);
+          A = 2*sinHalf*sinHalf/theta2;
+          B = (theta-sin(theta))/(theta2*theta);
         }
-        return SE3Quat(Eigen::Quaterniond(R),V*upsilon);
+        Vector3D omegaU = omega.cross(upsilon);
+        return SE3Quat(quaternionExp(omega), upsilon + A*omegaU + B*omega.cross(omegaU));
       }
 
       Eigen::Matrix<double, 6, 6, Eigen::ColMajor> adj() const
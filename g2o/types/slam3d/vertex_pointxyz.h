@@ -38,7 +38,7 @@ namespace g2o {
   class G2O_TYPES_SLAM3D_API VertexPointXYZ : public BaseVertex<3, Vector3D>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
       VertexPointXYZ() {}
       virtual bool read(std::istream& is);
       virtual bool write(std::ostream& os) const;
@@ -66,6 +66,8 @@ namespace g2o {
         return 3;
       }
 
+      virtual bool binaryEstimateData() const { return true;}
+
       virtual bool setMinimalEstimateDataImpl(const double* est){
         _estimate = Eigen::Map<const Vector3D>(est);
         return true;
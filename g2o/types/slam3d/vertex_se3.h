@@ -50,7 +50,7 @@ namespace g2o {
   class G2O_TYPES_SLAM3D_API VertexSE3 : public BaseVertex<6, Isometry3D>
   {
     public:
-      EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+      G2O_MAKE_POOLED_OPERATOR_NEW;
 
       static const int orthogonalizeAfter = 1000; //< orthogonalize the rotation matrix after N updates
 
@@ -79,6 +79,8 @@ namespace g2o {
         return 7;
       }
 
+      virtual bool binaryEstimateData() const { return true;}
+
       virtual bool setMinimalEstimateDataImpl(const double* est){
         Eigen::Map<const Vector6d> v(est);
         _estimate = internal::fromVectorMQT(v);
@@ -32,7 +32,7 @@ namespace g2o
   EdgeLine3D::EdgeLine3D() :
     BaseBinaryEdge<6, Vector6d, VertexLine3D, VertexLine3D>()
   {
-    _information.setIdentity();
+    information().setIdentity();
     _error.setZero();
   }
 
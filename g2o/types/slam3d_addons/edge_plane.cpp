@@ -33,7 +33,7 @@ using namespace Eigen;
 EdgePlane::EdgePlane() :
     BaseBinaryEdge<4, Vector4D, VertexPlane, VertexPlane>()
 {
-    _information.setIdentity();
+    information().setIdentity();
     _error.setZero();
 }
 
@@ -25,6 +25,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "edge_se3_calib.h"
+#include "g2o/types/slam3d/isometry3d_gradients.h"
 
 namespace g2o {
 
@@ -42,6 +43,43 @@ namespace g2o {
     _error = g2o::internal::toVectorMQT(_measurement.inverse()*calib->estimate().inverse() * v1->estimate().inverse() * v2->estimate()*calib->estimate());
   }
 
+  bool EdgeSE3Calib::setMeasurementFromState()
+  {
+    const VertexSE3* v1 = static_cast<const VertexSE3*>(_vertices[0]);
+    const VertexSE3* v2 = static_cast<const VertexSE3*>(_vertices[1]);
+    const VertexSE3* calib  = static_cast<const VertexSE3*>(_vertices[2]);
+    setMeasurement(calib->estimate().inverse() * v1->estimate().inverse() * v2->estimate() * calib->estimate());
+    return true;
+  }
+
+  OptimizableGraph::Vertex* EdgeSE3Calib::createVertex(int i)
+  {
+    if (i < 0 || i > 2)
+      return 0;
+    return new VertexSE3();
+  }
+
+#ifndef NUMERIC_JACOBIAN_THREE_D_TYPES
+  void EdgeSE3Calib::linearizeOplus()
+  {
+    const VertexSE3* v1 = static_cast<const VertexSE3*>(_vertices[0]);
+    const VertexSE3* v2 = static_cast<const VertexSE3*>(_vertices[1]);
+    const VertexSE3* calib  = static_cast<const VertexSE3*>(_vertices[2]);
+    const Isometry3D& c = calib->estimate();
+    Isometry3D E;
+    // the calibration is the offset of both poses
+    internal::computeEdgeSE3Gradient(E, _jacobianOplus[0], _jacobianOplus[1], _measurement, v1->estimate(), v2->estimate(), c, c);
+
+    // the calibration enters the error as Z^-1 * C^-1 * B * C with B = X1^-1 * X2.
+    // Its Jacobian is the sum of the Jacobians w.r.t. the two occurrences of C.
+    typedef Eigen::Matrix<double, 6, 6, Eigen::ColMajor> Matrix6;
+    Matrix6 Ji = Matrix6::Zero();
+    Matrix6 Jj = Matrix6::Zero();
+    internal::computeEdgeSE3Gradient(E, Ji, Jj, _measurement, c, v1->estimate().inverse() * v2->estimate() * c);
+    _jacobianOplus[2] = Ji + Jj;
+  }
+#endif
+
   bool EdgeSE3Calib::write(std::ostream& os) const {
     Vector7d meas=g2o::internal::toVectorQT(_measurement);
     for (int i=0; i<7; i++) os  << meas[i] << " ";
@@ -45,6 +45,11 @@ namespace g2o
       G2O_TYPES_SLAM3D_ADDONS_API EdgeSE3Calib();
 
       G2O_TYPES_SLAM3D_ADDONS_API void computeError();
+      G2O_TYPES_SLAM3D_ADDONS_API virtual bool setMeasurementFromState();
+      G2O_TYPES_SLAM3D_ADDONS_API virtual OptimizableGraph::Vertex* createVertex(int i);
+#ifndef NUMERIC_JACOBIAN_THREE_D_TYPES
+      G2O_TYPES_SLAM3D_ADDONS_API virtual void linearizeOplus();
+#endif
       G2O_TYPES_SLAM3D_ADDONS_API virtual bool read(std::istream& is);
       G2O_TYPES_SLAM3D_ADDONS_API virtual bool write(std::ostream& os) const;
   };
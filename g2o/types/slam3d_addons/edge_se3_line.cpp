@@ -28,6 +28,16 @@
 
 namespace g2o {
 
+  //! the matrix which maps the Pluecker coordinates of a line into the frame t, see operator*(Isometry3D, Line3D)
+  static inline Matrix6d lineTransform(const Isometry3D& t)
+  {
+    Matrix6d A = Matrix6d::Zero();
+    A.block<3,3>(0,0) = t.linear();
+    A.block<3,3>(0,3) = skew(t.translation()) * t.linear();
+    A.block<3,3>(3,3) = t.linear();
+    return A;
+  }
+
   EdgeSE3Line3D::EdgeSE3Line3D(){
     information().setIdentity();
     cache = 0;
@@ -73,6 +83,37 @@ namespace g2o {
     _error(6) = 0; // this is the normalization constraint
   }
 
+#ifndef NUMERIC_JACOBIAN_THREE_D_TYPES
+  void EdgeSE3Line3D::linearizeOplus() {
+    const VertexSE3* robot = static_cast<const VertexSE3*>(vertices()[0]);
+    const VertexLine3D* landmark = static_cast<const VertexLine3D*>(vertices()[1]);
+    const Line3D& line = landmark->estimate();
+    const Line3D inRobot(robot->estimate().inverse() * line);
+    const Line3D projected(cache->w2n() * line);
+
+    // derivative of the normalization of the projected line
+    const Vector3D d = projected.d();
+    const double in = 1. / d.norm();
+    Matrix6d dNormalize = Matrix6d::Identity() * in;
+    dNormalize.block<6,3>(0,3) -= (in * in * in) * (Vector6d)projected * d.transpose();
+
+    // derivative of the line in the robot frame w.r.t. the increment (t, q) of the robot
+    Matrix6d dRobot = Matrix6d::Zero();
+    dRobot.block<3,3>(0,0) = skew(inRobot.d());
+    dRobot.block<3,3>(0,3) = 2. * skew(inRobot.w());
+    dRobot.block<3,3>(3,3) = 2. * skew(inRobot.d());
+
+    _jacobianOplusXi.block<6,6>(0,0) = -dNormalize * lineTransform(offsetParam->inverseOffset()) * dRobot;
+    _jacobianOplusXi.row(6).setZero();
+
+    // the increment of the landmark is followed by a normalization, the
+    // normalization of the projected line cancels the one of the landmark
+    // except for the scale
+    _jacobianOplusXj.block<6,6>(0,0) = (-1. / line.d().norm()) * dNormalize * lineTransform(cache->w2n());
+    _jacobianOplusXj.row(6).setZero();
+  }
+#endif
+
   bool EdgeSE3Line3D::resolveCaches(){
     ParameterVector pv(1);
     pv[0]=offsetParam;
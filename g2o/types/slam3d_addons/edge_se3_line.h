@@ -74,6 +74,10 @@ namespace g2o {
 
       virtual int measurementDimension() const {return 7;}
 
+#ifndef NUMERIC_JACOBIAN_THREE_D_TYPES
+      virtual void linearizeOplus();
+#endif
+
   private:
 
     ParameterSE3Offset* offsetParam;
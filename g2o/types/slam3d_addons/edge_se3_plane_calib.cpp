@@ -41,6 +41,75 @@ namespace g2o
     color << 0.1, 0.1, 0.1;
   }
 
+  OptimizableGraph::Vertex* EdgeSE3PlaneSensorCalib::createVertex(int i)
+  {
+    switch (i) {
+      case 0: return new VertexSE3();
+      case 1: return new VertexPlane();
+      case 2: return new VertexSE3();
+      default: return 0;
+    }
+  }
+
+#ifndef NUMERIC_JACOBIAN_THREE_D_TYPES
+  //! derivative of the azimuth and the elevation of the direction n, see Plane3D
+  static inline Matrix<double, 2, 3> azimuthElevationJacobian(const Vector3D& n)
+  {
+    double rho2 = n.x() * n.x() + n.y() * n.y();
+    double rho = sqrt(rho2);
+    double n2 = rho2 + n.z() * n.z();
+    Matrix<double, 2, 3> J;
+    J <<
+      -n.y() / rho2,                n.x() / rho2,                 0.,
+      -n.z() * n.x() / (rho * n2),  -n.z() * n.y() / (rho * n2),  rho / n2;
+    return J;
+  }
+
+  void EdgeSE3PlaneSensorCalib::linearizeOplus()
+  {
+    const VertexSE3* v1            = static_cast<const VertexSE3*>(_vertices[0]);
+    const VertexPlane* planeVertex = static_cast<const VertexPlane*>(_vertices[1]);
+    const VertexSE3* offset        = static_cast<const VertexSE3*>(_vertices[2]);
+    const Plane3D& plane           = planeVertex->estimate();
+    const Isometry3D n2w = v1->estimate() * offset->estimate();
+    const Plane3D localPlane = n2w.inverse() * plane;
+    const Vector3D nw = plane.normal();
+    const Vector3D nl = localPlane.normal();
+
+    // derivative of the error w.r.t. the normal of the local plane. The
+    // error is the azimuth and the elevation of the measured normal rotated
+    // by R^T, where R = rotation(nl) is composed of the azimuth and the
+    // elevation of nl.
+    const Matrix3D RT = Plane3D::rotation(nl).transpose();
+    const Vector3D n = RT * _measurement.normal();
+    Matrix<double, 3, 2> dRotated;
+    dRotated.col(0) = -RT.col(2).cross(n);
+    dRotated.col(1) = Vector3D::UnitY().cross(n);
+    const Matrix<double, 2, 3> dNormal = azimuthElevationJacobian(n) * dRotated * azimuthElevationJacobian(nl);
+
+    // derivatives of the local normal and distance w.r.t. the increment (t, q)
+    // of the robot, of the offset, and w.r.t. the increment of the plane.
+    // The distance of the local plane is plane.distance() - n2w.translation().dot(nw).
+    const Matrix3D offsetRT = offset->estimate().linear().transpose();
+    const Vector3D a = v1->estimate().linear().transpose() * nw;
+
+    _jacobianOplus[0].setZero();
+    _jacobianOplus[0].block<2,3>(0,3) = dNormal * 2. * offsetRT * skew(a);
+    _jacobianOplus[0].block<1,3>(2,0) = -a.transpose();
+    _jacobianOplus[0].block<1,3>(2,3) = 2. * a.transpose() * skew(offset->estimate().translation());
+
+    const Matrix3D planeR = Plane3D::rotation(nw);
+    _jacobianOplus[1].block<2,2>(0,0) = dNormal * n2w.linear().transpose() * planeR.block<3,2>(0,1);
+    _jacobianOplus[1].block<2,1>(0,2).setZero();
+    _jacobianOplus[1].block<1,2>(2,0) = -n2w.translation().transpose() * planeR.block<3,2>(0,1);
+    _jacobianOplus[1](2,2) = 1.;
+
+    _jacobianOplus[2].setZero();
+    _jacobianOplus[2].block<2,3>(0,3) = dNormal * 2. * skew(nl);
+    _jacobianOplus[2].block<1,3>(2,0) = -nl.transpose();
+  }
+#endif
+
   bool EdgeSE3PlaneSensorCalib::read(std::istream& is)
   {
     Vector4D v;